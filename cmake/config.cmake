@@ -34,6 +34,16 @@ endif()
 add_compile_definitions(IMTERM_ENABLE_REGEX)
 add_compile_definitions(IMTERM_USE_FMT)
 add_compile_definitions(FMT_HEADER_ONLY)
+option(NINJACLOWN_PROFILER "Compile scoped profiling timers in (recording is toggled at runtime)" ON)
+if (NINJACLOWN_PROFILER)
+    add_compile_definitions(NINJACLOWN_PROFILER)
+endif()
+# model/math.hpp relies on floating point operations not being fused, for results to be reproducible across toolchains
+if (CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang" AND NOT CMAKE_CXX_COMPILER_FRONTEND_VARIANT STREQUAL "MSVC")
+    add_compile_options(-ffp-contract=off)
+elseif (MSVC)
+    add_compile_options(/fp:precise)
+endif()
 set(COMPILE_SFML_WITH_PROJECT OFF) # Use system SFML if present
 set(SFML_MINIMUM_SYSTEM_VERSION 2.5)
 
@@ -98,6 +108,12 @@ set(COMMANDS_FIRE_ACTIONABLE 12)
 add_compile_definitions(COMMANDS_FIRE_ACTIONABLE=12)
 set(COMMANDS_FIRE_ACTIVATOR 13)
 add_compile_definitions(COMMANDS_FIRE_ACTIVATOR=13)
+set(COMMANDS_PROFILE 14)
+add_compile_definitions(COMMANDS_PROFILE=14)
+set(COMMANDS_SAVE_STATE 15)
+add_compile_definitions(COMMANDS_SAVE_STATE=15)
+set(COMMANDS_LOAD_STATE 16)
+add_compile_definitions(COMMANDS_LOAD_STATE=16)
 
 # variable names
 set(VARIABLES_AVERAGE_FPSID 0)
@@ -106,3 +122,5 @@ set(VARIABLES_TARGET_FPSID 1)
 add_compile_definitions(VARIABLES_TARGET_FPSID=1)
 set(VARIABLES_DISPLAY_DEBUG_DATAID 2)
 add_compile_definitions(VARIABLES_DISPLAY_DEBUG_DATAID=2)
+set(VARIABLES_DISPLAY_PERF_OVERLAYID 3)
+add_compile_definitions(VARIABLES_DISPLAY_PERF_OVERLAYID=3)
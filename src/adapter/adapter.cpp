@@ -3,6 +3,9 @@
 #include <spdlog/spdlog.h>
 
 #include "adapter/adapter.hpp"
+#include "adapter/compiled_map.hpp"
+#include "adapter/map_data.hpp"
+#include "adapter/save_state.hpp"
 #include "bot/bot_api.hpp"
 #include "model/cell.hpp"
 #include "model/components.hpp"
@@ -10,9 +13,14 @@
 #include "model/model.hpp"
 #include "ninja_clown/api.h"
 #include "state_holder.hpp"
+#include "utils/archive.hpp"
+#include "utils/hash.hpp"
 #include "utils/logging.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/profiler.hpp"
 #include "utils/resource_manager.hpp"
 #include "utils/scope_guards.hpp"
+#include "utils/system.hpp"
 #include "view/game/game_viewer.hpp"
 #include "view/view.hpp"
 
@@ -21,7 +29,8 @@ using fmt::literals::operator""_a;
 namespace {
 template <typename... Args>
 [[nodiscard]] std::string tooltip_text_prefix(std::string_view key, char const *prefix, Args &&... args) {
-	std::string_view fmt = utils::resource_manager::instance().tooltip_for(key);
+	const auto resources = utils::resource_manager::instance();
+	std::string_view fmt = resources->tooltip_for(key);
 	return prefix + fmt::format(fmt, std::forward<Args>(args)...);
 }
 
@@ -31,6 +40,11 @@ template <typename... Args>
 }
 } // namespace
 
+adapter::adapter::adapter(state::holder *state_holder) noexcept
+    : m_state{*state_holder}
+    , m_entity_versions(model::cst::max_entities)
+    , m_bot_logger{utils::log::logger_for(utils::log::bot_source)} { }
+
 bool adapter::adapter::load_map(const std::filesystem::path &path) noexcept {
 	if (map_is_loaded()) {
 		state::access<adapter>::model(m_state).bot_end_level();
@@ -41,87 +55,246 @@ bool adapter::adapter::load_map(const std::filesystem::path &path) noexcept {
 		m_target_handle.reset();
 
 		m_target_handle.reset();
-		m_model2view.clear();
-		m_view2model.clear();
-		m_view2name.clear();
+		m_activator2view.clear();
+		m_actionable2view.clear();
+		m_entity2view.clear();
+		m_mob2model.clear();
+		m_object2model.clear();
+		m_names.clear();
+		m_name_ids.clear();
+		m_actionable2name.clear();
+		m_mob_tooltips.clear();
+		m_object_tooltips.clear();
 		m_cells_changed_since_last_update.clear();
+		m_entities_changed_since_last_update.clear();
 	};
 
 	clear();
 	std::string string_path = path.generic_string();
 
-	std::shared_ptr<cpptoml::table> map_file;
-	try {
-		map_file = cpptoml::parse_file(string_path);
-	}
-	catch (const cpptoml::parse_exception &parse_exception) {
-		utils::log::error("adapter.map_load_failure", "path"_a = string_path, "reason"_a = parse_exception.what());
+	std::optional<map_data::level> level = read_map(path);
+	if (!level) {
 		return false;
 	}
 
-	auto version = map_file->get_qualified_as<std::string>("file.version");
-	if (!version) {
-		utils::log::error("adapter.map_load_failure", "path"_a = string_path,
-		                  "reason"_a = "unknown file format (missing [file].version)");
-		return false;
-	}
-
-	bool success{false};
-	if (*version == "1.0.0") {
-		success = load_map_v1_0_0(map_file, string_path);
-	}
-
+	const bool success = load_level(*level, string_path);
 	if (!success) {
-		utils::log::error("adapter.unsupported_version", "path"_a = string_path, "version"_a = *version);
 		clear();
 		state::access<adapter>::set_current_map_path(m_state, "");
 	}
 	else {
+		const model::grid &map = state::access<adapter>::model(m_state).world.map;
+		m_cells_changed_since_last_update.reserve(map.width() * map.height());
 		state::access<adapter>::set_current_map_path(m_state, path);
 		state::access<adapter>::model(m_state).bot_start_level(bot::ffi{});
 	}
 	return success;
 }
 
+std::optional<adapter::map_data::level> adapter::adapter::read_map(const std::filesystem::path &path) noexcept {
+	NINJACLOWN_PROFILE_SCOPE("adapter::read_map");
+	std::string string_path = path.generic_string();
+
+	// maps stored in campaign archives are read in place, and were hashed when packing them
+	std::string_view content;
+	std::uint64_t hash{};
+	utils::mapped_file source;
+	auto archived = utils::archive::lookup(path);
+	if (archived) {
+		content = archived->second->data;
+		hash    = archived->second->hash;
+	}
+	else {
+		if (!source.open(path)) {
+			utils::log::error("adapter.map_load_failure", "path"_a = string_path, "reason"_a = utils::sys_last_error());
+			return {};
+		}
+		content = source.view();
+		hash    = utils::fnv1a_64(content);
+	}
+	m_map_hash = hash;
+
+	if (path.extension() == map_data::compiled_extension) {
+		std::optional<map_data::level> level = map_data::read_compiled(content);
+		if (!level) {
+			utils::log::error("adapter.map_load_failure", "path"_a = string_path, "reason"_a = "corrupted or outdated compiled map");
+		}
+		return level;
+	}
+
+	const std::filesystem::path cache = map_data::cache_path(hash);
+	if (std::optional<map_data::level> cached = map_data::read_compiled(cache); cached) {
+		utils::log::debug("adapter.compiled_map_cache_hit", "path"_a = string_path, "cache"_a = cache.generic_string());
+		return cached;
+	}
+
+	std::optional<map_data::level> level = map_data::parse(content, string_path);
+	if (level && !map_data::write_compiled(*level, hash, cache)) {
+		utils::log::warn("adapter.compiled_map_cache_failure", "path"_a = string_path, "cache"_a = cache.generic_string());
+	}
+	return level;
+}
+
 bool adapter::adapter::map_is_loaded() noexcept {
 	view::view &view = state::access<adapter>::view(m_state);
 	return view.has_map();
 }
 
+bool adapter::adapter::save_state(const std::filesystem::path &file) noexcept {
+	NINJACLOWN_PROFILE_SCOPE("adapter::save_state");
+	const std::string string_path = file.generic_string();
+	if (!map_is_loaded()) {
+		utils::log::error("adapter.save_state_failure", "path"_a = string_path, "reason"_a = "no map loaded");
+		return false;
+	}
+
+	const model::world &world = state::access<adapter>::model(m_state).world;
+	const ::adapter::save_state::map_info map{m_state.current_map_path(), m_map_hash};
+	if (!::adapter::save_state::write(file, map, world, m_cells_changed_since_last_update.items(),
+	                                  m_entities_changed_since_last_update.items())) {
+		utils::log::error("adapter.save_state_failure", "path"_a = string_path, "reason"_a = utils::sys_last_error());
+		return false;
+	}
+
+	utils::log::info("adapter.save_state_saved", "path"_a = string_path, "tick"_a = world.current_tick());
+	return true;
+}
+
+bool adapter::adapter::load_state(const std::filesystem::path &file) noexcept {
+	NINJACLOWN_PROFILE_SCOPE("adapter::load_state");
+	const std::string string_path = file.generic_string();
+
+	utils::mapped_file content;
+	if (!content.open(file)) {
+		utils::log::error("adapter.save_state_load_failure", "path"_a = string_path, "reason"_a = utils::sys_last_error());
+		return false;
+	}
+
+	std::optional<::adapter::save_state::map_info> map = ::adapter::save_state::map_of(content.view());
+	if (!map) {
+		utils::log::error("adapter.save_state_load_failure", "path"_a = string_path, "reason"_a = "not a save state, or saved by another version");
+		return false;
+	}
+
+	// the view starts over from the initial state of the map, and is then moved to the saved state
+	if (!load_map(map->path)) {
+		return false;
+	}
+
+	model::world &world = state::access<adapter>::model(m_state).world;
+	if (m_map_hash != map->hash || world.map.width() != map->width || world.map.height() != map->height) {
+		utils::log::error("adapter.save_state_load_failure", "path"_a = string_path, "reason"_a = "the map changed since the state was saved");
+		return false;
+	}
+
+	std::optional<::adapter::save_state::changes> changes = ::adapter::save_state::read(content.view(), world);
+	if (!changes) {
+		utils::log::error("adapter.save_state_load_failure", "path"_a = string_path, "reason"_a = "corrupted save state");
+		load_map(map->path);
+		return false;
+	}
+
+	for (model::handle_t handle = 0; handle < model::cst::max_entities; ++handle) {
+		const model_handle entity{handle, model_handle::ENTITY};
+		if (view_of(entity) == nullptr) {
+			continue;
+		}
+		if (const auto &hitbox = world.components.hitbox[handle]; hitbox) {
+			move_entity(entity, hitbox->center.x, hitbox->center.y);
+			rotate_entity(entity, hitbox->rad);
+		}
+		else {
+			hide_entity(entity);
+		}
+	}
+
+	view::game_viewer &game = state::access<adapter>::view(m_state).game();
+	for (std::size_t handle = 0; handle < world.actionables.size(); ++handle) {
+		const model::actionable &actionable = world.actionables[handle];
+		const view_handle *view             = view_of(model_handle{handle, model_handle::ACTIONABLE});
+		if (view == nullptr || actionable.behaviour != model::actionable::behaviours_ns::gate) {
+			continue;
+		}
+		if (world.map[actionable.data.pos.x][actionable.data.pos.y].type == model::cell_type::GROUND) {
+			game.hide(*view);
+		}
+		else {
+			game.reveal(*view);
+		}
+		game.invalidate_tile(actionable.data.pos.x, actionable.data.pos.y);
+	}
+	update_projectiles(world.projectiles.xs(), world.projectiles.ys());
+
+	// moving the view marked every entity as changed
+	m_cells_changed_since_last_update.clear();
+	m_entities_changed_since_last_update.clear();
+	for (const model::grid_point &cell : changes->cells) {
+		m_cells_changed_since_last_update.insert(cell.x + cell.y * world.map.width(), cell);
+	}
+	for (std::size_t entity : changes->entities) {
+		m_entities_changed_since_last_update.insert(entity, entity);
+	}
+
+	utils::log::info("adapter.save_state_loaded", "path"_a = string_path, "tick"_a = world.current_tick());
+	return true;
+}
+
 void adapter::adapter::fire_activator(model_handle handle) noexcept {
 	// Empty for now
 }
 
 void adapter::adapter::close_gate(model_handle gate) noexcept {
-	auto it = m_model2view.find(gate);
-	if (it == m_model2view.end()) {
+	const view_handle *view = view_of(gate);
+	if (view == nullptr) {
 		utils::log::error("adapter.unknown_model_handle", "model_handle"_a = gate.handle,
 		                  "operation"_a = "close gate");
 	}
 	else {
-		state::access<adapter>::view(m_state).game().reveal(it->second);
+		state::access<adapter>::view(m_state).game().reveal(*view);
 	}
 }
 
 void adapter::adapter::open_gate(model_handle gate) noexcept {
-	auto it = m_model2view.find(gate);
-	if (it == m_model2view.end()) {
+	const view_handle *view = view_of(gate);
+	if (view == nullptr) {
 		utils::log::error("adapter.unknown_model_handle", "model_handle"_a = gate.handle, "operation"_a = "open gate");
 	}
 	else {
-		state::access<adapter>::view(m_state).game().hide(it->second);
+		state::access<adapter>::view(m_state).game().hide(*view);
 	}
 }
 
-void adapter::adapter::update_map(const model::grid_point &target, model::cell_type  /*new_cell*/) noexcept {
-	m_cells_changed_since_last_update.emplace_back(target);
+void adapter::adapter::update_map(const model::grid_point &target, model::cell_type new_cell) noexcept {
+	const std::size_t width = state::access<adapter>::model(m_state).world.map.width();
+	m_cells_changed_since_last_update.insert(target.x + target.y * width, target);
+
+	view::game_viewer &game                 = state::access<adapter>::view(m_state).game();
+	std::optional<view::map::cell> view_cell = game.tile_at(target.x, target.y);
+	if (!view_cell) {
+		utils::log::error("adapter.cell_out_of_view", "x"_a = target.x, "y"_a = target.y);
+		return;
+	}
+
+	switch (new_cell) {
+		case model::cell_type::CHASM:
+			view_cell = view::map::cell::abyss;
+			break;
+		case model::cell_type::GROUND:
+		case model::cell_type::WALL:
+			// the model does not tell floor kinds apart, and walls (gates) are drawn over the floor: floors keep their tile
+			if (*view_cell == view::map::cell::abyss) {
+				view_cell = view::map::cell::concrete_tile;
+			}
+			break;
+	}
+	game.set_tile(target.x, target.y, *view_cell);
 }
 
 void adapter::adapter::move_entity(model_handle entity, float new_x, float new_y) noexcept {
 	view::view &view = state::access<adapter>::view(m_state);
 
-	if (auto it = m_model2view.find(entity); it != m_model2view.end()) {
-		view.game().move_entity(it->second, new_x, new_y);
+	if (const view_handle *view_handle = view_of(entity); view_handle != nullptr) {
+		view.game().move_entity(*view_handle, new_x, new_y);
 		mark_entity_as_dirty(entity.handle);
 	}
 	else {
@@ -131,23 +304,24 @@ void adapter::adapter::move_entity(model_handle entity, float new_x, float new_y
 }
 
 void adapter::adapter::hide_entity(model_handle entity) noexcept {
-	auto it = m_model2view.find(entity);
-	if (it == m_model2view.end()) {
+	const view_handle *view = view_of(entity);
+	if (view == nullptr) {
 		utils::log::error("adapter.unknown_model_handle", "model_handle"_a = entity.handle,
 		                  "operation"_a = "hide entity");
 	}
 	else {
 		mark_entity_as_dirty(entity.handle);
-		state::access<adapter>::view(m_state).game().hide(it->second);
+		state::access<adapter>::view(m_state).game().hide(*view);
 	}
 }
 
 void adapter::adapter::rotate_entity(model_handle entity, float new_rad) noexcept {
 	view::view &view = state::access<adapter>::view(m_state);
 
-	if (auto it = m_model2view.find(entity); it != m_model2view.end()) {
-		utils::log::trace("adapter.trace.rotate_entity", "view_handle"_a = it->first.handle, "angle"_a = new_rad);
-		view.game().rotate_entity(it->second, view::facing_direction::from_angle(new_rad));
+	if (const view_handle *view_handle = view_of(entity); view_handle != nullptr) {
+		static const utils::log::key_id rotate_entity_key = utils::log::intern("adapter.trace.rotate_entity");
+		utils::log::trace(rotate_entity_key, "view_handle"_a = view_handle->handle, "angle"_a = new_rad);
+		view.game().rotate_entity(*view_handle, view::facing_direction::from_angle(new_rad));
 		mark_entity_as_dirty(entity.handle);
 	}
 	else {
@@ -156,8 +330,13 @@ void adapter::adapter::rotate_entity(model_handle entity, float new_rad) noexcep
 	}
 }
 
+void adapter::adapter::update_projectiles(const std::vector<float> &xs, const std::vector<float> &ys) noexcept {
+	state::access<adapter>::view(m_state).game().set_projectiles(xs, ys);
+}
+
 void adapter::adapter::mark_entity_as_dirty(model::handle_t model_handle) noexcept {
-	m_entities_changed_since_last_update.emplace_back(model_handle);
+	m_entities_changed_since_last_update.insert(model_handle, model_handle);
+	m_entity_versions[model_handle].fetch_add(1, std::memory_order_release);
 }
 
 void adapter::adapter::clear_entities_changed_since_last_update() noexcept {
@@ -165,38 +344,41 @@ void adapter::adapter::clear_entities_changed_since_last_update() noexcept {
 }
 
 const std::vector<std::size_t> &adapter::adapter::entities_changed_since_last_update() noexcept {
-	return m_entities_changed_since_last_update;
+	return m_entities_changed_since_last_update.items();
 }
 
 void adapter::adapter::bot_log(bot_log_level level, const char *text) {
-	switch (level) {
-		case bot_log_level::BTRACE:
-			spdlog::trace("[BOT] {}", text);
-			break;
-		case bot_log_level::BDEBUG:
-			spdlog::debug("[BOT] {}", text);
-			break;
-		case bot_log_level::BINFO:
-			spdlog::info("[BOT] {}", text);
-			break;
-		case bot_log_level::BWARN:
-			spdlog::warn("[BOT] {}", text);
-			break;
-		case bot_log_level::BERROR:
-			spdlog::error("[BOT] {}", text);
-			break;
-		case bot_log_level::BCRITICAL:
-			spdlog::critical("[BOT] {}", text);
-			break;
-		default:
-			spdlog::warn("DLL used unknown log level ({})", level);
-			spdlog::info("[BOT] {}", text);
-			break;
+	// bot log levels match spdlog’s, see ffi::log
+	const auto spdlog_level = static_cast<spdlog::level::level_enum>(level);
+	if (level < bot_log_level::BTRACE || level > bot_log_level::BCRITICAL) {
+		m_bot_logger->warn("DLL used unknown log level ({})", static_cast<int>(level));
+		m_bot_logger->info("[BOT] {}", text);
+		return;
+	}
+
+	// rate limited by the logging sinks, see utils::log::make_default_logger_async
+	if (m_bot_logger->should_log(spdlog_level)) {
+		m_bot_logger->log(spdlog_level, "[BOT] {}", text);
 	}
 }
 
 
-adapter::draw_request adapter::adapter::tooltip_for(view_handle entity) noexcept {
+const adapter::draw_request &adapter::adapter::tooltip_for(view_handle entity) noexcept {
+	std::uint32_t entity_version{0};
+	if (const model_handle *model = model_of(entity); model != nullptr && model->type == model_handle::ENTITY) {
+		entity_version = m_entity_versions[model->handle].load(std::memory_order_acquire);
+	}
+	const unsigned int texts_version = utils::resource_manager::instance()->tooltip_texts_version();
+
+	utils::dense_map<cached_tooltip> &cache = entity.is_mob ? m_mob_tooltips : m_object_tooltips;
+	if (const cached_tooltip *cached = cache.find(entity.handle);
+	    cached == nullptr || cached->entity_version != entity_version || cached->texts_version != texts_version) {
+		cache.insert_or_assign(entity.handle, cached_tooltip{make_tooltip(entity), entity_version, texts_version});
+	}
+	return cache.find(entity.handle)->request;
+}
+
+adapter::draw_request adapter::adapter::make_tooltip(view_handle entity) noexcept {
 	const model::world &world = state::access<adapter>::model(m_state).world;
 
 	draw_request list;
@@ -210,25 +392,25 @@ adapter::draw_request adapter::adapter::tooltip_for(view_handle entity) noexcept
 	}
 
 	// Retrieving model's handle
-	auto it = m_view2model.find(entity);
-	if (it == m_view2model.end()) {
+	const model_handle *model = model_of(entity);
+	if (model == nullptr) {
 		utils::log::warn("adapter.unknown_view_entity", "view_handle"_a = entity.handle);
 		return list;
 	}
 
 	if (entity.is_mob) {
-		return tooltip_for_mob(it->second, world.components);
+		return tooltip_for_mob(*model, world.components);
 	}
 
-	switch (it->second.type) {
+	switch (model->type) {
 		case model_handle::ACTIVATOR: {
-			return tooltip_for_activator(it->second);
+			return tooltip_for_activator(*model);
 		}
 		case model_handle::ACTIONABLE: {
-			return tooltip_for_actionable(it->second, entity);
+			return tooltip_for_actionable(*model, entity);
 		}
 		case model_handle::ENTITY:
-			utils::log::warn("adapter.non_coherent_entity", "handle"_a = it->second.handle);
+			utils::log::warn("adapter.non_coherent_entity", "handle"_a = model->handle);
 			break;
 	}
 
@@ -239,10 +421,9 @@ adapter::draw_request adapter::adapter::tooltip_for_actionable(model_handle acti
 	assert(actionable.type == model_handle::ACTIONABLE);
 
 	request::info info_req;
-	auto target_name = m_view2name.find(view_actionable);
-	if (target_name != m_view2name.end()) {
+	if (const std::string *target_name = name_of(actionable); target_name != nullptr) {
 		info_req.lines.emplace_back(tooltip_text("adapter.named_gate", "handle"_a = actionable.handle,
-		                                         "name"_a = target_name->second));
+		                                         "name"_a = *target_name));
 	}
 	else {
 		info_req.lines.emplace_back(
@@ -266,18 +447,10 @@ adapter::draw_request adapter::adapter::tooltip_for_activator(model_handle activ
 
 	auto targets = world.activators[activator.handle].targets;
 	for (size_t target : targets) {
-		std::string target_name;
-		auto target_view_handle = m_model2view.find(model_handle{target, model_handle::ACTIONABLE});
-		if (target_view_handle != m_model2view.end()) {
-			auto target_name_it = m_view2name.find(target_view_handle->second);
-			if (target_name_it != m_view2name.end()) {
-				target_name = target_name_it->second;
-			}
-		}
-
-		if (!target_name.empty()) {
+		const std::string *target_name = name_of(model_handle{target, model_handle::ACTIONABLE});
+		if (target_name != nullptr && !target_name->empty()) {
 			info_req.lines.emplace_back(tooltip_text_prefix("adapter.named_target", "\t",
-			                                                "handle"_a = target, "name"_a = target_name));
+			                                                "handle"_a = target, "name"_a = *target_name));
 		}
 		else {
 			info_req.lines.emplace_back(
@@ -330,12 +503,56 @@ void adapter::adapter::clear_cells_changed_since_last_update() noexcept {
 }
 
 const std::vector<model::grid_point> &adapter::adapter::cells_changed_since_last_update() noexcept {
-	return m_cells_changed_since_last_update;
+	return m_cells_changed_since_last_update.items();
+}
+
+void adapter::adapter::link(model_handle model, view_handle view) {
+	switch (model.type) {
+		case model_handle::ACTIVATOR:
+			m_activator2view.insert_or_assign(model.handle, view);
+			break;
+		case model_handle::ACTIONABLE:
+			m_actionable2view.insert_or_assign(model.handle, view);
+			break;
+		case model_handle::ENTITY:
+			m_entity2view.insert_or_assign(model.handle, view);
+			break;
+	}
+
+	if (view.is_mob) {
+		m_mob2model.insert_or_assign(view.handle, model);
+	}
+	else {
+		m_object2model.insert_or_assign(view.handle, model);
+	}
+}
+
+const adapter::view_handle *adapter::adapter::view_of(model_handle model) const noexcept {
+	switch (model.type) {
+		case model_handle::ACTIVATOR:
+			return m_activator2view.find(model.handle);
+		case model_handle::ACTIONABLE:
+			return m_actionable2view.find(model.handle);
+		case model_handle::ENTITY:
+			return m_entity2view.find(model.handle);
+	}
+	return nullptr;
+}
+
+const adapter::model_handle *adapter::adapter::model_of(view_handle view) const noexcept {
+	return view.is_mob ? m_mob2model.find(view.handle) : m_object2model.find(view.handle);
 }
 
-std::size_t adapter::view_hhash::operator()(const view_handle &h) const noexcept {
-	if (h.is_mob) {
-		return h.handle;
+void adapter::adapter::set_name(model_handle actionable, const std::string &name) {
+	assert(actionable.type == model_handle::ACTIONABLE);
+	auto [it, inserted] = m_name_ids.try_emplace(name, m_names.size());
+	if (inserted) {
+		m_names.push_back(name);
 	}
-	return h.handle | 0xFF00u;
+	m_actionable2name.insert_or_assign(actionable.handle, it->second);
+}
+
+const std::string *adapter::adapter::name_of(model_handle actionable) const noexcept {
+	const std::size_t *id = m_actionable2name.find(actionable.handle);
+	return id == nullptr ? nullptr : &m_names[*id];
 }
@@ -1,7 +1,11 @@
 #ifndef NINJACLOWN_ADAPTER_ADAPTER_HPP
 #define NINJACLOWN_ADAPTER_ADAPTER_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <variant>
@@ -9,8 +13,14 @@
 
 #include "model/grid_point.hpp"
 #include "model/types.hpp"
+#include "utils/dense_map.hpp"
+#include "utils/dirty_set.hpp"
 #include "utils/utils.hpp"
 
+namespace spdlog {
+class logger;
+}
+
 class terminal_commands;
 
 namespace model {
@@ -22,8 +32,8 @@ namespace state {
 class holder;
 }
 
-namespace cpptoml {
-class table;
+namespace adapter::map_data {
+struct level;
 }
 
 namespace adapter {
@@ -68,15 +78,6 @@ struct view_handle {
 	size_t handle{};
 };
 
-struct model_hhash: private std::hash<utils::ssize_t> {
-	utils::ssize_t operator()(const model_handle &h) const noexcept {
-		return std::hash<utils::ssize_t>::operator()(h.handle | h.type << 16u);
-	}
-};
-struct view_hhash {
-	std::size_t operator()(const view_handle &h) const noexcept;
-};
-
 namespace request {
 	struct coords {
 		std::size_t x, y;
@@ -95,8 +96,7 @@ using draw_request = std::vector<std::variant<request::coords, request::hitbox,
 
 class adapter {
 public:
-	explicit adapter(state::holder *state_holder) noexcept
-	    : m_state{*state_holder} { }
+	explicit adapter(state::holder *state_holder) noexcept;
 
 	// -- Used by view -- //
 
@@ -104,7 +104,21 @@ public:
 
 	bool map_is_loaded() noexcept;
 
-	[[nodiscard]] draw_request tooltip_for(view_handle entity) noexcept;
+	/**
+	 * Saves the state of the simulation (see adapter/save_state.hpp). The model must not be running.
+	 */
+	bool save_state(const std::filesystem::path &file) noexcept;
+
+	/**
+	 * Reloads the map a save state was taken on, then restores the simulation from it. The model must not be running.
+	 */
+	bool load_state(const std::filesystem::path &file) noexcept;
+
+	/**
+	 * Tooltip of a view entity, cached until the model entity behind it changes (see mark_entity_as_dirty) or until tooltip
+	 * texts are reloaded
+	 */
+	[[nodiscard]] const draw_request &tooltip_for(view_handle entity) noexcept;
 	/**
 	 * Generates a tooltip for an actionable (door, ...), given its handle
 	 * @param actionable Model handle to the actionable
@@ -133,6 +147,9 @@ public:
 	void close_gate(model_handle gate) noexcept;
 	void open_gate(model_handle gate) noexcept;
 
+	/**
+	 * Marks a cell as changed. A cell is reported at most once per update, however many times it changed
+	 */
 	void update_map(const model::grid_point &target, model::cell_type new_cell) noexcept;
 	void clear_cells_changed_since_last_update() noexcept;
 
@@ -140,7 +157,11 @@ public:
 	void hide_entity(model_handle entity) noexcept;
 	void rotate_entity(model_handle entity, float new_rad) noexcept;
 	/**
-	 * "Touch" this entity so that next call to `entities_changed_since_last_update` returns it.
+	 * Replaces the projectiles displayed by the view
+	 */
+	void update_projectiles(const std::vector<float> &xs, const std::vector<float> &ys) noexcept;
+	/**
+	 * "Touch" this entity so that next call to `entities_changed_since_last_update` returns it (once).
 	 */
 	void mark_entity_as_dirty(model::handle_t) noexcept;
 	void clear_entities_changed_since_last_update() noexcept;
@@ -155,17 +176,61 @@ public:
 private:
 	friend terminal_commands;
 
-	bool load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &tables, std::string_view map) noexcept;
+	/**
+	 * Reads a map, from its compiled form when `path` is a compiled map or when the map was compiled in cache, parsing it
+	 * (and caching its compiled form) otherwise. Sets m_map_hash.
+	 */
+	[[nodiscard]] std::optional<map_data::level> read_map(const std::filesystem::path &path) noexcept;
+
+	/**
+	 * Populates the model and the view from a level
+	 */
+	bool load_level(const map_data::level &level, std::string_view map) noexcept;
+
+	void link(model_handle model, view_handle view);
+	[[nodiscard]] const view_handle *view_of(model_handle model) const noexcept;
+	[[nodiscard]] const model_handle *model_of(view_handle view) const noexcept;
+
+	[[nodiscard]] draw_request make_tooltip(view_handle entity) noexcept;
+
+	void set_name(model_handle actionable, const std::string &name);
+	[[nodiscard]] const std::string *name_of(model_handle actionable) const noexcept;
 
 	state::holder &m_state;
 
 	std::optional<view_handle> m_target_handle{}; //! handle to the objective (end of level) block
-	std::unordered_map<model_handle, view_handle, model_hhash> m_model2view;
-	std::unordered_map<view_handle, model_handle, view_hhash> m_view2model;
-	std::unordered_map<view_handle, std::string, view_hhash> m_view2name;
 
-	std::vector<model::grid_point> m_cells_changed_since_last_update{};
-	std::vector<std::size_t> m_entities_changed_since_last_update{};
+	std::uint64_t m_map_hash{0}; //! utils::fnv1a_64 of the last map file read, recorded in save states
+
+	// model <-> view translation, indexed by handle
+	utils::dense_map<view_handle> m_activator2view{};
+	utils::dense_map<view_handle> m_actionable2view{};
+	utils::dense_map<view_handle> m_entity2view{};
+	utils::dense_map<model_handle> m_mob2model{};
+	utils::dense_map<model_handle> m_object2model{};
+
+	// names given to actionables by the map
+	std::vector<std::string> m_names{};
+	std::unordered_map<std::string, std::size_t> m_name_ids{};
+	utils::dense_map<std::size_t> m_actionable2name{}; //! index in m_names
+
+	struct cached_tooltip {
+		draw_request request;
+		std::uint32_t entity_version;
+		unsigned int texts_version;
+	};
+
+	// tooltips, indexed by view handle. Only used by the view thread
+	utils::dense_map<cached_tooltip> m_mob_tooltips{};
+	utils::dense_map<cached_tooltip> m_object_tooltips{};
+
+	// bumped by mark_entity_as_dirty, from the model thread
+	std::vector<std::atomic_uint32_t> m_entity_versions; //! indexed by model handle
+
+	utils::dirty_set<model::grid_point> m_cells_changed_since_last_update{}; //! indexed by x + y * map width
+	utils::dirty_set<std::size_t> m_entities_changed_since_last_update{};   //! indexed by model handle
+
+	std::shared_ptr<spdlog::logger> m_bot_logger; //! rate limited by its sinks
 };
 } // namespace adapter
 
@@ -3,6 +3,7 @@
 #include <spdlog/spdlog.h>
 
 #include "adapter/adapter.hpp"
+#include "adapter/map_data.hpp"
 #include "facing_dir.hpp"
 #include "model/cell.hpp"
 #include "model/components.hpp"
@@ -25,66 +26,16 @@ namespace {
 template <typename T>
 using usmap = std::unordered_map<std::string, T>;
 
-struct point {
-	std::size_t x, y;
-};
-
-enum class mob_behaviour {
-	NONE,
-	SCIENTIST,
-	CLOWN,
-	DLL,
-};
-
-enum class mob_sprite {
-	NONE,
-	SCIENTIST,
-	CLOWN,
-};
-
-struct mob_definition {
-	unsigned int hp;
-	model::tick_t attack_delay;
-	model::tick_t throw_delay;
-	mob_behaviour behaviour;
-	mob_sprite sprite;
-};
-
-struct mob {
-	point pos;
-	float facing;
-	const mob_definition &type;
-};
-
-enum class activator_type {
-	NONE,
-	BUTTON,
-	INDUCTION_LOOP,
-	INFRARED_LASER,
-};
-
-struct activator {
-	point pos;
-	model::tick_t delay;
-	model::tick_t refire_after;
-	bool refire_repeat;
-	model::tick_t activation_difficulty;
-	activator_type type;
-	std::vector<size_t> target_tiles;
-};
-
-struct gate {
-	std::string name;
-	point pos;
-	bool closed;
-};
-
-struct autoshooter {
-	std::string name;
-	point pos;
-	unsigned int firing_rate;
-	float facing;
-};
+using adapter::map_data::activator;
+using adapter::map_data::activator_type;
+using adapter::map_data::autoshooter;
+using adapter::map_data::gate;
+using adapter::map_data::mob;
+using adapter::map_data::mob_behaviour;
+using adapter::map_data::mob_definition;
+using adapter::map_data::mob_sprite;
+using adapter::map_data::point;
+using adapter::map_data::tile;
 
 namespace keys {
 	constexpr const char *inherits              = "inherits";
@@ -243,7 +194,7 @@ void init_maps() {
 
 		auto try_get = [&map, &mob, &type](const char *key, auto &value) -> bool {
 			return ::try_get(mob, key, value,
-			                 utils::resource_manager::instance().log_for("adapter_map_loader_v1_0_0.mob_spawn_missing_component"),
+			                 utils::resource_manager::instance()->log_for("adapter_map_loader_v1_0_0.mob_spawn_missing_component"),
 			                 "map"_a = map, "type"_a = *type, "key"_a = key);
 		};
 
@@ -291,7 +242,7 @@ load_actors(const std::shared_ptr<cpptoml::table_array> &tables, std::string_vie
 				return try_get_silent(actor, key, value);
 			}
 			else {
-				return ::try_get(actor, key, value, utils::resource_manager::instance().log_for("adapter_map_loader_v1_0_0.actor_missing_component"), "key"_a = key,
+				return ::try_get(actor, key, value, utils::resource_manager::instance()->log_for("adapter_map_loader_v1_0_0.actor_missing_component"), "key"_a = key,
 				                 "type"_a = *type);
 			}
 		};
@@ -400,71 +351,116 @@ void test(const class maclasse &tes) { }
 
 } // namespace
 
-bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &map_file, std::string_view map) noexcept {
+std::optional<adapter::map_data::level> adapter::map_data::parse_v1_0_0(const std::shared_ptr<cpptoml::table> &map_file,
+                                                                       std::string_view map) {
 	init_maps();
 
-	auto error = [&map, this](const char *key, auto &&...vals) {
+	auto error = [&map](const char *key, auto &&...vals) {
 		utils::log::error(std::string("adapter_map_loader_v1_0_0.") + key, "map"_a = map,
 		                  std::forward<decltype(vals)>(vals)...);
 	};
 
-	view::map_viewer map_viewer{m_state};
+	auto mobs_defs_toml   = map_file->get_table_array_qualified(keys::mobs_def_table);
+	auto mobs_spawns_toml = map_file->get_table_array_qualified(keys::mobs_spawn_table);
+	auto actors_toml      = map_file->get_table_array_qualified(keys::actors_spawn_table);
+	auto map_layout_toml  = map_file->get_qualified_array_of<std::string>(keys::map_layout);
 
-	{
+	if (!mobs_defs_toml || !mobs_spawns_toml || !map_layout_toml) {
+		if (!mobs_defs_toml) {
+			error("missing_mob_def");
+		}
+		if (!mobs_spawns_toml) {
+			error("missing_mob_placings");
+		}
+		if (!map_layout_toml) {
+			error("missing_map_layout");
+		}
+		return {};
+	}
 
-		auto mobs_defs_toml   = map_file->get_table_array_qualified(keys::mobs_def_table);
-		auto mobs_spawns_toml = map_file->get_table_array_qualified(keys::mobs_spawn_table);
-		auto actors_toml      = map_file->get_table_array_qualified(keys::actors_spawn_table);
-		auto map_layout_toml  = map_file->get_qualified_array_of<std::string>(keys::map_layout);
+	usmap<mob_definition> mobs_defs = load_mobs_defs(mobs_defs_toml, map);
+	if (mobs_defs.empty()) {
+		error("bad_mob_defs", "map"_a = map);
+		return {};
+	}
 
-		if (!mobs_defs_toml || !mobs_spawns_toml || !map_layout_toml) {
-			if (!mobs_defs_toml) {
-				error("missing_mob_def");
-			}
-			if (!mobs_spawns_toml) {
-				error("missing_mob_placings");
-			}
-			if (!map_layout_toml) {
-				error("missing_map_layout");
-			}
-			return false;
-		}
+	level level;
+	level.mobs = load_mobs_spawns(mobs_spawns_toml, mobs_defs, map);
+	if (level.mobs.empty()) {
+		error("bad_mob_spawns", "map"_a = map);
+		return {};
+	}
+	if (level.mobs.size() > model::cst::max_entities) {
+		error("too_many_spawns", "map"_a = map);
+		return {};
+	}
 
-		usmap<mob_definition> mobs_defs = load_mobs_defs(mobs_defs_toml, map);
-		if (mobs_defs.empty()) {
-			error("bad_mob_defs", "map"_a = map);
-			return false;
+	if (actors_toml) {
+		auto maybe_actors = load_actors(actors_toml, map);
+		if (!maybe_actors) {
+			return {};
 		}
+		level.actors = std::move(*maybe_actors);
+	}
 
-		std::vector<mob> mobs = load_mobs_spawns(mobs_spawns_toml, mobs_defs, map);
-		if (mobs.empty()) {
-			error("bad_mob_spawns", "map"_a = map);
-			return false;
-		}
-		if (mobs.size() > model::cst::max_entities) {
-			error("too_many_spawns", "map"_a = map);
-			return false;
+	level.height = map_layout_toml->size();
+	if (level.height == 0) {
+		error("empty_map", "map"_a = map);
+		return {};
+	}
+	level.width = map_layout_toml->begin()->size();
+	if (level.width == 0) {
+		error("empty_map", "map"_a = map);
+		return {};
+	}
+
+	level.tiles.resize(level.width * level.height);
+	unsigned int line_idx{0};
+	for (const std::string &line : *map_layout_toml) {
+
+		if (line.size() != level.width) {
+			utils::log::error("adapter_map_loader_v1_0_0.bad_map_size", "map"_a = map, "line"_a = line_idx + 1);
+			return {};
 		}
 
-		std::vector<std::variant<activator, gate, autoshooter>> actors;
-		if (actors_toml) {
-			auto maybe_actors = load_actors(actors_toml, map);
-			if (!maybe_actors) {
-				return false;
+		for (size_t column_idx = 0; column_idx < level.width; ++column_idx) {
+			tile &current = level.tiles[column_idx + line_idx * level.width];
+			switch (line[column_idx]) {
+				case '#':
+					current = tile::CHASM;
+					break;
+				case ' ':
+					current = tile::CONCRETE;
+					break;
+				case '~':
+					current = tile::IRON;
+					break;
+				case 'T':
+					current = tile::TARGET;
+					break;
+				default:
+					error("bad_map_char", "char"_a = line[column_idx], "line"_a = line_idx + 1, "column"_a = column_idx + 1);
+					return {};
 			}
-			actors = std::move(*maybe_actors);
 		}
 
-		size_t map_height = map_layout_toml->size();
-		if (map_height == 0) {
-			error("empty_map", "map"_a = map);
-			return false;
-		}
-		size_t map_width = map_layout_toml->begin()->size();
-		if (map_width == 0) {
-			error("empty_map", "map"_a = map);
-			return false;
-		}
+		++line_idx;
+	}
+
+	return level;
+}
+
+bool adapter::adapter::load_level(const map_data::level &level, std::string_view map) noexcept {
+	auto error = [&map](const char *key, auto &&...vals) {
+		utils::log::error(std::string("adapter_map_loader_v1_0_0.") + key, "map"_a = map,
+		                  std::forward<decltype(vals)>(vals)...);
+	};
+
+	view::map_viewer map_viewer{m_state};
+
+	{
+		const std::size_t map_width  = level.width;
+		const std::size_t map_height = level.height;
 
 		auto map_viewer_omap = map_viewer.m_overmap.acquire();
 
@@ -473,29 +469,22 @@ bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &ma
 		std::vector<std::vector<view::map::cell>> view_map{map_width, {map_height, {view::map::cell::abyss}}};
 		world.map.resize(map_width, map_height);
 
-		unsigned int line_idx{0};
-		for (const std::string &line : *map_layout_toml) {
-
-			if (line.size() != map_width) {
-				utils::log::error("adapter_map_loader_v1_0_0.bad_map_size", "map"_a = map, "line"_a = line_idx + 1);
-				return false;
-			}
-
-			for (size_t column_idx = 0; column_idx < map_width; ++column_idx) {
-				switch (line[column_idx]) {
-					case '#':
+		for (std::size_t line_idx = 0; line_idx < map_height; ++line_idx) {
+			for (std::size_t column_idx = 0; column_idx < map_width; ++column_idx) {
+				switch (level.at(column_idx, line_idx)) {
+					case tile::CHASM:
 						world.map[column_idx][line_idx].type = model::cell_type::CHASM;
 						view_map[column_idx][line_idx]        = view::map::cell::abyss;
 						break;
-					case ' ':
+					case tile::CONCRETE:
 						world.map[column_idx][line_idx].type = model::cell_type::GROUND;
 						view_map[column_idx][line_idx]        = view::map::cell::concrete_tile;
 						break;
-					case '~':
+					case tile::IRON:
 						world.map[column_idx][line_idx].type = model::cell_type::GROUND;
 						view_map[column_idx][line_idx]        = view::map::cell::iron_tile;
 						break;
-					case 'T': {
+					case tile::TARGET: {
 						world.map[column_idx][line_idx].type = model::cell_type::GROUND;
 						view_map[column_idx][line_idx]        = view::map::cell::concrete_tile;
 						world.target_tile = {column_idx, line_idx};
@@ -507,13 +496,8 @@ bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &ma
 						m_target_handle = map_viewer_omap->add_object(std::move(obj));
 						break;
 					}
-					default:
-						error("bad_map_char", "char"_a = line[column_idx], "line"_a = line_idx + 1, "column"_a = column_idx + 1);
-						return false;
 				}
 			}
-
-			++line_idx;
 		}
 
 		// TODO externaliser vers le fichier de la carte + ajouter une option de mise à l’échelle des objets graphiques
@@ -521,7 +505,7 @@ bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &ma
 		const float DEFAULT_HITBOX_HALF_HEIGHT = 0.25f;
 
 		size_t model_entity_handle = 0;
-		for (const mob &mob : mobs) {
+		for (const mob &mob : level.mobs) {
 			const float CENTER_X = static_cast<float>(mob.pos.x) * model::cst::cell_width + model::cst::cell_width / 2.f;
 			const float CENTER_Y = static_cast<float>(mob.pos.y) * model::cst::cell_height + model::cst::cell_height / 2.f;
 
@@ -530,10 +514,10 @@ bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &ma
 					world.components.metadata[model_entity_handle].kind = ninja_api::nnj_entity_kind::EK_HARMLESS;
 					break;
 				case mob_behaviour::SCIENTIST:
-					// TODO
+					world.components.metadata[model_entity_handle].kind = ninja_api::nnj_entity_kind::EK_PATROL;
 					break;
 				case mob_behaviour::CLOWN:
-					// TODO
+					world.components.metadata[model_entity_handle].kind = ninja_api::nnj_entity_kind::EK_AGGRESSIVE;
 					break;
 				case mob_behaviour::DLL:
 					world.components.metadata[model_entity_handle].kind = ninja_api::nnj_entity_kind::EK_DLL;
@@ -567,13 +551,12 @@ bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &ma
 
 			view_handle view_handle = map_viewer_omap->add_mob(std::move(m));
 			model_handle model_handle{model_entity_handle, model_handle::ENTITY};
-			m_model2view[model_handle] = view_handle;
-			m_view2model[view_handle]  = model_handle;
+			link(model_handle, view_handle);
 
 			++model_entity_handle;
 		}
 
-		for (const std::variant<activator, gate, autoshooter> &actor : actors) {
+		for (const map_data::actor &actor : level.actors) {
 
 			utils::visitor visitor{
 			  [&](const activator &activator) {
@@ -611,8 +594,7 @@ bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &ma
 
 				  view_handle view_handle = map_viewer_omap->add_object(std::move(o));
 				  model_handle model_handle{world.activators.size(), model_handle::ACTIVATOR};
-				  m_model2view[model_handle] = view_handle;
-				  m_view2model[view_handle]  = model_handle;
+				  link(model_handle, view_handle);
 
 				  world.activators.push_back({activator.target_tiles,
 				                              activator.refire_after == std::numeric_limits<decltype(activator.refire_after)>::max() ?
@@ -632,15 +614,14 @@ bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &ma
 				  o.set_id(utils::resources_type::object_id::gate);
 				  view_handle view_handle = map_viewer_omap->add_object(std::move(o));
 				  model_handle model_handle{world.actionables.size() - 1, model_handle::ACTIONABLE};
-				  m_model2view[model_handle] = view_handle;
-				  m_view2model[view_handle]  = model_handle;
+				  link(model_handle, view_handle);
 				  if (gate.closed) {
 					  world.map[gate.pos.x][gate.pos.y].type = model::cell_type::CHASM;
 				  } else {
 					  map_viewer_omap->hide(view_handle);
 				  }
 
-				  m_view2name[view_handle] = gate.name;
+				  set_name(model_handle, gate.name);
 			  },
 			  [&](const autoshooter &autoshooter) {
 				  const float TOPLEFT_X = static_cast<float>(autoshooter.pos.x) * model::cst::cell_width;
@@ -656,10 +637,9 @@ bool adapter::adapter::load_map_v1_0_0(const std::shared_ptr<cpptoml::table> &ma
 				  o.set_id(utils::resources_type::object_id::autoshooter);
 				  view_handle view_handle = map_viewer_omap->add_object(std::move(o));
 				  model_handle model_handle{world.actionables.size() - 1, model_handle::ACTIONABLE};
-				  m_model2view[model_handle] = view_handle;
-				  m_view2model[view_handle]  = model_handle;
+				  link(model_handle, view_handle);
 
-				  m_view2name[view_handle] = autoshooter.name;
+				  set_name(model_handle, autoshooter.name);
 			  }};
 			std::visit(visitor, actor);
 		}
@@ -0,0 +1,247 @@
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include "adapter/compiled_map.hpp"
+#include "model/components.hpp"
+#include "utils/binary_stream.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/system.hpp"
+#include "utils/visitor.hpp"
+
+namespace {
+using namespace adapter::map_data;
+
+constexpr std::array<char, 8> magic{'N', 'C', 'M', 'A', 'P', '\0', '\0', '\0'};
+constexpr std::uint32_t format_version     = 1;
+constexpr std::uint32_t endianness_marker  = 0x01020304;
+constexpr std::uint8_t activator_kind      = 0;
+constexpr std::uint8_t gate_kind           = 1;
+constexpr std::uint8_t autoshooter_kind    = 2;
+
+void write_point(utils::binary_writer &out, point pos) {
+	out.write_size(pos.x);
+	out.write_size(pos.y);
+}
+
+bool read_point(utils::binary_reader &in, point &pos) noexcept {
+	in.read_size(pos.x);
+	return in.read_size(pos.y);
+}
+
+bool read_name(utils::binary_reader &in, std::string &name) {
+	const std::string_view bytes = in.read_string();
+	name.assign(bytes.data(), bytes.size());
+	return in.ok();
+}
+
+bool in_level(const level &level, point pos) noexcept {
+	return pos.x < level.width && pos.y < level.height;
+}
+
+std::optional<level> read_level(utils::binary_reader &in) {
+	std::array<char, magic.size()> file_magic{};
+	std::uint32_t version{};
+	std::uint32_t marker{};
+	std::uint64_t source_hash{};
+	if (!in.read(file_magic) || file_magic != magic || !in.read(version) || version != format_version || !in.read(marker)
+	    || marker != endianness_marker || !in.read(source_hash)) {
+		return {};
+	}
+
+	level level;
+	std::size_t mob_count{};
+	std::size_t actor_count{};
+	in.read_size(level.width);
+	in.read_size(level.height);
+	in.read_size(mob_count);
+	in.read_size(actor_count);
+	if (!in.ok() || level.width == 0 || level.height == 0 || mob_count == 0 || mob_count > model::cst::max_entities) {
+		return {};
+	}
+
+	std::string_view tiles = in.take(level.width * level.height);
+	if (!in.ok()) {
+		return {};
+	}
+	level.tiles.resize(tiles.size());
+	std::memcpy(level.tiles.data(), tiles.data(), tiles.size());
+	for (tile t : level.tiles) {
+		if (t > tile::TARGET) {
+			return {};
+		}
+	}
+
+	level.mobs.resize(mob_count);
+	for (mob &mob : level.mobs) {
+		read_point(in, mob.pos);
+		in.read(mob.facing);
+		in.read(mob.type.hp);
+		in.read(mob.type.attack_delay);
+		in.read(mob.type.throw_delay);
+		in.read_enum(mob.type.behaviour, mob_behaviour::DLL);
+		in.read_enum(mob.type.sprite, mob_sprite::CLOWN);
+		if (!in.ok() || !in_level(level, mob.pos) || mob.type.sprite == mob_sprite::NONE) {
+			return {};
+		}
+	}
+
+	level.actors.reserve(actor_count);
+	for (std::size_t i = 0; i < actor_count; ++i) {
+		std::uint8_t kind{};
+		in.read(kind);
+		if (kind == activator_kind) {
+			activator activator{};
+			std::size_t target_count{};
+			read_point(in, activator.pos);
+			in.read(activator.delay);
+			in.read(activator.refire_after);
+			in.read(activator.refire_repeat);
+			in.read(activator.activation_difficulty);
+			in.read_enum(activator.type, activator_type::INFRARED_LASER);
+			in.read_size(target_count);
+			if (!in.ok() || target_count > actor_count) {
+				return {};
+			}
+			activator.target_tiles.resize(target_count);
+			for (std::size_t &target : activator.target_tiles) {
+				// targets are defined before the activators using them
+				if (!in.read_size(target) || target >= i) {
+					return {};
+				}
+			}
+			level.actors.emplace_back(std::move(activator));
+		}
+		else if (kind == gate_kind) {
+			gate gate{};
+			read_name(in, gate.name);
+			read_point(in, gate.pos);
+			in.read(gate.closed);
+			level.actors.emplace_back(std::move(gate));
+		}
+		else if (kind == autoshooter_kind) {
+			autoshooter autoshooter{};
+			read_name(in, autoshooter.name);
+			read_point(in, autoshooter.pos);
+			in.read(autoshooter.firing_rate);
+			in.read(autoshooter.facing);
+			level.actors.emplace_back(std::move(autoshooter));
+		}
+		else {
+			return {};
+		}
+
+		const point pos = std::visit([](const auto &actor) { return actor.pos; }, level.actors.back());
+		if (!in.ok() || !in_level(level, pos)) {
+			return {};
+		}
+	}
+
+	return level;
+}
+
+void write_level(utils::binary_writer &out, const level &level, std::uint64_t source_hash) {
+	out.write(magic);
+	out.write(format_version);
+	out.write(endianness_marker);
+	out.write(source_hash);
+	out.write_size(level.width);
+	out.write_size(level.height);
+	out.write_size(level.mobs.size());
+	out.write_size(level.actors.size());
+
+	for (tile t : level.tiles) {
+		out.write(t);
+	}
+
+	for (const mob &mob : level.mobs) {
+		write_point(out, mob.pos);
+		out.write(mob.facing);
+		out.write(mob.type.hp);
+		out.write(mob.type.attack_delay);
+		out.write(mob.type.throw_delay);
+		out.write(mob.type.behaviour);
+		out.write(mob.type.sprite);
+	}
+
+	for (const actor &actor : level.actors) {
+		std::visit(utils::visitor{
+		             [&out](const activator &activator) {
+			             out.write(activator_kind);
+			             write_point(out, activator.pos);
+			             out.write(activator.delay);
+			             out.write(activator.refire_after);
+			             out.write(activator.refire_repeat);
+			             out.write(activator.activation_difficulty);
+			             out.write(activator.type);
+			             out.write_size(activator.target_tiles.size());
+			             for (std::size_t target : activator.target_tiles) {
+				             out.write_size(target);
+			             }
+		             },
+		             [&out](const gate &gate) {
+			             out.write(gate_kind);
+			             out.write(gate.name);
+			             write_point(out, gate.pos);
+			             out.write(gate.closed);
+		             },
+		             [&out](const autoshooter &autoshooter) {
+			             out.write(autoshooter_kind);
+			             out.write(autoshooter.name);
+			             write_point(out, autoshooter.pos);
+			             out.write(autoshooter.firing_rate);
+			             out.write(autoshooter.facing);
+		             },
+		           },
+		           actor);
+	}
+}
+} // namespace
+
+bool adapter::map_data::write_compiled(const level &level, std::uint64_t source_hash, const std::filesystem::path &file) noexcept {
+	try {
+		std::error_code ec;
+		std::filesystem::create_directories(file.parent_path(), ec);
+
+		std::filesystem::path temporary = file;
+		temporary += ".tmp";
+		{
+			std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+			utils::binary_writer out{stream};
+			write_level(out, level, source_hash);
+			if (!out.flush()) {
+				return false;
+			}
+		}
+		std::filesystem::rename(temporary, file, ec);
+		return !ec;
+	}
+	catch (const std::exception &) {
+		return false;
+	}
+}
+
+std::optional<adapter::map_data::level> adapter::map_data::read_compiled(const std::filesystem::path &file) noexcept {
+	utils::mapped_file mapped;
+	if (!mapped.open(file)) {
+		return {};
+	}
+	return read_compiled(mapped.view());
+}
+
+std::optional<adapter::map_data::level> adapter::map_data::read_compiled(std::string_view bytes) noexcept {
+	try {
+		utils::binary_reader in{bytes};
+		return read_level(in);
+	}
+	catch (const std::bad_alloc &) {
+		return {};
+	}
+}
+
+std::filesystem::path adapter::map_data::cache_path(std::uint64_t source_hash) {
+	return utils::config_directory() / "map_cache" / (fmt::format("{:016x}", source_hash) + std::string{compiled_extension});
+}
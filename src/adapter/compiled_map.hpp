@@ -0,0 +1,49 @@
+#ifndef NINJACLOWN_ADAPTER_COMPILED_MAP_HPP
+#define NINJACLOWN_ADAPTER_COMPILED_MAP_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+#include "adapter/map_data.hpp"
+
+/**
+ * Binary form of parsed maps, loaded without any text parsing.
+ *
+ * Layout (native endianness, checked through a marker):
+ *   header  : magic, format version, endianness marker, hash of the source map, width, height, mob count, actor count
+ *   tiles   : width * height bytes, indexed by x + y * width
+ *   mobs    : fixed size records
+ *   actors  : kind byte followed by the actor's fields, strings being prefixed by their length
+ */
+namespace adapter::map_data {
+
+constexpr std::string_view compiled_extension = ".ncmap";
+
+/**
+ * Writes the level to `file`, through a temporary file so that readers never see partially written files
+ * @param source_hash hash of the map file `level` was parsed from
+ */
+[[nodiscard]] bool write_compiled(const level &level, std::uint64_t source_hash, const std::filesystem::path &file) noexcept;
+
+/**
+ * Maps `file` in memory and reads the level it holds
+ * @return nothing if the file does not exist, was written by another version of the format, or is corrupted
+ */
+[[nodiscard]] std::optional<level> read_compiled(const std::filesystem::path &file) noexcept;
+
+/**
+ * Reads the level held by `bytes` (content of a compiled map file)
+ * @return nothing if the bytes were written by another version of the format, or are corrupted
+ */
+[[nodiscard]] std::optional<level> read_compiled(std::string_view bytes) noexcept;
+
+/**
+ * @return where the compiled form of a map file whose content hashes to `source_hash` is cached
+ */
+[[nodiscard]] std::filesystem::path cache_path(std::uint64_t source_hash);
+
+} // namespace adapter::map_data
+
+#endif //NINJACLOWN_ADAPTER_COMPILED_MAP_HPP
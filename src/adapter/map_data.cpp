@@ -0,0 +1,38 @@
+#include <cpptoml/cpptoml.h>
+
+#include "adapter/map_data.hpp"
+#include "utils/logging.hpp"
+#include "utils/memory_stream.hpp"
+
+using fmt::literals::operator""_a;
+
+std::optional<adapter::map_data::level> adapter::map_data::parse(std::string_view content, std::string_view map) noexcept {
+	try {
+		std::shared_ptr<cpptoml::table> map_file;
+		try {
+			utils::memory_istream stream{content};
+			map_file = cpptoml::parser{stream}.parse();
+		}
+		catch (const cpptoml::parse_exception &parse_exception) {
+			utils::log::error("adapter.map_load_failure", "path"_a = map, "reason"_a = parse_exception.what());
+			return {};
+		}
+
+		auto version = map_file->get_qualified_as<std::string>("file.version");
+		if (!version) {
+			utils::log::error("adapter.map_load_failure", "path"_a = map, "reason"_a = "unknown file format (missing [file].version)");
+			return {};
+		}
+
+		if (*version == "1.0.0") {
+			return parse_v1_0_0(map_file, map);
+		}
+
+		utils::log::error("adapter.unsupported_version", "path"_a = map, "version"_a = *version);
+		return {};
+	}
+	catch (const std::bad_alloc &) {
+		utils::log::error("adapter.map_load_failure", "path"_a = map, "reason"_a = "out of memory");
+		return {};
+	}
+}
@@ -0,0 +1,121 @@
+#ifndef NINJACLOWN_ADAPTER_MAP_DATA_HPP
+#define NINJACLOWN_ADAPTER_MAP_DATA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "model/types.hpp"
+
+namespace cpptoml {
+class table;
+}
+
+/**
+ * Content of a map file, once parsed and validated: what the adapter needs to populate the model and the view.
+ */
+namespace adapter::map_data {
+
+struct point {
+	std::size_t x, y;
+};
+
+enum class tile : std::uint8_t {
+	CHASM,    //!< '#'
+	CONCRETE, //!< ' '
+	IRON,     //!< '~'
+	TARGET,   //!< 'T', concrete with the objective on it
+};
+
+enum class mob_behaviour : std::uint8_t {
+	NONE,
+	SCIENTIST,
+	CLOWN,
+	DLL,
+};
+
+enum class mob_sprite : std::uint8_t {
+	NONE,
+	SCIENTIST,
+	CLOWN,
+};
+
+struct mob_definition {
+	unsigned int hp;
+	model::tick_t attack_delay;
+	model::tick_t throw_delay;
+	mob_behaviour behaviour;
+	mob_sprite sprite;
+};
+
+struct mob {
+	point pos;
+	float facing;
+	mob_definition type;
+};
+
+enum class activator_type : std::uint8_t {
+	NONE,
+	BUTTON,
+	INDUCTION_LOOP,
+	INFRARED_LASER,
+};
+
+struct activator {
+	point pos;
+	model::tick_t delay;
+	model::tick_t refire_after; //!< max() when the activator never refires
+	bool refire_repeat;
+	model::tick_t activation_difficulty;
+	activator_type type;
+	std::vector<std::size_t> target_tiles; //!< indexes of actors
+};
+
+struct gate {
+	std::string name;
+	point pos;
+	bool closed;
+};
+
+struct autoshooter {
+	std::string name;
+	point pos;
+	unsigned int firing_rate;
+	float facing;
+};
+
+using actor = std::variant<activator, gate, autoshooter>;
+
+struct level {
+	std::size_t width{0};
+	std::size_t height{0};
+	std::vector<tile> tiles{}; //!< indexed by x + y * width
+	std::vector<mob> mobs{};
+	std::vector<actor> actors{};
+
+	[[nodiscard]] tile at(std::size_t x, std::size_t y) const noexcept {
+		return tiles[x + y * width];
+	}
+};
+
+/**
+ * Parses the content of a map file, whatever its version, logging the reason of failures
+ * @param map name of the map, for logs
+ */
+[[nodiscard]] std::optional<level> parse(std::string_view content, std::string_view map) noexcept;
+
+/**
+ * Parses a map file of version 1.0.0, logging the reason of failures
+ * @param map name of the map, for logs
+ */
+[[nodiscard]] std::optional<level> parse_v1_0_0(const std::shared_ptr<cpptoml::table> &map_file, std::string_view map);
+
+} // namespace adapter::map_data
+
+#endif //NINJACLOWN_ADAPTER_MAP_DATA_HPP
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <random>
+#include <tuple>
+
+#include <fmt/format.h>
+
+#include "adapter/map_generator.hpp"
+#include "model/components.hpp"
+#include "utils/universal_constants.hpp"
+#include "utils/visitor.hpp"
+
+namespace {
+using namespace adapter::map_data;
+
+// standard distributions are implementation defined, unlike the engine: draws are done by hand for levels to only depend on the seed
+class seeded_random {
+public:
+	explicit seeded_random(std::uint64_t seed) noexcept
+	    : m_engine{seed} { }
+
+	// uniform in [0 ; 1)
+	double unit() noexcept {
+		return static_cast<double>(m_engine() >> 11u) * 0x1.0p-53; // NOLINT
+	}
+
+	// uniform in [0 ; bound)
+	std::size_t below(std::size_t bound) noexcept {
+		return std::min(static_cast<std::size_t>(unit() * static_cast<double>(bound)), bound - 1);
+	}
+
+	bool chance(float probability) noexcept {
+		return unit() < probability;
+	}
+
+	float angle() noexcept {
+		return static_cast<float>((unit() * 2. - 1.) * uni::math::pi<double>);
+	}
+
+private:
+	std::mt19937_64 m_engine;
+};
+
+constexpr std::size_t min_wall_length = 4;
+constexpr std::size_t max_wall_length = 12;
+
+bool valid_density(float density) noexcept {
+	return density >= 0.f && density <= 1.f;
+}
+
+void draw_walls(level &level, seeded_random &rng, float density) {
+	const std::size_t interior       = (level.width - 2) * (level.height - 2);
+	const std::size_t average_length = (min_wall_length + max_wall_length) / 2;
+	const auto wall_count = static_cast<std::size_t>(static_cast<double>(interior) * density / static_cast<double>(average_length));
+
+	for (std::size_t i = 0; i < wall_count; ++i) {
+		std::size_t x            = 1 + rng.below(level.width - 2);
+		std::size_t y            = 1 + rng.below(level.height - 2);
+		const bool horizontal    = rng.chance(0.5f);
+		const std::size_t length = min_wall_length + rng.below(max_wall_length - min_wall_length + 1);
+		for (std::size_t j = 0; j < length && x < level.width - 1 && y < level.height - 1; ++j) {
+			level.tiles[x + y * level.width] = tile::CHASM;
+			(horizontal ? x : y) += 1;
+		}
+	}
+}
+
+// picks distinct ground cells, in a reproducible order
+class cell_picker {
+public:
+	explicit cell_picker(const level &level)
+	    : m_level{level}
+	    , m_taken(level.tiles.size(), false) {
+		m_free = static_cast<std::size_t>(std::count(level.tiles.begin(), level.tiles.end(), tile::CONCRETE))
+		         + static_cast<std::size_t>(std::count(level.tiles.begin(), level.tiles.end(), tile::IRON));
+	}
+
+	[[nodiscard]] std::size_t free_cells() const noexcept {
+		return m_free;
+	}
+
+	// must not be called more than free_cells() times
+	point pick(seeded_random &rng) {
+		while (true) {
+			const std::size_t index = rng.below(m_level.tiles.size());
+			if (!m_taken[index] && m_level.tiles[index] != tile::CHASM) {
+				m_taken[index] = true;
+				--m_free;
+				return {index % m_level.width, index / m_level.width};
+			}
+		}
+	}
+
+private:
+	const level &m_level;
+	std::vector<bool> m_taken;
+	std::size_t m_free{0};
+};
+
+mob_definition definition_for(mob_behaviour behaviour) noexcept {
+	const mob_sprite sprite = behaviour == mob_behaviour::DLL || behaviour == mob_behaviour::CLOWN ? mob_sprite::CLOWN : mob_sprite::SCIENTIST;
+	return {1, model::component::default_attack_delay, model::component::default_throw_delay, behaviour, sprite};
+}
+
+const char *to_string(mob_behaviour behaviour) noexcept {
+	switch (behaviour) {
+		case mob_behaviour::SCIENTIST:
+			return "scientist";
+		case mob_behaviour::CLOWN:
+			return "clown";
+		case mob_behaviour::DLL:
+			return "dll";
+		case mob_behaviour::NONE:
+			[[fallthrough]];
+		default:
+			return "none";
+	}
+}
+
+const char *to_string(mob_sprite sprite) noexcept {
+	return sprite == mob_sprite::SCIENTIST ? "scientist" : "clown";
+}
+
+const char *to_string(activator_type type) noexcept {
+	switch (type) {
+		case activator_type::INDUCTION_LOOP:
+			return "induction_loop";
+		case activator_type::INFRARED_LASER:
+			return "infrared_laser";
+		case activator_type::BUTTON:
+			[[fallthrough]];
+		case activator_type::NONE:
+			[[fallthrough]];
+		default:
+			return "button";
+	}
+}
+
+std::string_view actionable_name(const actor &actor) noexcept {
+	if (const auto *gate = std::get_if<adapter::map_data::gate>(&actor)) {
+		return gate->name;
+	}
+	if (const auto *autoshooter = std::get_if<adapter::map_data::autoshooter>(&actor)) {
+		return autoshooter->name;
+	}
+	return {};
+}
+
+char to_char(tile tile) noexcept {
+	switch (tile) {
+		case tile::CONCRETE:
+			return ' ';
+		case tile::IRON:
+			return '~';
+		case tile::TARGET:
+			return 'T';
+		case tile::CHASM:
+			[[fallthrough]];
+		default:
+			return '#';
+	}
+}
+} // namespace
+
+std::string_view adapter::map_data::invalid_setting(const generator_settings &settings) noexcept {
+	if (settings.width < generator_settings::min_size || settings.height < generator_settings::min_size) {
+		return "the map is too small";
+	}
+	if (settings.width > generator_settings::max_size || settings.height > generator_settings::max_size) {
+		return "the map is too large";
+	}
+	if (!valid_density(settings.wall_density) || !valid_density(settings.chasm_density) || !valid_density(settings.iron_density)
+	    || !valid_density(settings.closed_gates)) {
+		return "densities and ratios must be between 0 and 1";
+	}
+
+	const std::size_t mobs = settings.players + settings.harmless + settings.patrols + settings.aggressives;
+	if (mobs == 0) {
+		return "maps need at least one mob";
+	}
+	if (mobs > model::cst::max_entities) {
+		return "too many mobs";
+	}
+	if (settings.activators != 0 && settings.gates + settings.autoshooters == 0) {
+		return "activators need gates or autoshooters to act on";
+	}
+	return {};
+}
+
+std::optional<adapter::map_data::level> adapter::map_data::generate(const generator_settings &settings) noexcept {
+	if (!invalid_setting(settings).empty()) {
+		return {};
+	}
+
+	try {
+		seeded_random rng{settings.seed};
+
+		level level;
+		level.width  = settings.width;
+		level.height = settings.height;
+		level.tiles.resize(level.width * level.height, tile::CHASM);
+
+		for (std::size_t y = 1; y < level.height - 1; ++y) {
+			for (std::size_t x = 1; x < level.width - 1; ++x) {
+				level.tiles[x + y * level.width] = rng.chance(settings.iron_density) ? tile::IRON : tile::CONCRETE;
+			}
+		}
+
+		draw_walls(level, rng, settings.wall_density);
+		for (std::size_t y = 1; y < level.height - 1; ++y) {
+			for (std::size_t x = 1; x < level.width - 1; ++x) {
+				if (rng.chance(settings.chasm_density)) {
+					level.tiles[x + y * level.width] = tile::CHASM;
+				}
+			}
+		}
+
+		cell_picker cells{level};
+		const std::size_t mob_count = settings.players + settings.harmless + settings.patrols + settings.aggressives;
+		if (cells.free_cells() < 1 + mob_count + settings.gates + settings.autoshooters + settings.activators) {
+			return {};
+		}
+
+		const point target = cells.pick(rng);
+		level.tiles[target.x + target.y * level.width] = tile::TARGET;
+
+		auto add_mobs = [&](std::size_t count, mob_behaviour behaviour) {
+			for (std::size_t i = 0; i < count; ++i) {
+				level.mobs.push_back(mob{cells.pick(rng), rng.angle(), definition_for(behaviour)});
+			}
+		};
+		add_mobs(settings.players, mob_behaviour::DLL);
+		add_mobs(settings.harmless, mob_behaviour::NONE);
+		add_mobs(settings.patrols, mob_behaviour::SCIENTIST);
+		add_mobs(settings.aggressives, mob_behaviour::CLOWN);
+
+		// gates and autoshooters first, so that activators targets are both actor and actionable indexes
+		for (std::size_t i = 0; i < settings.gates; ++i) {
+			level.actors.emplace_back(gate{fmt::format("gate{}", i), cells.pick(rng), rng.chance(settings.closed_gates)});
+		}
+		for (std::size_t i = 0; i < settings.autoshooters; ++i) {
+			level.actors.emplace_back(autoshooter{fmt::format("autoshooter{}", i), cells.pick(rng), settings.firing_rate, rng.angle()});
+		}
+
+		const std::size_t actionables = level.actors.size();
+		for (std::size_t i = 0; i < settings.activators; ++i) {
+			activator activator;
+			activator.pos                   = cells.pick(rng);
+			activator.delay                 = settings.activator_delay;
+			activator.refire_after          = settings.refire_after;
+			activator.refire_repeat         = settings.refire_repeat;
+			activator.activation_difficulty = model::default_activation_difficulty;
+			activator.type                  = activator_type::BUTTON;
+			activator.target_tiles.push_back(rng.below(actionables));
+			level.actors.emplace_back(std::move(activator));
+		}
+
+		return level;
+	}
+	catch (const std::bad_alloc &) {
+		return {};
+	}
+}
+
+std::string adapter::map_data::to_v1_0_0(const level &level) {
+	// identical definitions are shared
+	std::map<std::tuple<unsigned int, model::tick_t, model::tick_t, mob_behaviour, mob_sprite>, std::string> definitions;
+	auto key_of = [](const mob_definition &def) {
+		return std::make_tuple(def.hp, def.attack_delay, def.throw_delay, def.behaviour, def.sprite);
+	};
+
+	std::string content = "[file]\n\tversion = \"1.0.0\"\n[mobs]\n";
+	for (const mob &mob : level.mobs) {
+		auto [it, inserted] = definitions.try_emplace(key_of(mob.type), fmt::format("mob{}", definitions.size()));
+		if (inserted) {
+			content += fmt::format("\t[[mobs.definition]]\n\t\tname = \"{}\"\n\t\thp = {}\n\t\tattack_delay = {}\n\t\tthrow_delay = {}\n"
+			                       "\t\tbehaviour = \"{}\"\n\t\tsprite = \"{}\"\n",
+			                       it->second, mob.type.hp, mob.type.attack_delay, mob.type.throw_delay, to_string(mob.type.behaviour),
+			                       to_string(mob.type.sprite));
+		}
+	}
+	for (const mob &mob : level.mobs) {
+		content += fmt::format("\t[[mobs.spawn]]\n\t\ttype = \"{}\"\n\t\tpos.x = {}\n\t\tpos.y = {}\n\t\tfacing = {}\n",
+		                       definitions[key_of(mob.type)], mob.pos.x, mob.pos.y, mob.facing);
+	}
+
+	content += "[actors]\n";
+	for (const actor &actor : level.actors) {
+		std::visit(utils::visitor{
+		             [&](const activator &activator) {
+			             content += fmt::format("\t[[actors.spawn]]\n\t\ttype = \"{}\"\n\t\tpos.x = {}\n\t\tpos.y = {}\n\t\tdelay = {}\n"
+			                                    "\t\tactivation_difficulty = {}\n\t\trefire_repeat = {}\n",
+			                                    to_string(activator.type), activator.pos.x, activator.pos.y, activator.delay,
+			                                    activator.activation_difficulty, activator.refire_repeat);
+			             if (activator.refire_after != std::numeric_limits<model::tick_t>::max()) {
+				             content += fmt::format("\t\trefire_after = {}\n", activator.refire_after);
+			             }
+			             content += "\t\tacts_on = [";
+			             for (std::size_t i = 0; i < activator.target_tiles.size(); ++i) {
+				             content += fmt::format("{}\"{}\"", i == 0 ? "" : ", ", actionable_name(level.actors[activator.target_tiles[i]]));
+			             }
+			             content += "]\n";
+		             },
+		             [&](const gate &gate) {
+			             content += fmt::format("\t[[actors.spawn]]\n\t\tname = \"{}\"\n\t\ttype = \"gate\"\n\t\tpos.x = {}\n\t\tpos.y = {}\n"
+			                                    "\t\tclosed = {}\n",
+			                                    gate.name, gate.pos.x, gate.pos.y, gate.closed);
+		             },
+		             [&](const autoshooter &autoshooter) {
+			             content += fmt::format("\t[[actors.spawn]]\n\t\tname = \"{}\"\n\t\ttype = \"autoshooter\"\n\t\tpos.x = {}\n"
+			                                    "\t\tpos.y = {}\n\t\tfiring_rate = {}\n\t\tfacing = {}\n",
+			                                    autoshooter.name, autoshooter.pos.x, autoshooter.pos.y, autoshooter.firing_rate,
+			                                    autoshooter.facing);
+		             },
+		           },
+		           actor);
+	}
+
+	content += "[map]\n\tlayout = [\n";
+	content.reserve(content.size() + level.height * (level.width + 6));
+	for (std::size_t y = 0; y < level.height; ++y) {
+		content += "\t\t\"";
+		for (std::size_t x = 0; x < level.width; ++x) {
+			content += to_char(level.at(x, y));
+		}
+		content += y + 1 == level.height ? "\"\n" : "\",\n";
+	}
+	content += "\t]\n";
+	return content;
+}
+
+bool adapter::map_data::write_v1_0_0(const level &level, const std::filesystem::path &file) noexcept {
+	try {
+		const std::string content = to_v1_0_0(level);
+		std::ofstream stream{file, std::ios::binary | std::ios::trunc};
+		stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+		return static_cast<bool>(stream);
+	}
+	catch (const std::exception &) {
+		return false;
+	}
+}
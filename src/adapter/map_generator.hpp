@@ -0,0 +1,72 @@
+#ifndef NINJACLOWN_ADAPTER_MAP_GENERATOR_HPP
+#define NINJACLOWN_ADAPTER_MAP_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "adapter/map_data.hpp"
+#include "model/activator.hpp"
+
+/**
+ * Procedural levels, to get large and reproducible inputs for benchmarks
+ */
+namespace adapter::map_data {
+
+struct generator_settings {
+	static constexpr std::size_t min_size = 3;
+	static constexpr std::size_t max_size = 4096;
+
+	std::size_t width{64};
+	std::size_t height{64};
+	std::uint64_t seed{0};
+
+	// version 1.0.0 maps have no wall tile: walls are straight lines of chasm cells, holes are isolated chasm cells
+	float wall_density{0.05f};  //!< ratio of the map covered by walls
+	float chasm_density{0.05f}; //!< ratio of the map covered by holes
+	float iron_density{0.1f};   //!< ratio of ground cells made of iron (cosmetic)
+
+	std::size_t gates{0};
+	float closed_gates{0.5f}; //!< ratio of gates initially closed
+	std::size_t autoshooters{0};
+	unsigned int firing_rate{20};
+
+	std::size_t activators{0}; //!< buttons, each acting on a random gate or autoshooter
+	model::tick_t activator_delay{model::default_activation_delay};
+	model::tick_t refire_after{std::numeric_limits<model::tick_t>::max()}; //!< max() for activators that never refire
+	bool refire_repeat{false};
+
+	// mobs, by behaviour
+	std::size_t players{1}; //!< controlled by the dll
+	std::size_t harmless{0};
+	std::size_t patrols{0};
+	std::size_t aggressives{0};
+};
+
+/**
+ * @return why `settings` cannot be used to generate a level, or an empty string if they can
+ */
+[[nodiscard]] std::string_view invalid_setting(const generator_settings &settings) noexcept;
+
+/**
+ * Generates a level surrounded by chasm, with a single objective. Every mob and actor is put on its own ground cell; the
+ * objective is not guaranteed to be reachable. A given seed generates the same level on every platform.
+ * The result can be loaded with adapter::load_level, or written to a map file.
+ * @return an empty optional if the settings are invalid, or if there are not enough ground cells left for mobs and actors
+ */
+[[nodiscard]] std::optional<level> generate(const generator_settings &settings) noexcept;
+
+/**
+ * Writes `level` as a version 1.0.0 map file
+ */
+[[nodiscard]] std::string to_v1_0_0(const level &level);
+
+[[nodiscard]] bool write_v1_0_0(const level &level, const std::filesystem::path &file) noexcept;
+
+} // namespace adapter::map_data
+
+#endif //NINJACLOWN_ADAPTER_MAP_GENERATOR_HPP
@@ -0,0 +1,140 @@
+#include <array>
+#include <fstream>
+#include <system_error>
+
+#include "adapter/save_state.hpp"
+#include "model/world.hpp"
+#include "utils/binary_stream.hpp"
+
+namespace {
+constexpr std::array<char, 8> magic{'N', 'C', 'S', 'A', 'V', 'E', '\0', '\0'};
+constexpr std::uint32_t format_version    = 2;
+constexpr std::uint32_t endianness_marker = 0x01020304;
+
+struct header {
+	std::string_view map_path;
+	std::uint64_t map_hash;
+	std::size_t map_width;
+	std::size_t map_height;
+};
+
+// reads the header, up to the map dimensions included
+std::optional<header> read_header(utils::binary_reader &in) noexcept {
+	std::array<char, 8> file_magic{};
+	std::uint32_t version{};
+	std::uint32_t endianness{};
+	header header{};
+	in.read(file_magic);
+	in.read(version);
+	in.read(endianness);
+	header.map_path = in.read_string();
+	in.read(header.map_hash);
+	in.read_size(header.map_width);
+	in.read_size(header.map_height);
+	if (!in.ok() || file_magic != magic || version != format_version || endianness != endianness_marker) {
+		return {};
+	}
+	return header;
+}
+} // namespace
+
+bool adapter::save_state::write(const std::filesystem::path &file, const map_info &map, const model::world &world,
+                                const std::vector<model::grid_point> &changed_cells,
+                                const std::vector<std::size_t> &changed_entities) noexcept {
+	try {
+		std::error_code ec;
+		std::filesystem::create_directories(file.parent_path(), ec);
+
+		// written next to the target then renamed, for a failed save not to destroy the previous one
+		std::filesystem::path temporary = file;
+		temporary += ".tmp";
+		{
+			std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+			utils::binary_writer out{stream};
+			out.write(magic);
+			out.write(format_version);
+			out.write(endianness_marker);
+			out.write(map.path.generic_string());
+			out.write(map.hash);
+			out.write_size(world.map.width());
+			out.write_size(world.map.height());
+
+			world.save(out);
+
+			out.write_size(changed_cells.size());
+			for (const model::grid_point &cell : changed_cells) {
+				out.write_size(cell.x);
+				out.write_size(cell.y);
+			}
+			out.write_size(changed_entities.size());
+			for (std::size_t entity : changed_entities) {
+				out.write_size(entity);
+			}
+
+			if (!out.flush()) {
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporary, file, ec);
+		return !ec;
+	}
+	catch (const std::exception &) {
+		return false;
+	}
+}
+
+std::optional<adapter::save_state::map_info> adapter::save_state::map_of(std::string_view bytes) noexcept {
+	utils::binary_reader in{bytes};
+	std::optional<header> header = read_header(in);
+	if (!header) {
+		return {};
+	}
+	try {
+		return map_info{std::filesystem::path{header->map_path}, header->map_hash, header->map_width, header->map_height};
+	}
+	catch (const std::exception &) {
+		return {};
+	}
+}
+
+std::optional<adapter::save_state::changes> adapter::save_state::read(std::string_view bytes, model::world &world) noexcept {
+	try {
+		utils::binary_reader in{bytes};
+		std::optional<header> header = read_header(in);
+		if (!header || !world.load(in) || world.map.width() != header->map_width || world.map.height() != header->map_height) {
+			return {};
+		}
+
+		changes changes;
+		std::size_t count{};
+		in.read_size(count);
+		for (std::size_t i = 0; i < count && in.ok(); ++i) {
+			model::grid_point cell{};
+			in.read_size(cell.x);
+			in.read_size(cell.y);
+			if (cell.x >= world.map.width() || cell.y >= world.map.height()) {
+				return {};
+			}
+			changes.cells.push_back(cell);
+		}
+
+		in.read_size(count);
+		for (std::size_t i = 0; i < count && in.ok(); ++i) {
+			std::size_t entity{};
+			in.read_size(entity);
+			if (entity >= model::cst::max_entities) {
+				return {};
+			}
+			changes.entities.push_back(entity);
+		}
+
+		if (!in.ok() || !in.at_end()) {
+			return {};
+		}
+		return changes;
+	}
+	catch (const std::bad_alloc &) {
+		return {};
+	}
+}
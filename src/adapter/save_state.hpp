@@ -0,0 +1,63 @@
+#ifndef NINJACLOWN_ADAPTER_SAVE_STATE_HPP
+#define NINJACLOWN_ADAPTER_SAVE_STATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "model/grid_point.hpp"
+
+namespace model {
+struct world;
+}
+
+/**
+ * Save states: versioned binary snapshots of a running simulation, along with the map they were taken on and the changes
+ * not yet reported to the bot
+ */
+namespace adapter::save_state {
+
+constexpr std::string_view extension = ".ncsave";
+
+/**
+ * Map a save state was taken on. Save states are only loaded on the very map they were saved on.
+ */
+struct map_info {
+	std::filesystem::path path{};
+	std::uint64_t hash{};  //!< utils::fnv1a_64 of the map file
+	std::size_t width{};
+	std::size_t height{};
+};
+
+struct changes {
+	std::vector<model::grid_point> cells{};
+	std::vector<std::size_t> entities{};
+};
+
+/**
+ * Streams the state of `world` to `file`
+ * @param map path and hash of the map file the world was loaded from. Dimensions are taken from `world`.
+ */
+[[nodiscard]] bool write(const std::filesystem::path &file, const map_info &map, const model::world &world,
+                         const std::vector<model::grid_point> &changed_cells, const std::vector<std::size_t> &changed_entities) noexcept;
+
+/**
+ * @param bytes content of a save state file
+ * @return the map the save state was taken on, or an empty optional if `bytes` is not a save state of the current version
+ */
+[[nodiscard]] std::optional<map_info> map_of(std::string_view bytes) noexcept;
+
+/**
+ * Replaces the state of `world` by the one held by `bytes`. Only the model is affected: save states can be loaded without a
+ * view, eg: as benchmark fixtures.
+ * @return the changes that were not reported to the bot yet, or an empty optional if `bytes` is not a valid save state, or if
+ * the saved world does not have the dimensions of the map recorded in its header
+ */
+[[nodiscard]] std::optional<changes> read(std::string_view bytes, model::world &world) noexcept;
+
+} // namespace adapter::save_state
+
+#endif //NINJACLOWN_ADAPTER_SAVE_STATE_HPP
@@ -8,6 +8,7 @@
 #include "model/model.hpp"
 #include "state_holder.hpp"
 #include "utils/logging.hpp"
+#include "utils/profiler.hpp"
 
 using fmt::literals::operator""_a;
 
@@ -68,6 +69,7 @@ ffi::operator ninja_api::nnj_api() noexcept {
 }
 
 void NINJACLOWN_CALLCONV ffi::log(void *ninja_data, ninja_api::nnj_log_level level, const char *text) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::log");
 	// Sanity check
 	static_assert(ninja_api::LL_TRACE == static_cast<ninja_api::nnj_log_level>(adapter::bot_log_level::BTRACE));
 	static_assert(ninja_api::LL_DEBUG == static_cast<ninja_api::nnj_log_level>(adapter::bot_log_level::BDEBUG));
@@ -83,19 +85,23 @@ void NINJACLOWN_CALLCONV ffi::log(void *ninja_data, ninja_api::nnj_log_level lev
 }
 
 size_t NINJACLOWN_CALLCONV ffi::map_width(void *ninja_data) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::map_width");
 	return get_world(ninja_data)->map.width();
 }
 
 size_t NINJACLOWN_CALLCONV ffi::map_height(void *ninja_data) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::map_height");
 	return get_world(ninja_data)->map.height();
 }
 
 ninja_api::nnj_cell_pos NINJACLOWN_CALLCONV ffi::target_position(void *ninja_data) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::target_position");
 	model::grid_point &target = get_world(ninja_data)->target_tile;
 	return ninja_api::nnj_cell_pos { target.x, target.y };
 }
 
 void NINJACLOWN_CALLCONV ffi::map_scan(void *ninja_data, ninja_api::nnj_cell *map_view) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::map_scan");
 	model::world *world = get_world(ninja_data);
 	model::grid &grid = world->map;
 	for (const auto &cell : grid.subgrid({0, 0}, {grid.width(), grid.height()})) {
@@ -109,6 +115,7 @@ void NINJACLOWN_CALLCONV ffi::map_scan(void *ninja_data, ninja_api::nnj_cell *ma
 
 size_t NINJACLOWN_CALLCONV ffi::map_update(void *ninja_data, ninja_api::nnj_cell *map_view, ninja_api::nnj_cell_pos *changed_cells,
                                            size_t changed_size) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::map_update");
 	adapter::adapter *adapter = get_adapter(ninja_data);
 	model::world *world       = get_world(ninja_data);
 	model::grid &grid       = world->map;
@@ -135,10 +142,12 @@ size_t NINJACLOWN_CALLCONV ffi::map_update(void *ninja_data, ninja_api::nnj_cell
 }
 
 size_t NINJACLOWN_CALLCONV ffi::max_entities() {
+	NINJACLOWN_PROFILE_SCOPE("ffi::max_entities");
 	return model::cst::max_entities;
 }
 
 void NINJACLOWN_CALLCONV ffi::entities_scan(void *ninja_data, ninja_api::nnj_entity *entities) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::entities_scan");
 	model::world *world = get_world(ninja_data);
 
 	for (size_t i = 0; i < model::cst::max_entities; ++i) {
@@ -148,6 +157,7 @@ void NINJACLOWN_CALLCONV ffi::entities_scan(void *ninja_data, ninja_api::nnj_ent
 }
 
 size_t NINJACLOWN_CALLCONV ffi::entities_update(void *ninja_data, ninja_api::nnj_entity *entities) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::entities_update");
 	adapter::adapter *adapter = get_adapter(ninja_data);
 	model::world *world       = get_world(ninja_data);
 
@@ -166,6 +176,7 @@ size_t NINJACLOWN_CALLCONV ffi::entities_update(void *ninja_data, ninja_api::nnj
 	}
 
 void NINJACLOWN_CALLCONV ffi::commit_decisions(void *ninja_data, ninja_api::nnj_decision_commit const *commits, size_t num_commits) {
+	NINJACLOWN_PROFILE_SCOPE("ffi::commit_decisions");
 	model::world *world = get_world(ninja_data);
 	for (size_t i = 0; i < num_commits; ++i) {
 		ninja_api::nnj_decision_commit const &commit = commits[i]; // NOLINT
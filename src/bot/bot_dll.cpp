@@ -31,23 +31,23 @@ bool bot::bot_dll::load(std::string &&dll_path) noexcept {
 }
 
 bool bot::bot_dll::reload() noexcept {
-	const auto& res = utils::resource_manager::instance();
+	const auto res = utils::resource_manager::instance();
 
 	m_good = false;
 	reset();
 
 	if (!m_dll_path) {
-		spdlog::error(res.log_for("bot_dll.reload.no_path"));
+		spdlog::error(res->log_for("bot_dll.reload.no_path"));
 		return false;
 	}
 
 	if (!m_dll.load(*m_dll_path)) {
-		spdlog::error(res.log_for("bot_dll.load.failed"), "file"_a = *m_dll_path, "error"_a = m_dll.error());
+		spdlog::error(res->log_for("bot_dll.load.failed"), "file"_a = *m_dll_path, "error"_a = m_dll.error());
 		return false;
 	}
 
 	if (!load_all_api_functions()) {
-		spdlog::error(res.log_for("bot_dll.load.bad_abi"), "file"_a = *m_dll_path);
+		spdlog::error(res->log_for("bot_dll.load.bad_abi"), "file"_a = *m_dll_path);
 		return false;
 	}
 
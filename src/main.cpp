@@ -4,14 +4,20 @@
 #include <spdlog/spdlog.h>
 
 #include "state_holder.hpp"
+#include "utils/startup_timings.hpp"
 
 int main() {
+	utils::startup::begin();
 	spdlog::default_logger()->set_level(spdlog::level::trace);
 	// TODO: ajouter un logger à spdlog qui fait des popups pour les erreurs
 
-	state::holder game{"resources/autorun.ncs"};
-	game.run();
-	game.wait();
+	{
+		state::holder game{"resources/autorun.ncs"};
+		game.run();
+		game.wait();
+	}
+
+	spdlog::shutdown(); // flushes the asynchronous logger
 
 	return 0;
 }
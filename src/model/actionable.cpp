@@ -24,17 +24,23 @@ void behaviours_namespace::gate(const instance_data &data, const argument_type &
 			arg.world.map[data.pos.x][data.pos.y].type = cell_type::GROUND;
 			arg.adapter.open_gate(adapter::model_handle{data.handle, adapter::model_handle::ACTIONABLE});
 			arg.adapter.update_map(data.pos, cell_type::GROUND);
+			arg.world.ai.invalidate_distances();
 			break;
 		case cell_type::GROUND:
 			utils::log::info("actionable.gate.close", "x"_a = data.pos.x, "y"_a = data.pos.y);
 			arg.adapter.close_gate(adapter::model_handle{data.handle, adapter::model_handle::ACTIONABLE});
 			arg.world.map[data.pos.x][data.pos.y].type = cell_type::WALL;
 			arg.adapter.update_map(data.pos, cell_type::WALL);
+			arg.world.ai.invalidate_distances();
 			break;
 	}
 }
 
-void behaviours_namespace::autoshooter(const instance_data &data, const argument_type &) noexcept {
-	// TODO
-	assert(false && "autoshooter behaviour is not implemented");
+void behaviours_namespace::autoshooter(const instance_data &data, const argument_type &arg) noexcept {
+	if (arg.world.projectiles.toggle_shooter(data.handle, data.pos, data.angle, data.firing_rate)) {
+		utils::log::info("actionable.autoshooter.start", "x"_a = data.pos.x, "y"_a = data.pos.y);
+	}
+	else {
+		utils::log::info("actionable.autoshooter.stop", "x"_a = data.pos.x, "y"_a = data.pos.y);
+	}
 }
@@ -8,6 +8,7 @@
 #include <optional>
 #include <variant>
 
+#include "model/math.hpp"
 #include "model/types.hpp"
 #include "model/vec2.hpp"
 #include "utils/universal_constants.hpp"
@@ -60,30 +61,42 @@ struct hitbox {
 
 	[[nodiscard]] vec2 top_left() const {
 		constexpr float top_left_angle = 3 * uni::math::pi_4<float>;
-		float hypot                    = std::hypot(half.x, half.y);
+		float hypot                    = math::hypot(half.x, half.y);
 		float angle                    = top_left_angle + rad;
-		return vec2{hypot * std::cos(angle) + center.x, hypot * std::sin(angle) + center.y};
+		float sin_angle{0.f};
+		float cos_angle{0.f};
+		math::sincos(angle, sin_angle, cos_angle);
+		return vec2{hypot * cos_angle + center.x, hypot * sin_angle + center.y};
 	}
 
 	[[nodiscard]] vec2 top_right() const {
 		constexpr float top_right_angle = uni::math::pi_4<float>;
-		float hypot                     = std::hypot(half.x, half.y);
+		float hypot                     = math::hypot(half.x, half.y);
 		float angle                     = top_right_angle + rad;
-		return vec2{hypot * std::cos(angle) + center.x, hypot * std::sin(angle) + center.y};
+		float sin_angle{0.f};
+		float cos_angle{0.f};
+		math::sincos(angle, sin_angle, cos_angle);
+		return vec2{hypot * cos_angle + center.x, hypot * sin_angle + center.y};
 	}
 
 	[[nodiscard]] vec2 bottom_left() const {
 		constexpr float bottom_left_angle = -3 * uni::math::pi_4<float>;
-		float hypot                       = std::hypot(half.x, half.y);
+		float hypot                       = math::hypot(half.x, half.y);
 		float angle                       = bottom_left_angle + rad;
-		return vec2{hypot * std::cos(angle) + center.x, hypot * std::sin(angle) + center.y};
+		float sin_angle{0.f};
+		float cos_angle{0.f};
+		math::sincos(angle, sin_angle, cos_angle);
+		return vec2{hypot * cos_angle + center.x, hypot * sin_angle + center.y};
 	}
 
 	[[nodiscard]] vec2 bottom_right() const {
 		constexpr float bottom_right_angle = -uni::math::pi_4<float>;
-		float hypot                        = std::hypot(half.x, half.y);
+		float hypot                        = math::hypot(half.x, half.y);
 		float angle                        = bottom_right_angle + rad;
-		return vec2{hypot * std::cos(angle) + center.x, hypot * std::sin(angle) + center.y};
+		float sin_angle{0.f};
+		float cos_angle{0.f};
+		math::sincos(angle, sin_angle, cos_angle);
+		return vec2{hypot * cos_angle + center.x, hypot * sin_angle + center.y};
 	}
 
 	[[nodiscard]] float half_width() const {
@@ -5,7 +5,12 @@
 #include <iterator>
 #include <model/world.hpp>
 
+#include "utils/binary_stream.hpp"
+#include "utils/profiler.hpp"
+
 void model::event_queue::update(model::world &world, adapter::adapter &adapter) {
+	NINJACLOWN_PROFILE_SCOPE("event_queue::update");
+
 	// This assume that our `std::deque` is ordered by `instant`. See `model::event_queue::add_event`.
 	auto found_at = std::find_if(m_events.begin(), m_events.end(), [this](const event &ev) {
 		return ev.instant <= m_tick;
@@ -13,6 +18,7 @@ void model::event_queue::update(model::world &world, adapter::adapter &adapter)
 	std::vector<event> to_fire;
 	std::move(found_at, m_events.end(), std::back_inserter(to_fire));
 	m_events.erase(found_at, m_events.end());
+	world.last_tick_stats.events_fired += static_cast<unsigned int>(to_fire.size());
 
 	for (auto ev : to_fire) {
 		world.fire_activator(adapter, ev.handle, ev.reason);
@@ -39,3 +45,34 @@ void model::event_queue::clear_for_handle(handle_t activator_handle) {
 	                              }),
 	               m_events.end());
 }
+
+void model::event_queue::save(utils::binary_writer &out) const {
+	out.write(m_tick);
+	out.write_size(m_events.size());
+	for (const event &ev : m_events) {
+		out.write_size(ev.handle);
+		out.write(ev.instant);
+		out.write(static_cast<std::uint8_t>(ev.reason));
+	}
+}
+
+bool model::event_queue::load(utils::binary_reader &in, std::size_t activator_count) {
+	std::size_t count{};
+	in.read(m_tick);
+	in.read_size(count);
+
+	m_events.clear();
+	for (std::size_t i = 0; i < count && in.ok(); ++i) {
+		std::size_t handle{};
+		tick_t instant{};
+		event_reason reason{};
+		in.read_size(handle);
+		in.read(instant);
+		in.read_enum<event_reason, std::uint8_t>(reason, event_reason::DELAY);
+		if (handle >= activator_count || (!m_events.empty() && m_events.back().instant < instant)) {
+			return in.fail();
+		}
+		m_events.emplace_back(handle, instant, reason);
+	}
+	return in.ok();
+}
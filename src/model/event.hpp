@@ -9,6 +9,11 @@ namespace adapter {
 class adapter;
 }
 
+namespace utils {
+class binary_writer;
+class binary_reader;
+} // namespace utils
+
 namespace model {
 
 struct world;
@@ -38,6 +43,19 @@ public:
 	void add_event(handle_t, tick_t delay, event_reason);
 	/// Unregister all events related to a specific activator
 	void clear_for_handle(handle_t);
+	/// Writes the pending events and the tick counter
+	void save(utils::binary_writer &) const;
+	/// Reads what `save` wrote, `activator_count` being the amount of activators of the world
+	[[nodiscard]] bool load(utils::binary_reader &, std::size_t activator_count);
+
+	[[nodiscard]] tick_t tick() const noexcept {
+		return m_tick;
+	}
+
+	/// Pending events, latest first
+	[[nodiscard]] const std::deque<event> &events() const noexcept {
+		return m_events;
+	}
 
 private:
 	tick_t m_tick{};
@@ -0,0 +1,147 @@
+#ifndef NINJACLOWN_MODEL_MATH_HPP
+#define NINJACLOWN_MODEL_MATH_HPP
+
+#include <cmath> // sqrt
+
+#include "utils/universal_constants.hpp"
+
+/**
+ * Floating point functions used by the model, computed with basic arithmetic only (+, -, *, / and sqrt, all of them
+ * correctly rounded by IEEE 754) so that results do not depend on the libm of the toolchain. This only holds as long as
+ * the compiler does not fuse or reorder operations: floating point contraction is disabled in cmake/config.cmake.
+ *
+ * Error bounds (measured in tests/math.cpp, relative to the double precision libm):
+ *   - sin, cos : 1.5e-7 absolute, for |x| <= 4096
+ *   - atan2    : 4e-7 absolute
+ *   - hypot    : 2e-7 relative (no overflow protection: inputs are expected to be map coordinates)
+ */
+namespace model::math {
+
+namespace details {
+	// pi/2 split in three floats for Cody-Waite range reduction: q * pi_2_a and q * pi_2_b are exact for |q| < 4096
+	constexpr float pi_2_a = 1.5703125f;
+	constexpr float pi_2_b = 4.838705062866211e-4f;
+	constexpr float pi_2_c = -4.371138828673793e-8f;
+
+	// minimax polynomials on [-pi/4 ; pi/4] (cephes)
+	constexpr float sin_poly(float r) noexcept {
+		const float r2 = r * r;
+		return r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+	}
+
+	constexpr float cos_poly(float r) noexcept {
+		const float r2 = r * r;
+		return 1.f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+	}
+
+	// reduces x to r in [-pi/4 ; pi/4] so that x = quadrant * pi/2 + r
+	constexpr float reduce(float x, int &quadrant) noexcept {
+		const float q = x * (2.f / uni::math::pi<float>);
+		quadrant      = static_cast<int>(q >= 0.f ? q + 0.5f : q - 0.5f);
+		const auto qf = static_cast<float>(quadrant);
+		return ((x - qf * pi_2_a) - qf * pi_2_b) - qf * pi_2_c;
+	}
+
+	// atan on [0 ; 1] (cephes)
+	constexpr float atan_unit(float x) noexcept {
+		constexpr float tan_pi_8 = 0.4142135623730950f;
+		float offset             = 0.f;
+		if (x > tan_pi_8) {
+			offset = uni::math::pi_4<float>;
+			x      = (x - 1.f) / (x + 1.f);
+		}
+		const float z = x * x;
+		return offset + (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * x + x;
+	}
+} // namespace details
+
+constexpr float sin(float x) noexcept {
+	int quadrant{0};
+	const float r = details::reduce(x, quadrant);
+	switch (quadrant & 3) {
+		case 0:
+			return details::sin_poly(r);
+		case 1:
+			return details::cos_poly(r);
+		case 2:
+			return -details::sin_poly(r);
+		default:
+			return -details::cos_poly(r);
+	}
+}
+
+constexpr float cos(float x) noexcept {
+	int quadrant{0};
+	const float r = details::reduce(x, quadrant);
+	switch (quadrant & 3) {
+		case 0:
+			return details::cos_poly(r);
+		case 1:
+			return -details::sin_poly(r);
+		case 2:
+			return -details::cos_poly(r);
+		default:
+			return details::sin_poly(r);
+	}
+}
+
+/**
+ * Computes both sin(x) and cos(x) with a single range reduction
+ */
+constexpr void sincos(float x, float &sin_x, float &cos_x) noexcept {
+	int quadrant{0};
+	const float r = details::reduce(x, quadrant);
+	const float s = details::sin_poly(r);
+	const float c = details::cos_poly(r);
+	switch (quadrant & 3) {
+		case 0:
+			sin_x = s;
+			cos_x = c;
+			break;
+		case 1:
+			sin_x = c;
+			cos_x = -s;
+			break;
+		case 2:
+			sin_x = -s;
+			cos_x = -c;
+			break;
+		default:
+			sin_x = -c;
+			cos_x = s;
+			break;
+	}
+}
+
+/**
+ * Same conventions as std::atan2 (result in [-pi ; pi], atan2(0, 0) == 0), signed zeroes aside
+ */
+constexpr float atan2(float y, float x) noexcept {
+	const float abs_x = x < 0.f ? -x : x;
+	const float abs_y = y < 0.f ? -y : y;
+	if (abs_x == 0.f && abs_y == 0.f) {
+		return x < 0.f ? uni::math::pi<float> : 0.f;
+	}
+
+	float angle = abs_y <= abs_x ? details::atan_unit(abs_y / abs_x) : uni::math::pi_2<float> - details::atan_unit(abs_x / abs_y);
+	if (x < 0.f) {
+		angle = uni::math::pi<float> - angle;
+	}
+	return y < 0.f ? -angle : angle;
+}
+
+inline float hypot(float x, float y) noexcept {
+	return std::sqrt(x * x + y * y);
+}
+
+/**
+ * Speed multiplier for a movement at angle `r` (radians) from the facing direction, 1.f-ish when moving forward
+ */
+constexpr float slowdown_factor(float r) noexcept {
+	const float cos_11r = cos(1.1f * r);                                                   // NOLINT
+	return -(0.3f * r * r) / 2 - 0.1f * cos_11r * cos_11r + 1.1f - 0.03f * r * r * cos(r); // NOLINT
+}
+
+} // namespace model::math
+
+#endif //NINJACLOWN_MODEL_MATH_HPP
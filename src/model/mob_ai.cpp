@@ -0,0 +1,223 @@
+#include <array>
+#include <cmath>
+#include <optional>
+
+#include "model/math.hpp"
+#include "model/mob_ai.hpp"
+#include "model/movement.hpp"
+#include "model/world.hpp"
+#include "utils/profiler.hpp"
+
+namespace {
+// mobs stop moving forward while turning more than this
+constexpr float max_walking_turn = uni::math::pi_4<float>;
+
+// how far in front of its hitbox a patrolling mob looks for obstacles
+constexpr float patrol_lookahead = 0.3f;
+
+std::optional<model::grid_point> cell_of(const model::grid &map, const model::vec2 &pos) noexcept {
+	if (pos.x < 0.f || pos.y < 0.f) {
+		return {};
+	}
+	model::grid_point cell{static_cast<std::size_t>(pos.x / model::cst::cell_width), static_cast<std::size_t>(pos.y / model::cst::cell_height)};
+	if (cell.x >= map.width() || cell.y >= map.height()) {
+		return {};
+	}
+	return cell;
+}
+
+bool walkable(const model::grid &map, const model::vec2 &pos) noexcept {
+	std::optional<model::grid_point> cell = cell_of(map, pos);
+	return cell && map[cell->x][cell->y].type == model::cell_type::GROUND;
+}
+
+model::component::decision walk_toward(const model::component::hitbox &hitbox, const model::component::properties &properties,
+                                       const model::vec2 &target) noexcept {
+	const float desired = model::math::atan2(-(target.y - hitbox.center.y), target.x - hitbox.center.x);
+	const float rotation = model::wrap_angle(desired - hitbox.rad);
+	const float forward  = std::abs(rotation) < max_walking_turn ? properties.move_speed : 0.f;
+	return ninja_api::nnj_movement_request{rotation, forward, 0.f};
+}
+} // namespace
+
+void model::mob_ai::think(world &world) {
+	NINJACLOWN_PROFILE_SCOPE("mob_ai::think");
+	m_patrols.clear();
+	m_aggressives.clear();
+	m_players.clear();
+	m_player_cells.clear();
+
+	auto &components = world.components;
+	for (handle_t handle = 0; handle < cst::max_entities; ++handle) {
+		if (!components.hitbox[handle]) {
+			continue;
+		}
+
+		switch (components.metadata[handle].kind) {
+			case ninja_api::nnj_entity_kind::EK_PATROL:
+				m_patrols.push_back(handle);
+				break;
+			case ninja_api::nnj_entity_kind::EK_AGGRESSIVE:
+				m_aggressives.push_back(handle);
+				break;
+			case ninja_api::nnj_entity_kind::EK_DLL:
+				if (auto cell = cell_of(world.map, components.hitbox[handle]->center)) {
+					m_players.push_back(handle);
+					m_player_cells.push_back(*cell);
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	for (handle_t handle : m_patrols) {
+		if (components.state[handle].preparing_action) {
+			continue;
+		}
+
+		const component::hitbox &hitbox         = *components.hitbox[handle];
+		const component::properties &properties = components.properties[handle];
+
+		float sin_rad{0.f};
+		float cos_rad{0.f};
+		math::sincos(hitbox.rad, sin_rad, cos_rad);
+		const float distance = math::hypot(hitbox.half.x, hitbox.half.y) + patrol_lookahead;
+		const vec2 ahead{hitbox.center.x + cos_rad * distance, hitbox.center.y - sin_rad * distance};
+
+		if (walkable(world.map, ahead)) {
+			components.decision[handle] = ninja_api::nnj_movement_request{0.f, properties.move_speed, 0.f};
+		}
+		else {
+			components.decision[handle] = ninja_api::nnj_movement_request{properties.rotation_speed, 0.f, 0.f};
+		}
+	}
+
+	if (m_aggressives.empty() || m_players.empty()) {
+		return;
+	}
+	update_distances(world);
+
+	for (handle_t handle : m_aggressives) {
+		// let attacks being prepared complete
+		if (components.state[handle].preparing_action) {
+			continue;
+		}
+
+		const component::hitbox &hitbox         = *components.hitbox[handle];
+		const component::properties &properties = components.properties[handle];
+
+		handle_t closest_player = m_players.front();
+		float closest_distance  = hitbox.center.to(components.hitbox[closest_player]->center).norm();
+		for (handle_t player : m_players) {
+			const float distance = hitbox.center.to(components.hitbox[player]->center).norm();
+			if (distance < closest_distance) {
+				closest_player   = player;
+				closest_distance = distance;
+			}
+		}
+
+		if (closest_distance <= properties.attack_range) {
+			components.decision[handle] = ninja_api::nnj_attack_request{closest_player};
+			continue;
+		}
+
+		std::optional<grid_point> cell = cell_of(world.map, hitbox.center);
+		if (!cell || distance_at(cell->x, cell->y) == unreachable) {
+			continue;
+		}
+
+		vec2 target = components.hitbox[closest_player]->center;
+		if (distance_t current = distance_at(cell->x, cell->y); current != 0) {
+			// neighbour closest to a player, first one wins on ties
+			const std::array<grid_point, 4> neighbours{
+			  {{cell->x + 1, cell->y}, {cell->x - 1, cell->y}, {cell->x, cell->y + 1}, {cell->x, cell->y - 1}}};
+			for (const grid_point &neighbour : neighbours) {
+				if (neighbour.x < world.map.width() && neighbour.y < world.map.height() && distance_at(neighbour.x, neighbour.y) < current) {
+					current = distance_at(neighbour.x, neighbour.y);
+					// center of the cell, so that mobs walk in the middle of corridors
+					target = vec2{static_cast<float>(neighbour.x) + cst::cell_width / 2,
+					              static_cast<float>(neighbour.y) + cst::cell_height / 2};
+				}
+			}
+		}
+
+		components.decision[handle] = walk_toward(hitbox, properties, target);
+	}
+}
+
+void model::mob_ai::reset() noexcept {
+	m_distances.clear();
+	m_bfs_queue.clear();
+	m_bfs_head = 0;
+	m_last_player_cells.clear();
+	m_width           = 0;
+	m_distances_valid = false;
+}
+
+void model::mob_ai::update_distances(const world &world) {
+	const grid &map = world.map;
+	if (!m_distances_valid || m_width != map.width() || m_distances.size() != map.width() * map.height()
+	    || m_last_player_cells != m_player_cells) {
+		NINJACLOWN_PROFILE_SCOPE("mob_ai::reset_distances");
+		if (m_width != map.width() || m_distances.size() != map.width() * map.height()) {
+			m_width = map.width();
+			m_distances.assign(map.width() * map.height(), unreachable);
+		}
+		else {
+			// only the cells reached by the last search hold a distance
+			for (const grid_point &cell : m_bfs_queue) {
+				m_distances[cell.x + cell.y * m_width] = unreachable;
+			}
+		}
+		m_last_player_cells = m_player_cells;
+		m_distances_valid   = true;
+
+		// breadth first search from every player at once, through ground cells
+		m_bfs_queue.clear();
+		m_bfs_head = 0;
+		for (const grid_point &cell : m_player_cells) {
+			if (m_distances[cell.x + cell.y * m_width] == unreachable) {
+				m_distances[cell.x + cell.y * m_width] = 0;
+				m_bfs_queue.push_back(cell);
+			}
+		}
+	}
+
+	for (handle_t handle : m_aggressives) {
+		if (std::optional<grid_point> cell = cell_of(map, world.components.hitbox[handle]->center); cell) {
+			search_until(map, *cell);
+		}
+	}
+}
+
+void model::mob_ai::search_until(const grid &map, grid_point target) {
+	distance_t &target_distance = m_distances[target.x + target.y * m_width];
+	if (target_distance != unreachable || m_bfs_head == m_bfs_queue.size()) {
+		return;
+	}
+	NINJACLOWN_PROFILE_SCOPE("mob_ai::search_until");
+
+	// every cell at distance d is reached before any cell at distance d + 1 is expanded: when the target is reached, its
+	// neighbours that are closer to a player were reached too
+	while (target_distance == unreachable && m_bfs_head < m_bfs_queue.size()) {
+		const grid_point cell = m_bfs_queue[m_bfs_head++];
+		const distance_t next = m_distances[cell.x + cell.y * m_width] + 1;
+		if (next > aggro_range) {
+			continue;
+		}
+
+		const std::array<grid_point, 4> neighbours{{{cell.x + 1, cell.y}, {cell.x - 1, cell.y}, {cell.x, cell.y + 1}, {cell.x, cell.y - 1}}};
+		for (const grid_point &neighbour : neighbours) {
+			// cell.x - 1 wraps around to a huge value when cell.x == 0
+			if (neighbour.x >= map.width() || neighbour.y >= map.height() || map[neighbour.x][neighbour.y].type != cell_type::GROUND) {
+				continue;
+			}
+			distance_t &distance = m_distances[neighbour.x + neighbour.y * m_width];
+			if (distance == unreachable) {
+				distance = next;
+				m_bfs_queue.push_back(neighbour);
+			}
+		}
+	}
+}
@@ -0,0 +1,80 @@
+#ifndef NINJACLOWN_MODEL_MOB_AI_HPP
+#define NINJACLOWN_MODEL_MOB_AI_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "model/grid_point.hpp"
+#include "model/types.hpp"
+
+namespace model {
+
+struct world;
+class grid;
+
+/**
+ * Decisions of the mobs that are not controlled by a dll:
+ *   - EK_HARMLESS   : stands still
+ *   - EK_PATROL     : walks straight ahead, turning when facing a non ground cell
+ *   - EK_AGGRESSIVE : walks toward the closest dll controlled entity and attacks it once in range, if it is within
+ *                     aggro_range cells
+ *
+ * Aggressive mobs share a single distance map (in cells, to the closest dll controlled entity), only rebuilt when one of those
+ * entities changes cell or when the map changes. It is built lazily: the search only goes as far as the farthest aggressive
+ * mob, and never beyond aggro_range.
+ */
+class mob_ai {
+public:
+	using distance_t                      = std::uint32_t;
+	static constexpr distance_t unreachable = std::numeric_limits<distance_t>::max();
+	static constexpr distance_t aggro_range = 32; //!< walking distance, in cells
+
+	/**
+	 * Writes a decision for every built-in mob, in a single pass
+	 */
+	void think(world &world);
+
+	/**
+	 * To be called when cells of the map changed (eg: gates)
+	 */
+	void invalidate_distances() noexcept {
+		m_distances_valid = false;
+	}
+
+	void reset() noexcept;
+
+	/**
+	 * @return the distance to the closest dll controlled entity, or unreachable if the cell was not reached by the search yet
+	 */
+	[[nodiscard]] distance_t distance_at(std::size_t x, std::size_t y) const noexcept {
+		return m_distances[x + y * m_width];
+	}
+
+private:
+	void update_distances(const world &world);
+
+	// carries on the breadth first search until `cell` is reached, or until no cell within aggro_range is left
+	void search_until(const grid &map, grid_point target);
+
+	// built-in mobs, by kind, gathered each tick
+	std::vector<handle_t> m_patrols{};
+	std::vector<handle_t> m_aggressives{};
+
+	// dll controlled entities
+	std::vector<handle_t> m_players{};
+	std::vector<grid_point> m_player_cells{};
+
+	// indexed by x + y * m_width
+	std::vector<distance_t> m_distances{};
+	// every cell reached by the search, in order: cells before m_bfs_head were expanded already
+	std::vector<grid_point> m_bfs_queue{};
+	std::size_t m_bfs_head{0};
+	std::vector<grid_point> m_last_player_cells{};
+	std::size_t m_width{0};
+	bool m_distances_valid{false};
+};
+
+} // namespace model
+
+#endif //NINJACLOWN_MODEL_MOB_AI_HPP
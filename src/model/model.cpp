@@ -1,8 +1,12 @@
+#include <chrono>
+
 #include <spdlog/spdlog.h>
 
 #include "adapter/adapter.hpp"
 #include "model/model.hpp"
 #include "state_holder.hpp"
+#include "utils/perf_monitor.hpp"
+#include "utils/profiler.hpp"
 
 model::model::model(state::holder *state_holder) noexcept
     : m_state_holder{*state_holder} {
@@ -44,9 +48,38 @@ void model::model::bot_end_level() noexcept {
 }
 
 void model::model::bot_think() noexcept {
+	NINJACLOWN_PROFILE_SCOPE("model::bot_think");
 	m_dll.bot_think();
 }
 
+void model::model::tick() noexcept {
+	using utils::perf_monitor;
+	using ms = std::chrono::duration<float, std::milli>;
+
+	const std::uint64_t allocations_before = utils::thread_allocation_count();
+	const auto tick_start                  = std::chrono::steady_clock::now();
+
+	bot_think();
+	const auto think_end = std::chrono::steady_clock::now();
+
+	adapter::adapter &adapter = state::access<model>::adapter(m_state_holder);
+	adapter.clear_cells_changed_since_last_update();
+	adapter.clear_entities_changed_since_last_update();
+	world.update(adapter);
+
+	perf_monitor &perf = perf_monitor::instance();
+	if (perf.is_recording()) {
+		const auto tick_end = std::chrono::steady_clock::now();
+		perf.push(perf_monitor::metric::tick_time, ms{tick_end - tick_start}.count());
+		perf.push(perf_monitor::metric::bot_think_time, ms{think_end - tick_start}.count());
+		perf.push(perf_monitor::metric::collision_tests, static_cast<float>(world.last_tick_stats.collision_tests));
+		perf.push(perf_monitor::metric::events_fired, static_cast<float>(world.last_tick_stats.events_fired));
+		perf.push(perf_monitor::metric::dirty_entities, static_cast<float>(adapter.entities_changed_since_last_update().size()));
+		perf.push(perf_monitor::metric::dirty_cells, static_cast<float>(adapter.cells_changed_since_last_update().size()));
+		perf.push(perf_monitor::metric::heap_allocations, static_cast<float>(utils::thread_allocation_count() - allocations_before));
+	}
+}
+
 void model::model::run() {
 	if (m_state == thread_state::waiting && m_dll) {
 		m_state = thread_state::running;
@@ -83,12 +116,7 @@ void model::model::do_run() noexcept {
 			m_dll_await_load.store(false);
 		}
 
-		bot_think();
-
-		adapter::adapter &adapter = state::access<model>::adapter(m_state_holder);
-		adapter.clear_cells_changed_since_last_update();
-		adapter.clear_entities_changed_since_last_update();
-		world.update(adapter);
+		tick();
 
 		m_lps_limiter.wait();
 
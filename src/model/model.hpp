@@ -31,6 +31,10 @@ public:
 	void bot_start_level(ninja_api::nnj_api api) noexcept;
 	void bot_end_level() noexcept;
 	void bot_think() noexcept;
+	/**
+	 * Lets the bot think, then updates the world once
+	 */
+	void tick() noexcept;
 	void run();
 	void stop() noexcept;
 	bool is_running() noexcept;
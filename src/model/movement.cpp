@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <functional> // greater
+#include <iterator>   // distance
+
+#include "model/math.hpp"
+#include "model/movement.hpp"
+#include "utils/universal_constants.hpp"
+
+namespace {
+// cos(rad + pi/2) == -sin(rad) and sin(rad + pi/2) == cos(rad): a single sincos per entity
+inline void direction(float cos_rad, float sin_rad, float forward, float lateral, float &dx, float &dy) noexcept {
+	dx = cos_rad * forward - sin_rad * lateral;
+	dy = -(sin_rad * forward + cos_rad * lateral);
+}
+
+// maximal speed is achieved by fully moving forward, otherwise entity is slowed down
+inline void cap(float rad, float move_speed, float &dx, float &dy) noexcept {
+	const float norm = model::math::hypot(dx, dy);
+	if (norm != 0.f) {
+		const float max_norm = move_speed * model::math::slowdown_factor(rad + model::math::atan2(dy, dx));
+		if (norm > max_norm) {
+			const float ratio = max_norm / norm;
+			dx *= ratio;
+			dy *= ratio;
+		}
+	}
+}
+} // namespace
+
+float model::wrap_angle(float rad) noexcept {
+	if (rad >= uni::math::pi<float>) {
+		return rad - 2 * uni::math::pi<float>;
+	}
+	if (rad <= -uni::math::pi<float>) {
+		return rad + 2 * uni::math::pi<float>;
+	}
+	return rad;
+}
+
+model::vec2 model::proposed_movement(float rad, float forward_diff, float lateral_diff, float move_speed) noexcept {
+	vec2 movement{0.f, 0.f};
+	float sin_rad{0.f};
+	float cos_rad{0.f};
+	math::sincos(rad, sin_rad, cos_rad);
+	direction(cos_rad, sin_rad, forward_diff, lateral_diff, movement.x, movement.y);
+	cap(rad, move_speed, movement.x, movement.y);
+	return movement;
+}
+
+void model::movement_batch::clear() noexcept {
+	handles.clear();
+	rad.clear();
+	rotation.clear();
+	forward.clear();
+	lateral.clear();
+	move_speed.clear();
+	new_rad.clear();
+	dx.clear();
+	dy.clear();
+}
+
+void model::movement_batch::add(handle_t handle, float rad_, float rotation_, float forward_diff, float lateral_diff, float move_speed_) {
+	handles.push_back(handle);
+	rad.push_back(rad_);
+	rotation.push_back(rotation_);
+	forward.push_back(forward_diff);
+	lateral.push_back(lateral_diff);
+	move_speed.push_back(move_speed_);
+	new_rad.push_back(rad_);
+	dx.push_back(0.f);
+	dy.push_back(0.f);
+}
+
+void model::movement_batch::integrate(std::size_t begin, std::size_t end) noexcept {
+	for (std::size_t i = begin; i < end; ++i) {
+		new_rad[i] = std::abs(rotation[i]) > significant_rotation_epsilon ? wrap_angle(rad[i] + rotation[i]) : rad[i];
+	}
+
+	for (std::size_t i = begin; i < end; ++i) {
+		float sin_rad{0.f};
+		float cos_rad{0.f};
+		math::sincos(new_rad[i], sin_rad, cos_rad);
+		direction(cos_rad, sin_rad, forward[i], lateral[i], dx[i], dy[i]);
+	}
+
+	for (std::size_t i = begin; i < end; ++i) {
+		cap(new_rad[i], move_speed[i], dx[i], dy[i]);
+	}
+}
+
+std::optional<std::size_t> model::movement_batch::slot_of(handle_t handle) const noexcept {
+	auto it = std::lower_bound(handles.begin(), handles.end(), handle, std::greater<>{});
+	if (it == handles.end() || *it != handle) {
+		return {};
+	}
+	return static_cast<std::size_t>(std::distance(handles.begin(), it));
+}
@@ -0,0 +1,74 @@
+#ifndef NINJACLOWN_MODEL_MOVEMENT_HPP
+#define NINJACLOWN_MODEL_MOVEMENT_HPP
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "model/types.hpp"
+#include "model/vec2.hpp"
+
+namespace model {
+
+/**
+ * Rotations smaller than this (radians) are ignored
+ */
+constexpr float significant_rotation_epsilon = 0.001f;
+
+/**
+ * Wraps the angle (radians) back into ]-pi ; pi[, assuming it is at most one turn off
+ */
+[[nodiscard]] float wrap_angle(float rad) noexcept;
+
+/**
+ * Movement an entity facing `rad` would make for the given request, capped by its move speed
+ */
+[[nodiscard]] vec2 proposed_movement(float rad, float forward_diff, float lateral_diff, float move_speed) noexcept;
+
+/**
+ * Every movement requested during a tick, stored as structure of arrays so that poses are integrated in a single pass.
+ * Collisions are not taken into account: proposals are resolved (and possibly rejected) entity by entity afterwards.
+ */
+struct movement_batch {
+	void clear() noexcept;
+
+	/**
+	 * Handles must be added in decreasing order
+	 */
+	void add(handle_t handle, float rad, float rotation, float forward_diff, float lateral_diff, float move_speed);
+
+	/**
+	 * Computes rotations, orientations and movements for every added request
+	 */
+	void integrate() noexcept {
+		integrate(0, size());
+	}
+
+	/**
+	 * Computes rotations, orientations and movements for the requests in slots [begin ; end)
+	 */
+	void integrate(std::size_t begin, std::size_t end) noexcept;
+
+	[[nodiscard]] std::optional<std::size_t> slot_of(handle_t handle) const noexcept;
+
+	[[nodiscard]] std::size_t size() const noexcept {
+		return handles.size();
+	}
+
+	// inputs
+	std::vector<handle_t> handles{};
+	std::vector<float> rad{};
+	std::vector<float> rotation{}; //!< requested rotation, clamped to the entity’s rotation speed
+	std::vector<float> forward{};
+	std::vector<float> lateral{};
+	std::vector<float> move_speed{};
+
+	// outputs
+	std::vector<float> new_rad{}; //!< orientation after rotation (equal to rad if the rotation is not significant)
+	std::vector<float> dx{};
+	std::vector<float> dy{};
+};
+
+} // namespace model
+
+#endif //NINJACLOWN_MODEL_MOVEMENT_HPP
@@ -0,0 +1,42 @@
+#include <utility>
+
+#include "model/occupancy.hpp"
+
+void model::occupancy_index::reset(std::size_t width, std::size_t height) {
+	m_occupants.assign(width * height, 0);
+	m_cells.fill({});
+	m_events.clear();
+	m_width  = width;
+	m_height = height;
+}
+
+bool model::occupancy_index::move(handle_t entity, const vec2 &position) {
+	std::optional<grid_point> cell{};
+	if (position.x >= 0.f && position.y >= 0.f) {
+		const grid_point point{static_cast<std::size_t>(position.x / cst::cell_width), static_cast<std::size_t>(position.y / cst::cell_height)};
+		if (point.x < m_width && point.y < m_height) {
+			cell = point;
+		}
+	}
+
+	if (cell == m_cells[entity]) {
+		return false;
+	}
+
+	remove(entity);
+	if (cell) {
+		m_cells[entity]    = cell;
+		std::uint16_t &occ = m_occupants[cell->x + cell->y * m_width];
+		++occ;
+		m_events.push_back({entity, *cell, event::ENTER, occ});
+	}
+	return true;
+}
+
+void model::occupancy_index::remove(handle_t entity) {
+	if (std::optional<grid_point> cell = std::exchange(m_cells[entity], {})) {
+		std::uint16_t &occ = m_occupants[cell->x + cell->y * m_width];
+		--occ;
+		m_events.push_back({entity, *cell, event::LEAVE, occ});
+	}
+}
@@ -0,0 +1,92 @@
+#ifndef NINJACLOWN_MODEL_OCCUPANCY_HPP
+#define NINJACLOWN_MODEL_OCCUPANCY_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "model/components.hpp"
+#include "model/grid_point.hpp"
+#include "model/types.hpp"
+#include "model/vec2.hpp"
+
+namespace model {
+
+/**
+ * Which cell each entity stands in (the one containing its center), and how many entities stand in each cell.
+ * Updating an entity only costs something when it crosses a cell boundary, in which case leave/enter events are emitted.
+ */
+class occupancy_index {
+public:
+	struct event {
+		enum kind_t {
+			ENTER,
+			LEAVE,
+		};
+
+		handle_t entity;
+		grid_point cell;
+		kind_t kind;
+		std::uint16_t occupants; //!< amount of entities in the cell, after the event
+	};
+
+	/**
+	 * Empties the index, resizing it for a new map
+	 */
+	void reset(std::size_t width, std::size_t height);
+
+	[[nodiscard]] bool matches(std::size_t width, std::size_t height) const noexcept {
+		return width == m_width && height == m_height;
+	}
+
+	/**
+	 * Sets the position of an entity, emitting events if it changed cell (positions outside of the map are in no cell)
+	 * @return true if the entity changed cell
+	 */
+	bool move(handle_t entity, const vec2 &position);
+
+	/**
+	 * Removes an entity from the index (emits a leave event if it was in a cell)
+	 */
+	void remove(handle_t entity);
+
+	[[nodiscard]] std::uint16_t occupants(grid_point cell) const noexcept {
+		return m_occupants[cell.x + cell.y * m_width];
+	}
+
+	[[nodiscard]] std::optional<grid_point> cell_of(handle_t entity) const noexcept {
+		return m_cells[entity];
+	}
+
+	/**
+	 * Events emitted since the last call to clear_events or take_events
+	 */
+	[[nodiscard]] const std::vector<event> &events() const noexcept {
+		return m_events;
+	}
+
+	void clear_events() noexcept {
+		m_events.clear();
+	}
+
+	/**
+	 * Moves the pending events to `out` (previous content of `out` is discarded, its storage is reused). Events emitted
+	 * while handling them are kept for the next call.
+	 */
+	void take_events(std::vector<event> &out) noexcept {
+		out.clear();
+		out.swap(m_events);
+	}
+
+private:
+	std::vector<std::uint16_t> m_occupants{}; //!< indexed by x + y * m_width
+	std::array<std::optional<grid_point>, cst::max_entities> m_cells{};
+	std::vector<event> m_events{};
+	std::size_t m_width{0};
+	std::size_t m_height{0};
+};
+
+} // namespace model
+
+#endif //NINJACLOWN_MODEL_OCCUPANCY_HPP
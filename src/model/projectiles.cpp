@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cmath>
+
+#include "model/components.hpp"
+#include "model/grid.hpp"
+#include "model/math.hpp"
+#include "model/projectiles.hpp"
+#include "utils/binary_stream.hpp"
+#include "utils/profiler.hpp"
+#include "utils/thread_pool.hpp"
+
+namespace {
+// a projectile never moves by more than its radius between two collision tests
+constexpr auto substeps = static_cast<unsigned int>(model::projectile_pool::speed / model::projectile_pool::radius + 0.999f);
+
+// shooters fire from outside of their own cell
+constexpr float shooter_muzzle_distance = 0.75f;
+
+constexpr std::size_t parallel_grain = 256;
+
+bool blocked_by_map(const model::grid &map, float x, float y) noexcept {
+	constexpr float r = model::projectile_pool::radius;
+	if (x - r < 0.f || y - r < 0.f || x + r >= static_cast<float>(map.width()) * model::cst::cell_width
+	    || y + r >= static_cast<float>(map.height()) * model::cst::cell_height) {
+		return true;
+	}
+
+	const auto min_x = static_cast<std::size_t>((x - r) / model::cst::cell_width);
+	const auto max_x = static_cast<std::size_t>((x + r) / model::cst::cell_width);
+	const auto min_y = static_cast<std::size_t>((y - r) / model::cst::cell_height);
+	const auto max_y = static_cast<std::size_t>((y + r) / model::cst::cell_height);
+	for (std::size_t cx = min_x; cx <= max_x; ++cx) {
+		for (std::size_t cy = min_y; cy <= max_y; ++cy) {
+			if (map[cx][cy].type == model::cell_type::GROUND) {
+				continue;
+			}
+			// distance from the center of the circle to the closest point of the cell
+			const float dx = x - std::clamp(x, static_cast<float>(cx) * model::cst::cell_width, static_cast<float>(cx + 1) * model::cst::cell_width);
+			const float dy = y - std::clamp(y, static_cast<float>(cy) * model::cst::cell_height, static_cast<float>(cy + 1) * model::cst::cell_height);
+			if (dx * dx + dy * dy < r * r) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+} // namespace
+
+model::projectile_pool::projectile_pool() {
+	m_x.reserve(capacity);
+	m_y.reserve(capacity);
+	m_vx.reserve(capacity);
+	m_vy.reserve(capacity);
+	m_ticks_left.reserve(capacity);
+	m_source.reserve(capacity);
+	m_outcome.reserve(capacity);
+	m_hit_target.reserve(capacity);
+	m_hits.reserve(capacity);
+}
+
+bool model::projectile_pool::spawn(vec2 origin, float rad, handle_t source) noexcept {
+	if (m_x.size() == capacity) {
+		return false;
+	}
+
+	float sin_rad{0.f};
+	float cos_rad{0.f};
+	math::sincos(rad, sin_rad, cos_rad);
+
+	m_x.push_back(origin.x);
+	m_y.push_back(origin.y);
+	m_vx.push_back(cos_rad * speed);
+	m_vy.push_back(-sin_rad * speed);
+	m_ticks_left.push_back(lifetime);
+	m_source.push_back(source);
+	m_outcome.push_back(outcome::flying);
+	m_hit_target.push_back(no_source);
+	return true;
+}
+
+bool model::projectile_pool::toggle_shooter(handle_t actionable, grid_point pos, float rad, unsigned int firing_rate) {
+	auto it = std::find_if(m_shooters.begin(), m_shooters.end(), [actionable](const shooter &s) {
+		return s.actionable == actionable;
+	});
+	if (it != m_shooters.end()) {
+		m_shooters.erase(it);
+		return false;
+	}
+
+	float sin_rad{0.f};
+	float cos_rad{0.f};
+	math::sincos(rad, sin_rad, cos_rad);
+
+	vec2 origin{static_cast<float>(pos.x) + cst::cell_width / 2, static_cast<float>(pos.y) + cst::cell_height / 2};
+	origin.x += cos_rad * shooter_muzzle_distance;
+	origin.y -= sin_rad * shooter_muzzle_distance;
+	m_shooters.push_back({actionable, origin, rad, firing_rate, 0});
+	return true;
+}
+
+void model::projectile_pool::update(const grid &map, const std::vector<projectile_target> &targets) {
+	NINJACLOWN_PROFILE_SCOPE("projectile_pool::update");
+
+	for (shooter &shooter : m_shooters) {
+		if (shooter.ticks_before_shot == 0) {
+			spawn(shooter.origin, shooter.rad);
+			shooter.ticks_before_shot = std::max(shooter.firing_rate, 1u) - 1;
+		}
+		else {
+			--shooter.ticks_before_shot;
+		}
+	}
+
+	utils::thread_pool::instance().parallel_for(size(), parallel_grain, [&](std::size_t begin, std::size_t end) {
+		integrate(begin, end, map, targets);
+	});
+
+	m_hits.clear();
+	for (std::size_t i = 0; i < size(); ++i) {
+		if (m_outcome[i] == outcome::hit) {
+			m_hits.push_back({m_hit_target[i], m_source[i]});
+		}
+	}
+
+	// from the back, so that swapped in projectiles were already looked at
+	for (std::size_t i = size(); (i--) != 0u;) {
+		if (m_outcome[i] != outcome::flying) {
+			remove(i);
+		}
+	}
+}
+
+void model::projectile_pool::integrate(std::size_t begin, std::size_t end, const grid &map,
+                                       const std::vector<projectile_target> &targets) noexcept {
+	for (std::size_t i = begin; i < end; ++i) {
+		const float step_x = m_vx[i] / static_cast<float>(substeps);
+		const float step_y = m_vy[i] / static_cast<float>(substeps);
+
+		m_outcome[i] = outcome::flying;
+		for (unsigned int step = 0; step < substeps && m_outcome[i] == outcome::flying; ++step) {
+			m_x[i] += step_x;
+			m_y[i] += step_y;
+
+			if (blocked_by_map(map, m_x[i], m_y[i])) {
+				m_outcome[i] = outcome::blocked;
+				break;
+			}
+
+			for (const projectile_target &target : targets) {
+				const float dx      = target.center.x - m_x[i];
+				const float dy      = target.center.y - m_y[i];
+				const float contact = target.radius + radius;
+				if (target.handle != m_source[i] && dx * dx + dy * dy < contact * contact) {
+					m_outcome[i]    = outcome::hit;
+					m_hit_target[i] = target.handle;
+					break;
+				}
+			}
+		}
+
+		if (m_outcome[i] == outcome::flying && --m_ticks_left[i] == 0) {
+			m_outcome[i] = outcome::expired;
+		}
+	}
+}
+
+void model::projectile_pool::clear() noexcept {
+	m_x.clear();
+	m_y.clear();
+	m_vx.clear();
+	m_vy.clear();
+	m_ticks_left.clear();
+	m_source.clear();
+	m_outcome.clear();
+	m_hit_target.clear();
+	m_hits.clear();
+	m_shooters.clear();
+}
+
+void model::projectile_pool::remove(std::size_t slot) noexcept {
+	const std::size_t last = size() - 1;
+	m_x[slot]          = m_x[last];
+	m_y[slot]          = m_y[last];
+	m_vx[slot]         = m_vx[last];
+	m_vy[slot]         = m_vy[last];
+	m_ticks_left[slot] = m_ticks_left[last];
+	m_source[slot]     = m_source[last];
+	m_outcome[slot]    = m_outcome[last];
+	m_hit_target[slot] = m_hit_target[last];
+
+	m_x.pop_back();
+	m_y.pop_back();
+	m_vx.pop_back();
+	m_vy.pop_back();
+	m_ticks_left.pop_back();
+	m_source.pop_back();
+	m_outcome.pop_back();
+	m_hit_target.pop_back();
+}
+
+void model::projectile_pool::save(utils::binary_writer &out) const {
+	out.write_size(size());
+	for (std::size_t slot = 0; slot < size(); ++slot) {
+		out.write(m_x[slot]);
+		out.write(m_y[slot]);
+		out.write(m_vx[slot]);
+		out.write(m_vy[slot]);
+		out.write(m_ticks_left[slot]);
+		out.write(static_cast<std::uint64_t>(m_source[slot]));
+	}
+
+	out.write_size(m_shooters.size());
+	for (const shooter &s : m_shooters) {
+		out.write_size(s.actionable);
+		out.write(s.origin.x);
+		out.write(s.origin.y);
+		out.write(s.rad);
+		out.write(s.firing_rate);
+		out.write(s.ticks_before_shot);
+	}
+}
+
+bool model::projectile_pool::load(utils::binary_reader &in, std::size_t actionable_count) {
+	clear();
+
+	std::size_t count{};
+	if (!in.read_size(count) || count > capacity) {
+		return in.fail();
+	}
+	for (std::size_t slot = 0; slot < count && in.ok(); ++slot) {
+		float x{}, y{}, vx{}, vy{};
+		tick_t ticks_left{};
+		std::uint64_t source{};
+		in.read(x);
+		in.read(y);
+		in.read(vx);
+		in.read(vy);
+		in.read(ticks_left);
+		in.read(source);
+		// projectiles fired by autoshooters have no source, others come from an entity
+		if (source != no_source && source >= cst::max_entities) {
+			return in.fail();
+		}
+		m_x.push_back(x);
+		m_y.push_back(y);
+		m_vx.push_back(vx);
+		m_vy.push_back(vy);
+		m_ticks_left.push_back(ticks_left);
+		m_source.push_back(static_cast<handle_t>(source));
+		m_outcome.push_back(outcome::flying);
+		m_hit_target.push_back(no_source);
+	}
+
+	if (!in.read_size(count)) {
+		return false;
+	}
+	for (std::size_t i = 0; i < count && in.ok(); ++i) {
+		std::size_t actionable{};
+		float x{}, y{}, rad{};
+		unsigned int firing_rate{}, ticks_before_shot{};
+		in.read_size(actionable);
+		in.read(x);
+		in.read(y);
+		in.read(rad);
+		in.read(firing_rate);
+		in.read(ticks_before_shot);
+		if (actionable >= actionable_count) {
+			return in.fail();
+		}
+		m_shooters.push_back({actionable, vec2{x, y}, rad, firing_rate, ticks_before_shot});
+	}
+	return in.ok();
+}
@@ -0,0 +1,141 @@
+#ifndef NINJACLOWN_MODEL_PROJECTILES_HPP
+#define NINJACLOWN_MODEL_PROJECTILES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "model/grid_point.hpp"
+#include "model/types.hpp"
+#include "model/vec2.hpp"
+
+namespace utils {
+class binary_writer;
+class binary_reader;
+} // namespace utils
+
+namespace model {
+
+class grid;
+
+/**
+ * Circle used as target by projectiles
+ */
+struct projectile_target {
+	handle_t handle;
+	vec2 center;
+	float radius;
+};
+
+/**
+ * Projectiles in flight, stored as structure of arrays in storage allocated once: spawning and destroying projectiles
+ * never allocates. Also holds the autoshooters currently firing.
+ */
+class projectile_pool {
+public:
+	static constexpr std::size_t capacity = 4096;
+	static constexpr float speed          = 0.5f;  //!< cells per tick
+	static constexpr float radius         = 0.1f;  //!< cells
+	static constexpr tick_t lifetime      = 200; //!< ticks
+	static constexpr handle_t no_source   = std::numeric_limits<handle_t>::max();
+
+	/**
+	 * Projectile that hit an entity during the last update
+	 */
+	struct hit {
+		handle_t target;
+		handle_t source;
+	};
+
+	projectile_pool();
+
+	/**
+	 * Launches a projectile from `origin` toward `rad` (same convention as hitbox::rad). Projectiles never hit their source.
+	 * @return false if the pool is full
+	 */
+	bool spawn(vec2 origin, float rad, handle_t source = no_source) noexcept;
+
+	/**
+	 * Starts (or stops) firing from an autoshooter, a projectile every `firing_rate` ticks starting with the next update.
+	 * Projectiles leave from the side of the autoshooter's cell it is facing.
+	 * @return true if the autoshooter is now firing
+	 */
+	bool toggle_shooter(handle_t actionable, grid_point pos, float rad, unsigned int firing_rate);
+
+	/**
+	 * Fires autoshooters then moves every projectile by one tick, in fixed size steps (swept circle).
+	 * Projectiles are destroyed when reaching a non ground cell, a target, or the end of their lifetime.
+	 * Targets are only read: hits are reported through `hits()`, in a deterministic order.
+	 */
+	void update(const grid &map, const std::vector<projectile_target> &targets);
+
+	void clear() noexcept;
+
+	/**
+	 * Writes the projectiles in flight and the firing autoshooters
+	 */
+	void save(utils::binary_writer &out) const;
+
+	/**
+	 * Reads what `save` wrote, replacing the content of the pool
+	 * @param actionable_count amount of actionables of the world, autoshooters being actionables
+	 */
+	[[nodiscard]] bool load(utils::binary_reader &in, std::size_t actionable_count);
+
+	[[nodiscard]] const std::vector<hit> &hits() const noexcept {
+		return m_hits;
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept {
+		return m_x.size();
+	}
+
+	[[nodiscard]] const std::vector<float> &xs() const noexcept {
+		return m_x;
+	}
+
+	[[nodiscard]] const std::vector<float> &ys() const noexcept {
+		return m_y;
+	}
+
+private:
+	enum class outcome : std::uint8_t {
+		flying,
+		blocked,
+		hit,
+		expired,
+	};
+
+	struct shooter {
+		handle_t actionable;
+		vec2 origin;
+		float rad;
+		unsigned int firing_rate;
+		unsigned int ticks_before_shot;
+	};
+
+	// integrates projectiles in slots [begin ; end)
+	void integrate(std::size_t begin, std::size_t end, const grid &map, const std::vector<projectile_target> &targets) noexcept;
+
+	// swaps slot with the last projectile
+	void remove(std::size_t slot) noexcept;
+
+	std::vector<float> m_x{};
+	std::vector<float> m_y{};
+	std::vector<float> m_vx{};
+	std::vector<float> m_vy{};
+	std::vector<tick_t> m_ticks_left{};
+	std::vector<handle_t> m_source{};
+
+	// results of the last integration
+	std::vector<outcome> m_outcome{};
+	std::vector<handle_t> m_hit_target{};
+	std::vector<hit> m_hits{};
+
+	std::vector<shooter> m_shooters{};
+};
+
+} // namespace model
+
+#endif //NINJACLOWN_MODEL_PROJECTILES_HPP
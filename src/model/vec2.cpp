@@ -1,5 +1,4 @@
-#include <cmath>
-
+#include "model/math.hpp"
 #include "model/vec2.hpp"
 
 model::vec2 model::operator+(const model::vec2 &a, const model::vec2 &b) {
@@ -55,7 +54,7 @@ model::vec2 model::vec2::normal() const noexcept {
 }
 
 float model::vec2::norm() const noexcept {
-	return std::hypot(x, y);
+	return math::hypot(x, y);
 }
 
 model::vec2 model::vec2::to(const model::vec2 &other) const noexcept {
@@ -67,7 +66,7 @@ float model::vec2::prod(const model::vec2 &other) const noexcept {
 }
 
 float model::vec2::atan2() const noexcept {
-	return std::atan2(y, x);
+	return math::atan2(y, x);
 }
 
 std::ostream &operator<<(std::ostream &stream, const model::vec2 &vec) {
@@ -6,20 +6,33 @@
 
 #include "adapter/adapter.hpp"
 #include "model/collision.hpp"
+#include "model/math.hpp"
 #include "model/world.hpp"
+#include "utils/binary_stream.hpp"
+#include "utils/profiler.hpp"
+#include "utils/thread_pool.hpp"
 #include "utils/visitor.hpp"
 
-const float SIGNIFICANT_ROTATION_EPSILON = 0.001f;
-
-float slowdown_factor(float r) {
-	return -(0.3 * r * r) / 2 - 0.1 * std::pow(std::cos(1.1 * r), 2) + 1.1 - 0.03 * r * r * std::cos(r); // NOLINT
-}
+namespace {
+// below this amount of entities per thread, spreading work costs more than it saves
+constexpr std::size_t parallel_grain = 64;
+} // namespace
 
 void model::world::update(adapter::adapter &adapter) {
+	NINJACLOWN_PROFILE_SCOPE("world::update");
+	last_tick_stats = {};
+
+	sync_occupancy();
+	ai.think(*this);
+	evaluate_decisions();
+
+	// applied in a fixed order, whatever the amount of threads used to evaluate decisions
 	for (handle_t handle = cst::max_entities; (handle--) != 0u;) {
 		single_entity_simple_update(adapter, handle);
 	}
 
+	update_projectiles(adapter);
+
 	m_event_queue.update(*this, adapter);
 }
 
@@ -28,6 +41,9 @@ void model::world::reset() {
 	interactions.clear();
 	activators.clear();
 	actionables.clear();
+	projectiles.clear();
+	ai.reset();
+	m_occupancy.reset(0, 0);
 
 	for (unsigned int i = 0; i < cst::max_entities; ++i) {
 		reset_entity(i);
@@ -35,6 +51,8 @@ void model::world::reset() {
 }
 
 void model::world::reset_entity(handle_t handle) {
+	m_occupancy.remove(handle);
+	m_occupancy.clear_events();
 	components.state[handle]      = {};
 	components.metadata[handle]   = {};
 	components.properties[handle] = {};
@@ -43,12 +61,87 @@ void model::world::reset_entity(handle_t handle) {
 	components.hitbox[handle].reset();
 }
 
+void model::world::evaluate_decisions() {
+	NINJACLOWN_PROFILE_SCOPE("world::evaluate_decisions");
+	utils::thread_pool &pool = utils::thread_pool::instance();
+
+	gather_movements();
+	pool.parallel_for(m_movements.size(), parallel_grain, [this](std::size_t begin, std::size_t end) {
+		m_movements.integrate(begin, end);
+	});
+
+	pool.parallel_for(cst::max_entities, parallel_grain, [this](std::size_t begin, std::size_t end) {
+		for (handle_t handle = begin; handle < end; ++handle) {
+			m_action_intents[handle] = evaluate_action(handle);
+		}
+	});
+}
+
+void model::world::gather_movements() {
+	m_movements.clear();
+	for (handle_t handle = cst::max_entities; (handle--) != 0u;) {
+		if (!components.decision[handle] || !components.hitbox[handle]) {
+			continue;
+		}
+
+		if (auto *mov_req = std::get_if<ninja_api::nnj_movement_request>(&*components.decision[handle])) {
+			const component::properties &properties = components.properties[handle];
+			m_movements.add(handle, components.hitbox[handle]->rad,
+			                std::clamp(mov_req->rotation, -properties.rotation_speed, properties.rotation_speed), mov_req->forward_diff,
+			                mov_req->lateral_diff, properties.move_speed);
+		}
+	}
+}
+
+model::world::action_intent model::world::evaluate_action(handle_t handle) const {
+	if (!components.decision[handle] || !components.hitbox[handle]) {
+		return {};
+	}
+
+	const component::hitbox &hitbox         = *components.hitbox[handle];
+	const component::properties &properties = components.properties[handle];
+
+	action_intent intent{};
+	utils::visitor visitor{
+	  [](const ninja_api::nnj_movement_request &) {},
+	  [&](const ninja_api::nnj_activate_request &activate_req) {
+		  const cell &cell = map[activate_req.column][activate_req.line];
+		  if (cell.interaction_handle) {
+			  const interaction &interaction = interactions[*cell.interaction_handle];
+			  if (interaction.kind == interaction_kind::LIGHT_MANUAL || interaction.kind == interaction_kind::HEAVY_MANUAL) {
+				  vec2 cell_center{activate_req.column, activate_req.line};
+				  if (hitbox.center.to(cell_center).norm() <= properties.activate_range) {
+					  intent.action             = {activate_req};
+					  intent.ticks_before_ready = activators[interaction.interactable_handler].activation_difficulty;
+				  }
+			  }
+		  }
+	  },
+	  [&](const ninja_api::nnj_attack_request &attack_req) {
+		  if (components.health[attack_req.target_handle] && components.hitbox[attack_req.target_handle]) {
+			  const component::hitbox &target_hitbox = *components.hitbox[attack_req.target_handle];
+			  if (hitbox.center.to(target_hitbox.center).norm() <= properties.attack_range) {
+				  intent.action             = {attack_req};
+				  intent.ticks_before_ready = properties.attack_delay;
+			  }
+		  }
+	  },
+	  [&](const ninja_api::nnj_throw_request &throw_req) {
+		  intent.action             = {throw_req};
+		  intent.ticks_before_ready = properties.throw_delay;
+	  }};
+
+	std::visit(visitor, *components.decision[handle]);
+	return intent;
+}
+
 void model::world::single_entity_simple_update(adapter::adapter &adapter, handle_t handle) {
 	single_entity_decision_update(adapter, handle);
 	single_entity_action_update(adapter, handle);
 }
 
 void model::world::single_entity_action_update(adapter::adapter &adapter, handle_t handle) {
+	NINJACLOWN_PROFILE_SCOPE("world::single_entity_action_update");
 	if (!components.state[handle].preparing_action || !components.hitbox[handle]) {
 		return;
 	}
@@ -80,17 +173,17 @@ void model::world::single_entity_action_update(adapter::adapter &adapter, handle
 		  if (health[attack_req.target_handle] && components.hitbox[attack_req.target_handle]) {
 			  component::hitbox &target_hitbox = *components.hitbox[attack_req.target_handle];
 			  if (hitbox.center.to(target_hitbox.center).norm() <= components.properties[handle].attack_range) {
-				  health[attack_req.target_handle]->points -= 1;
-				  if (health[attack_req.target_handle]->points == 0) {
-					  reset_entity(attack_req.target_handle);
-					  adapter.hide_entity(
-					    adapter::model_handle{static_cast<handle_t>(attack_req.target_handle), adapter::model_handle::ENTITY});
-				  }
+				  damage_entity(adapter, attack_req.target_handle);
 			  }
 		  }
 	  },
-	  [&](ninja_api::nnj_throw_request &throw_req) {
-
+	  [&](ninja_api::nnj_throw_request & /* throw_req */) {
+		  // thrown forward, from right outside of the thrower’s bounding circle
+		  const float distance = bounding_circle{hitbox}.radius + projectile_pool::radius;
+		  vec2 origin          = hitbox.center;
+		  origin.x += math::cos(hitbox.rad) * distance;
+		  origin.y -= math::sin(hitbox.rad) * distance;
+		  projectiles.spawn(origin, hitbox.rad, handle);
 	  },
 	};
 
@@ -99,7 +192,45 @@ void model::world::single_entity_action_update(adapter::adapter &adapter, handle
 	adapter.mark_entity_as_dirty(handle);
 }
 
+void model::world::update_projectiles(adapter::adapter &adapter) {
+	m_projectile_targets.clear();
+	for (handle_t handle = 0; handle < cst::max_entities; ++handle) {
+		if (components.hitbox[handle] && components.health[handle]) {
+			bounding_circle circle{*components.hitbox[handle]};
+			m_projectile_targets.push_back({handle, circle.center, circle.radius});
+		}
+	}
+
+	const bool had_projectiles = projectiles.size() != 0;
+	projectiles.update(map, m_projectile_targets);
+	for (const projectile_pool::hit &hit : projectiles.hits()) {
+		damage_entity(adapter, hit.target);
+	}
+
+	if (had_projectiles || projectiles.size() != 0) {
+		adapter.update_projectiles(projectiles.xs(), projectiles.ys());
+	}
+}
+
+void model::world::damage_entity(adapter::adapter &adapter, handle_t handle) {
+	auto &health = components.health[handle];
+	if (!health) {
+		// already dead
+		return;
+	}
+
+	health->points -= 1;
+	if (health->points == 0) {
+		reset_entity(handle);
+		adapter.hide_entity(adapter::model_handle{handle, adapter::model_handle::ENTITY});
+	}
+	else {
+		adapter.mark_entity_as_dirty(handle);
+	}
+}
+
 void model::world::single_entity_decision_update(adapter::adapter &adapter, handle_t handle) {
+	NINJACLOWN_PROFILE_SCOPE("world::single_entity_decision_update");
 	if (!components.decision[handle] || !components.hitbox[handle]) {
 		return;
 	}
@@ -115,26 +246,24 @@ void model::world::single_entity_decision_update(adapter::adapter &adapter, hand
 
 	utils::visitor visitor_with_a_very_long_name_for_clang_format{
 	  [&](ninja_api::nnj_movement_request &mov_req) {
-		  float rotation = std::clamp(mov_req.rotation, -properties.rotation_speed, properties.rotation_speed);
-		  if (std::abs(rotation) > SIGNIFICANT_ROTATION_EPSILON) {
+		  // rotations and movements were integrated for every entity at the beginning of the tick, assuming no collision
+		  std::optional<std::size_t> slot = m_movements.slot_of(handle);
+		  float rotation = slot ? m_movements.rotation[*slot]
+		                        : std::clamp(mov_req.rotation, -properties.rotation_speed, properties.rotation_speed);
+		  if (std::abs(rotation) > significant_rotation_epsilon) {
 			  rotate_entity(adapter, handle, rotation);
 		  }
 
-		  float dx = std::cos(components.hitbox[handle]->rad) * mov_req.forward_diff
-		             + std::cos(components.hitbox[handle]->rad + uni::math::pi_2<float>) * mov_req.lateral_diff;
-		  float dy = -(std::sin(components.hitbox[handle]->rad) * mov_req.forward_diff
-		               + std::sin(components.hitbox[handle]->rad + uni::math::pi_2<float>) * mov_req.lateral_diff);
-		  vec2 movement{dx, dy};
-
-		  if (movement.norm() != 0) {
-              // maximal speed is achieved by fully moving forward, otherwise entity is slowed down
-              float max_norm = properties.move_speed * slowdown_factor(components.hitbox[handle]->rad + movement.atan2());
-			  if (movement.norm() > max_norm) {
-				  // cap movement vector to max speed
-				  movement.unitify();
-				  movement.x *= max_norm;
-				  movement.y *= max_norm;
-			  }
+		  vec2 movement{0.f, 0.f};
+		  if (slot && m_movements.new_rad[*slot] == hitbox.rad) {
+			  movement = {m_movements.dx[*slot], m_movements.dy[*slot]};
+		  }
+		  else {
+			  // rotation was rejected (or decision changed during the tick): integrate this one again
+			  movement = proposed_movement(hitbox.rad, mov_req.forward_diff, mov_req.lateral_diff, properties.move_speed);
+		  }
+
+		  if (movement.x != 0.f || movement.y != 0.f) {
 			  move_entity(adapter, handle, movement);
 		  }
 
@@ -149,32 +278,10 @@ void model::world::single_entity_decision_update(adapter::adapter &adapter, hand
 			  }
 		  }
 	  },
-	  [&](ninja_api::nnj_activate_request &activate_req) {
-		  const cell &cell = map[activate_req.column][activate_req.line];
-		  if (cell.interaction_handle) {
-			  interaction &interaction = interactions[*cell.interaction_handle];
-			  if (interaction.kind == interaction_kind::LIGHT_MANUAL || interaction.kind == interaction_kind::HEAVY_MANUAL) {
-				  vec2 cell_center{activate_req.column, activate_req.line};
-				  if (hitbox.center.to(cell_center).norm() <= components.properties[handle].activate_range) {
-					  state.preparing_action   = {activate_req};
-					  state.ticks_before_ready = this->activators[interaction.interactable_handler].activation_difficulty;
-				  }
-			  }
-		  }
-	  },
-	  [&](ninja_api::nnj_attack_request &attack_req) {
-		  auto &health = components.health;
-		  if (health[attack_req.target_handle] && components.hitbox[attack_req.target_handle]) {
-			  component::hitbox &target_hitbox = *components.hitbox[attack_req.target_handle];
-			  if (hitbox.center.to(target_hitbox.center).norm() <= components.properties[handle].attack_range) {
-				  state.preparing_action   = {attack_req};
-				  state.ticks_before_ready = components.properties[handle].attack_delay;
-			  }
-		  }
-	  },
-	  [&](ninja_api::nnj_throw_request &throw_req) {
-		  state.preparing_action   = {throw_req};
-		  state.ticks_before_ready = components.properties[handle].throw_delay;
+	  [&](const auto & /* preparable action */) {
+		  // validated during evaluate_decisions
+		  state.preparing_action   = m_action_intents[handle].action;
+		  state.ticks_before_ready = m_action_intents[handle].ticks_before_ready;
 	  }};
 
 	std::visit(visitor_with_a_very_long_name_for_clang_format, *components.decision[handle]);
@@ -198,6 +305,56 @@ void model::world::move_entity(adapter::adapter &adapter, handle_t handle, vec2
 	}
 
 	adapter.move_entity(adapter::model_handle{handle, adapter::model_handle::ENTITY}, hitbox.center.x, hitbox.center.y);
+
+	if (m_occupancy.move(handle, hitbox.center)) {
+		fire_occupancy_events(adapter);
+	}
+}
+
+void model::world::sync_occupancy() {
+	if (m_occupancy.matches(map.width(), map.height())) {
+		return;
+	}
+
+	// new map: entities were placed by the loader, which is not entering a cell
+	m_occupancy.reset(map.width(), map.height());
+	for (handle_t handle = 0; handle < cst::max_entities; ++handle) {
+		if (components.hitbox[handle]) {
+			m_occupancy.move(handle, components.hitbox[handle]->center);
+		}
+	}
+	m_occupancy.clear_events();
+}
+
+void model::world::fire_occupancy_events(adapter::adapter &adapter) {
+	// firing activators may move entities, emitting new events (and calling this function again): the pending events are
+	// taken out of the index before being dispatched
+	std::vector<occupancy_index::event> firing = std::move(m_occupancy_events);
+	m_occupancy.take_events(firing);
+	for (const occupancy_index::event &event : firing) {
+		// only the first entity stepping in triggers the cell
+		if (event.kind != occupancy_index::event::ENTER || event.occupants != 1) {
+			continue;
+		}
+
+		const cell &cell = map[event.cell.x][event.cell.y];
+		if (!cell.interaction_handle) {
+			continue;
+		}
+
+		// every entity is a non-floating character for now
+		switch (interactions[*cell.interaction_handle].kind) {
+			case interaction_kind::LIGHT_MIDAIR:
+			case interaction_kind::HEAVY_MIDAIR:
+			case interaction_kind::WALK_ON_GROUND:
+				fire_activator(adapter, interactions[*cell.interaction_handle].interactable_handler, event_reason::NONE);
+				break;
+			case interaction_kind::LIGHT_MANUAL:
+			case interaction_kind::HEAVY_MANUAL:
+				break;
+		}
+	}
+	m_occupancy_events = std::move(firing);
 }
 
 void model::world::rotate_entity(adapter::adapter &adapter, handle_t handle, float rotation_rad) {
@@ -221,6 +378,9 @@ void model::world::rotate_entity(adapter::adapter &adapter, handle_t handle, flo
 }
 
 bool model::world::entity_check_collision(handle_t handle) {
+	NINJACLOWN_PROFILE_SCOPE("world::entity_check_collision");
+	++last_tick_stats.collision_tests;
+
 	obb box{*components.hitbox[handle]};
 
 	// with map
@@ -277,3 +437,345 @@ void model::world::fire_activator(adapter::adapter &adapter, handle_t handle, ev
 void model::world::fire_actionable(adapter::adapter &adapter, handle_t handle) {
 	actionables[handle].make_action({*this, adapter});
 }
+
+namespace {
+// save states: requests are written field by field, after the index of their alternative
+void write_request(utils::binary_writer &out, const ninja_api::nnj_movement_request &request) {
+	out.write(request.rotation);
+	out.write(request.forward_diff);
+	out.write(request.lateral_diff);
+}
+
+void write_request(utils::binary_writer &out, const ninja_api::nnj_activate_request &request) {
+	out.write_size(request.column);
+	out.write_size(request.line);
+}
+
+void write_request(utils::binary_writer &out, const ninja_api::nnj_attack_request &request) {
+	out.write_size(request.target_handle);
+}
+
+void write_request(utils::binary_writer & /*out*/, const ninja_api::nnj_throw_request & /*request*/) { }
+
+void read_request(utils::binary_reader &in, ninja_api::nnj_movement_request &request) {
+	in.read(request.rotation);
+	in.read(request.forward_diff);
+	in.read(request.lateral_diff);
+}
+
+void read_request(utils::binary_reader &in, ninja_api::nnj_activate_request &request) {
+	in.read_size(request.column);
+	in.read_size(request.line);
+}
+
+void read_request(utils::binary_reader &in, ninja_api::nnj_attack_request &request) {
+	if (in.read_size(request.target_handle) && request.target_handle >= model::cst::max_entities) {
+		in.fail();
+	}
+}
+
+void read_request(utils::binary_reader & /*in*/, ninja_api::nnj_throw_request & /*request*/) { }
+
+template <typename Variant>
+void write_optional_request(utils::binary_writer &out, const std::optional<Variant> &value) {
+	out.write(static_cast<std::uint8_t>(value ? value->index() + 1 : 0));
+	if (value) {
+		std::visit([&out](const auto &request) { write_request(out, request); }, *value);
+	}
+}
+
+template <typename Variant, std::size_t Index = 0>
+bool read_alternative(utils::binary_reader &in, std::size_t index, std::optional<Variant> &value) {
+	if constexpr (Index < std::variant_size_v<Variant>) {
+		if (index != Index) {
+			return read_alternative<Variant, Index + 1>(in, index, value);
+		}
+		std::variant_alternative_t<Index, Variant> request{};
+		read_request(in, request);
+		value.emplace(request);
+		return in.ok();
+	}
+	else {
+		return in.fail();
+	}
+}
+
+template <typename Variant>
+bool read_optional_request(utils::binary_reader &in, std::optional<Variant> &value) {
+	std::uint8_t index{};
+	value.reset();
+	if (!in.read(index) || index == 0) {
+		return in.ok();
+	}
+	return read_alternative(in, index - 1u, value);
+}
+
+enum class behaviour_id : std::uint8_t {
+	none,
+	gate,
+	autoshooter,
+};
+
+behaviour_id id_of(model::actionable::behaviour_type behaviour) noexcept {
+	if (behaviour == model::actionable::behaviours_ns::gate) {
+		return behaviour_id::gate;
+	}
+	if (behaviour == model::actionable::behaviours_ns::autoshooter) {
+		return behaviour_id::autoshooter;
+	}
+	return behaviour_id::none;
+}
+
+model::actionable::behaviour_type behaviour_of(behaviour_id id) noexcept {
+	switch (id) {
+		case behaviour_id::gate:
+			return model::actionable::behaviours_ns::gate;
+		case behaviour_id::autoshooter:
+			return model::actionable::behaviours_ns::autoshooter;
+		case behaviour_id::none:
+			[[fallthrough]];
+		default:
+			return model::actionable::behaviours_ns::none;
+	}
+}
+
+// cells are stored on a byte, the highest bit telling whether an interaction handle follows
+constexpr std::uint8_t has_interaction_bit = 0x80;
+} // namespace
+
+void model::world::save(utils::binary_writer &out) const {
+	NINJACLOWN_PROFILE_SCOPE("world::save");
+
+	out.write_size(map.width());
+	out.write_size(map.height());
+	for (std::size_t x = 0; x < map.width(); ++x) {
+		for (const cell &cell : map[x]) {
+			const auto type = static_cast<std::uint8_t>(cell.type);
+			if (cell.interaction_handle) {
+				out.write(static_cast<std::uint8_t>(type | has_interaction_bit));
+				out.write_size(*cell.interaction_handle);
+			}
+			else {
+				out.write(type);
+			}
+		}
+	}
+	out.write_size(target_tile.x);
+	out.write_size(target_tile.y);
+
+	for (handle_t handle = 0; handle < cst::max_entities; ++handle) {
+		const std::optional<component::health> &health = components.health[handle];
+		out.write(static_cast<std::uint8_t>(health.has_value()));
+		if (health) {
+			out.write(health->points);
+		}
+
+		const std::optional<component::hitbox> &hitbox = components.hitbox[handle];
+		out.write(static_cast<std::uint8_t>(hitbox.has_value()));
+		if (hitbox) {
+			out.write(hitbox->center.x);
+			out.write(hitbox->center.y);
+			out.write(hitbox->half.x);
+			out.write(hitbox->half.y);
+			out.write(hitbox->rad);
+		}
+
+		write_optional_request(out, components.decision[handle]);
+
+		const component::properties &properties = components.properties[handle];
+		out.write(properties.move_speed);
+		out.write(properties.rotation_speed);
+		out.write(properties.attack_range);
+		out.write(properties.activate_range);
+		out.write(properties.attack_delay);
+		out.write(properties.throw_delay);
+
+		out.write(static_cast<std::uint8_t>(components.metadata[handle].kind));
+
+		write_optional_request(out, components.state[handle].preparing_action);
+		out.write(components.state[handle].ticks_before_ready);
+	}
+
+	out.write_size(interactions.size());
+	for (const interaction &interaction : interactions) {
+		out.write(static_cast<std::uint8_t>(interaction.kind));
+		out.write(static_cast<std::uint8_t>(interaction.interactable));
+		out.write_size(interaction.interactable_handler);
+	}
+
+	out.write_size(activators.size());
+	for (const activator &activator : activators) {
+		out.write_size(activator.targets.size());
+		for (std::size_t target : activator.targets) {
+			out.write_size(target);
+		}
+		out.write(static_cast<std::uint8_t>(activator.refire_after.has_value()));
+		out.write(activator.refire_after.value_or(0));
+		out.write(activator.activation_delay);
+		out.write(activator.activation_difficulty);
+		out.write(activator.refire_repeat);
+		out.write(activator.enabled);
+	}
+
+	out.write_size(actionables.size());
+	for (const actionable &actionable : actionables) {
+		out.write_size(actionable.data.pos.x);
+		out.write_size(actionable.data.pos.y);
+		out.write_size(actionable.data.handle);
+		out.write(actionable.data.firing_rate);
+		out.write(actionable.data.angle);
+		out.write(id_of(actionable.behaviour));
+	}
+
+	projectiles.save(out);
+	m_event_queue.save(out);
+}
+
+bool model::world::load(utils::binary_reader &in) {
+	NINJACLOWN_PROFILE_SCOPE("world::load");
+	reset();
+
+	std::size_t width{};
+	std::size_t height{};
+	in.read_size(width);
+	in.read_size(height);
+	if (!in.ok()) {
+		return false;
+	}
+	map.resize(width, height);
+
+	// interaction handles are checked once interactions are known
+	std::size_t max_interaction_handle{0};
+	bool has_interactions{false};
+	for (std::size_t x = 0; x < width && in.ok(); ++x) {
+		for (cell &cell : map[x]) {
+			std::uint8_t type{};
+			if (!in.read(type)) {
+				return false;
+			}
+			const auto raw_type = static_cast<std::uint8_t>(type & ~has_interaction_bit);
+			if (raw_type < static_cast<std::uint8_t>(cell_type::CHASM) || raw_type > static_cast<std::uint8_t>(cell_type::WALL)) {
+				return in.fail();
+			}
+			cell.type = static_cast<cell_type>(raw_type);
+			if ((type & has_interaction_bit) != 0) {
+				std::size_t handle{};
+				in.read_size(handle);
+				cell.interaction_handle.emplace(handle);
+				max_interaction_handle = std::max(max_interaction_handle, handle);
+				has_interactions       = true;
+			}
+		}
+	}
+	in.read_size(target_tile.x);
+	in.read_size(target_tile.y);
+
+	for (handle_t handle = 0; handle < cst::max_entities && in.ok(); ++handle) {
+		std::uint8_t present{};
+		if (in.read(present) && present != 0) {
+			component::health health{};
+			in.read(health.points);
+			components.health[handle] = health;
+		}
+
+		if (in.read(present) && present != 0) {
+			float center_x{}, center_y{}, half_x{}, half_y{}, rad{};
+			in.read(center_x);
+			in.read(center_y);
+			in.read(half_x);
+			in.read(half_y);
+			in.read(rad);
+			components.hitbox[handle].emplace(center_x, center_y, half_x, half_y);
+			components.hitbox[handle]->rad = rad;
+		}
+
+		read_optional_request(in, components.decision[handle]);
+
+		component::properties &properties = components.properties[handle];
+		in.read(properties.move_speed);
+		in.read(properties.rotation_speed);
+		in.read(properties.attack_range);
+		in.read(properties.activate_range);
+		in.read(properties.attack_delay);
+		in.read(properties.throw_delay);
+
+		std::uint8_t kind{};
+		if (in.read(kind) && kind > ninja_api::nnj_entity_kind::EK_DLL) {
+			return in.fail();
+		}
+		components.metadata[handle].kind = static_cast<ninja_api::nnj_entity_kind>(kind);
+
+		read_optional_request(in, components.state[handle].preparing_action);
+		in.read(components.state[handle].ticks_before_ready);
+	}
+
+	std::size_t count{};
+	in.read_size(count);
+	for (std::size_t i = 0; i < count && in.ok(); ++i) {
+		interaction interaction{};
+		in.read_enum<interaction_kind, std::uint8_t>(interaction.kind, interaction_kind::WALK_ON_GROUND);
+		in.read_enum<interactable_kind, std::uint8_t>(interaction.interactable, interactable_kind::INFRARED_LASER);
+		in.read_size(interaction.interactable_handler);
+		interactions.push_back(interaction);
+	}
+	if (has_interactions && max_interaction_handle >= interactions.size()) {
+		return in.fail();
+	}
+
+	in.read_size(count);
+	for (std::size_t i = 0; i < count && in.ok(); ++i) {
+		activator activator{};
+		std::size_t target_count{};
+		in.read_size(target_count);
+		for (std::size_t j = 0; j < target_count && in.ok(); ++j) {
+			std::size_t target{};
+			in.read_size(target);
+			activator.targets.push_back(target);
+		}
+		std::uint8_t refires{};
+		tick_t refire_after{};
+		in.read(refires);
+		in.read(refire_after);
+		if (refires != 0) {
+			activator.refire_after = refire_after;
+		}
+		in.read(activator.activation_delay);
+		in.read(activator.activation_difficulty);
+		in.read(activator.refire_repeat);
+		in.read(activator.enabled);
+		activators.push_back(std::move(activator));
+	}
+
+	in.read_size(count);
+	for (std::size_t i = 0; i < count && in.ok(); ++i) {
+		actionable actionable{};
+		behaviour_id behaviour{};
+		in.read_size(actionable.data.pos.x);
+		in.read_size(actionable.data.pos.y);
+		in.read_size(actionable.data.handle);
+		in.read(actionable.data.firing_rate);
+		in.read(actionable.data.angle);
+		in.read_enum(behaviour, behaviour_id::autoshooter);
+		if (actionable.data.pos.x >= width || actionable.data.pos.y >= height) {
+			return in.fail();
+		}
+		actionable.behaviour = behaviour_of(behaviour);
+		actionables.push_back(actionable);
+	}
+
+	for (const activator &activator : activators) {
+		if (std::any_of(activator.targets.begin(), activator.targets.end(), [this](std::size_t target) { return target >= actionables.size(); })) {
+			return in.fail();
+		}
+	}
+	for (const interaction &interaction : interactions) {
+		if (interaction.interactable_handler >= activators.size()) {
+			return in.fail();
+		}
+	}
+
+	if (!projectiles.load(in, actionables.size()) || !m_event_queue.load(in, activators.size())) {
+		return false;
+	}
+	return in.ok();
+}
@@ -13,11 +13,29 @@
 #include "model/components.hpp"
 #include "model/grid.hpp"
 #include "model/interaction.hpp"
+#include "model/mob_ai.hpp"
+#include "model/movement.hpp"
+#include "model/occupancy.hpp"
+#include "model/projectiles.hpp"
+#include "utils/optional.hpp"
 
 class terminal_commands;
 
+namespace utils {
+class binary_writer;
+class binary_reader;
+} // namespace utils
+
 namespace model {
 
+/**
+ * Diagnostic counters, reset at the beginning of each world update
+ */
+struct tick_stats {
+	unsigned int collision_tests{0};
+	unsigned int events_fired{0};
+};
+
 struct world {
 	world() = default;
 
@@ -25,6 +43,21 @@ struct world {
 	void reset();
 	void reset_entity(handle_t);
 
+	/**
+	 * Writes the whole simulation state: map, components, interactions, activators, actionables, projectiles and events.
+	 * Caches (mob_ai distances, occupancy index) are rebuilt after loading instead.
+	 */
+	void save(utils::binary_writer &out) const;
+
+	/**
+	 * Reads what `save` wrote, replacing the state of the world. The world is left in an unspecified state on failure.
+	 */
+	[[nodiscard]] bool load(utils::binary_reader &in);
+
+	[[nodiscard]] tick_t current_tick() const noexcept {
+		return m_event_queue.tick();
+	}
+
 	grid map{};
 
 	::model::components components{};
@@ -33,13 +66,35 @@ struct world {
 	std::vector<activator> activators{};
 	std::vector<actionable> actionables{};
 
+	projectile_pool projectiles{};
+
+	mob_ai ai{};
+
 	grid_point target_tile;
 
+	tick_stats last_tick_stats{};
+
 private:
+	// action an entity decided to prepare, validated against the state of the world at the beginning of the tick
+	struct action_intent {
+		utils::optional<component::preparable_action> action{};
+		tick_t ticks_before_ready{0};
+	};
+
+	// first phase: entities decide in parallel, the world is left untouched
+	void evaluate_decisions();
+	void gather_movements();
+	[[nodiscard]] action_intent evaluate_action(handle_t) const;
+
+	// second phase: intents are applied one entity after another
 	void single_entity_simple_update(adapter::adapter &, handle_t);
 	void single_entity_decision_update(adapter::adapter &, handle_t);
 	void single_entity_action_update(adapter::adapter &, handle_t);
+	void update_projectiles(adapter::adapter &);
+	void damage_entity(adapter::adapter &, handle_t);
 	void move_entity(adapter::adapter &, handle_t, vec2 movement);
+	void sync_occupancy();
+	void fire_occupancy_events(adapter::adapter &);
 	void rotate_entity(adapter::adapter &, handle_t, float rotation_rad);
 	bool entity_check_collision(handle_t);
 
@@ -48,6 +103,14 @@ private:
 
 	event_queue m_event_queue{};
 
+	// intents of the current tick
+	movement_batch m_movements{};
+	std::array<action_intent, cst::max_entities> m_action_intents{};
+	std::vector<projectile_target> m_projectile_targets{};
+
+	occupancy_index m_occupancy{};
+	std::vector<occupancy_index::event> m_occupancy_events{}; //!< storage reused by fire_occupancy_events
+
 	friend terminal_commands;
 	friend event_queue;
 };
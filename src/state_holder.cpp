@@ -19,7 +19,10 @@ namespace {
 
 std::shared_ptr<terminal_commands> build_commands_manager() {
 	auto manager = std::make_shared<terminal_commands>();
-	spdlog::default_logger()->sinks().push_back(manager);
+	manager->set_level(spdlog::level::debug);
+	manager->spill_to(utils::config_directory() / "terminal.log", 4u << 20u); // NOLINT: 4 MiB
+	// the terminal must be known before logging goes asynchronous: sinks cannot be added afterwards
+	utils::log::make_default_logger_async(8192, {manager}); // NOLINT
 	return manager;
 }
 } // namespace
@@ -58,6 +61,10 @@ state::holder::holder(const std::filesystem::path &autorun_script) noexcept
 
 	m_pimpl->properties.emplace("display_debug_data", property{&view::show_debug_data, m_pimpl->view}); // TODO translations
 
+	m_pimpl->properties.emplace("display_perf_overlay", property{&view::show_perf_overlay, m_pimpl->view}); // TODO translations
+
+	m_pimpl->properties.emplace("idle_rendering", property{&view::idle_rendering, m_pimpl->view}); // TODO translations
+
 	m_pimpl->command_manager->load_commands();
 	if (is_regular_file(autorun_script)) {
 		std::ifstream autorun{autorun_script};
@@ -1,5 +1,6 @@
 #include "terminal_commands.hpp"
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 
@@ -7,12 +8,14 @@
 #include <spdlog/spdlog.h>
 
 #include "adapter/adapter.hpp"
+#include "adapter/save_state.hpp"
 #include "bot/bot_api.hpp"
 #include "bot/bot_dll.hpp"
 #include "model/model.hpp"
 #include "model/world.hpp"
 #include "state_holder.hpp"
 #include "utils/logging.hpp"
+#include "utils/profiler.hpp"
 #include "utils/resource_manager.hpp"
 #include "utils/utils.hpp"
 #include "utils/visitor.hpp"
@@ -57,12 +60,13 @@ std::pair<std::string_view, std::string_view> split_path(std::string_view path)
 }
 
 /**
- * Fetches for the localized logging text corresponding to the key
+ * Fetches for the localized logging text corresponding to the key. Commands run on the rendering thread, which is the one
+ * publishing reloaded resources: the text stays valid until the command returns.
  * @param arg argument_type, for access to resources
  * @param key key associated to the logging text
  */
 std::string_view log_get(const terminal_commands::argument_type &, std::string_view key) {
-	return utils::resource_manager::instance().log_for(key);
+	return utils::resource_manager::instance()->log_for(key);
 }
 
 /**
@@ -120,6 +124,14 @@ std::vector<std::string> autocomplete_map_path(terminal_commands::argument_type
 	return terminal_commands::autocomplete_path(arg, {".map"});
 }
 
+/**
+ * @param arg path prefix
+ * @return a list of save states corresponding to prefix, and a list of folders corresponding to prefix
+ */
+std::vector<std::string> autocomplete_save_state_path(terminal_commands::argument_type &arg) {
+	return terminal_commands::autocomplete_path(arg, {adapter::save_state::extension});
+}
+
 /**
  * @param arg path prefix
  * @return a list of files ending by ".toml" corresponding to prefix, and a list of folders corresponding to prefix
@@ -128,6 +140,30 @@ std::vector<std::string> autocomplete_config(terminal_commands::argument_type &a
 	return terminal_commands::autocomplete_path(arg, {".toml"});
 }
 
+/**
+ * @param arg profile sub-command, or path prefix when dumping
+ * @return a list of sub-commands, or a list of files ending by ".json" corresponding to prefix, and a list of folders corresponding to prefix
+ */
+std::vector<std::string> autocomplete_profile(terminal_commands::argument_type &arg) {
+	if (arg.command_line.size() == 3 && arg.command_line[1] == "dump") {
+		std::vector<std::string> sub_line{arg.command_line[0], arg.command_line[2]};
+		std::swap(arg.command_line, sub_line);
+		std::vector<std::string> ans = terminal_commands::autocomplete_path(arg, {".json"});
+		std::swap(arg.command_line, sub_line);
+		return ans;
+	}
+
+	std::vector<std::string> ans;
+	if (arg.command_line.size() == 2) {
+		for (std::string_view sub_cmd : {"start", "stop", "dump"}) {
+			if (utils::starts_with(sub_cmd, arg.command_line[1])) {
+				ans.emplace_back(sub_cmd);
+			}
+		}
+	}
+	return ans;
+}
+
 //! used to store the list of available commands
 struct cmd {
 	command_id cmd; //! used to access localized resources
@@ -152,7 +188,10 @@ constexpr std::array local_command_list{
   cmd{command_id::valueof, terminal_commands::valueof, terminal_commands::autocomplete_variable}, // TODO:autocomplete with map
   cmd{command_id::reconfigure, terminal_commands::reconfigure, autocomplete_config},
   cmd{command_id::fire_actionable, terminal_commands::fire_actionable, terminal_commands::no_completion},
-  cmd{command_id::fire_activator, terminal_commands::fire_activator, terminal_commands::no_completion}};
+  cmd{command_id::fire_activator, terminal_commands::fire_activator, terminal_commands::no_completion},
+  cmd{command_id::profile, terminal_commands::profile, autocomplete_profile},
+  cmd{command_id::save_state, terminal_commands::save_state, autocomplete_save_state_path},
+  cmd{command_id::load_state, terminal_commands::load_state, autocomplete_save_state_path}};
 
 /**
  * Converts a string_view to a boolean. Converts to true if numeric and != 0, or if it compares equal to "true".
@@ -167,11 +206,11 @@ bool as_bool(std::string_view str) {
 } // namespace
 
 void terminal_commands::load_commands() noexcept {
-	auto& resources = utils::resource_manager::instance();
+	const auto resources = utils::resource_manager::instance();
 	cmd_list_.clear(); // add_command_ will fill this list
 
 	for (const auto &cmd : local_command_list) {
-		auto maybe_command = resources.text_for(cmd.cmd);
+		auto maybe_command = resources->text_for(cmd.cmd);
 		if (!maybe_command) {
 			utils::log::warn("terminal_commands.command_missing_name", "cmd_id"_a = static_cast<int>(cmd.cmd));
 			continue;
@@ -190,29 +229,112 @@ void terminal_commands::load_commands() noexcept {
 
 void terminal_commands::set_terminal(term_t &term) noexcept {
 	terminal_ = &term;
-	for (ImTerm::message &msg : m_pre_logged_messages) {
-		term.add_message(std::move(msg));
+	term.set_max_log_len(max_kept_messages);
+	forward_messages();
+}
+
+void terminal_commands::forward_messages() noexcept {
+	if (terminal_ == nullptr) {
+		return;
+	}
+
+	std::size_t dropped{};
+	std::vector<ImTerm::message> messages;
+	{
+		std::scoped_lock lock{m_pending_mutex};
+		if (m_pending_messages.size() == 0) {
+			return;
+		}
+		dropped = std::exchange(m_dropped_messages, 0);
+		messages.reserve(m_pending_messages.size());
+		m_pending_messages.drain([&messages](ImTerm::message &&msg) {
+			messages.push_back(std::move(msg));
+		});
+	}
+
+	if (dropped != 0) {
+		const auto resources       = utils::resource_manager::instance();
+		const std::string_view fmt = resources->log_for("terminal_commands.backlog_dropped");
+		try {
+			terminal_->add_formatted(fmt.data(), "count"_a = dropped);
+		}
+		catch (const fmt::format_error &error) {
+			spdlog::error(R"("{}" while formatting string "{}")", error.what(), fmt);
+		}
+	}
+	for (ImTerm::message &msg : messages) {
+		terminal_->add_message(std::move(msg));
 	}
-	m_pre_logged_messages.clear();
+	m_logged_messages.fetch_add(messages.size(), std::memory_order_relaxed);
 }
 
-void terminal_commands::sink_it_(const spdlog::details::log_msg &msg) {
-	if (msg.level == spdlog::level::off) {
+bool terminal_commands::spill_to(const std::filesystem::path &file, std::size_t file_size) noexcept {
+	m_spill_cursor = 0;
+	m_spill_file.close();
+
+	std::error_code ec;
+	if (std::filesystem::exists(file, ec)) {
+		std::filesystem::path previous = file;
+		previous += ".1";
+		std::filesystem::rename(file, previous, ec);
+	}
+
+	if (!m_spill_file.create(file, file_size)) {
+		return false;
+	}
+	// unused space reads as empty lines
+	char *data = m_spill_file.writable_data();
+	std::fill(data, data + m_spill_file.size(), '\n'); // NOLINT
+	return true;
+}
+
+void terminal_commands::spill(std::string_view line) noexcept {
+	char *data             = m_spill_file.writable_data();
+	const std::size_t size = m_spill_file.size();
+	if (data == nullptr || line.empty() || line.size() + spill_end_marker.size() + 1 > size) {
 		return;
 	}
+
+	if (m_spill_cursor + line.size() + spill_end_marker.size() + 1 > size) {
+		// wrapping around: the oldest lines, at the end of the file, are dropped
+		std::fill(data + m_spill_cursor, data + size, '\n'); // NOLINT
+		m_spill_cursor = 0;
+	}
+	std::copy(line.begin(), line.end(), data + m_spill_cursor); // NOLINT
+	m_spill_cursor += line.size();
+	if (line.back() != '\n') {
+		data[m_spill_cursor++] = '\n'; // NOLINT
+	}
+
+	// the marker replaces the beginning of the oldest line: it is padded up to the end of that line, for no half line to remain
+	char *marker_end = std::copy(spill_end_marker.begin(), spill_end_marker.end(), data + m_spill_cursor); // NOLINT
+	char *line_end   = std::find(marker_end, data + size, '\n');                                          // NOLINT
+	std::fill(marker_end, line_end, '-');
+	if (line_end == data + size) {
+		data[size - 1] = '\n'; // NOLINT
+	}
+}
+
+void terminal_commands::sink_it_(const spdlog::details::log_msg &msg) {
 	spdlog::memory_buf_t buff{};
-	spdlog::sinks::base_sink<misc::no_mutex>::formatter_->format(msg, buff);
+	spdlog::sinks::base_sink<std::mutex>::formatter_->format(msg, buff);
+	spill({buff.data(), buff.size()});
+	if (msg.level >= spdlog::level::warn) {
+		m_spill_file.flush();
+	}
 
 	ImTerm::message imsg{ImTerm::details::to_imterm_severity(msg.level), fmt::to_string(buff), msg.color_range_start, msg.color_range_end,
 	                     false};
-	if (terminal_ != nullptr) {
-		terminal_->add_message(std::move(imsg));
-	}
-	else {
-		m_pre_logged_messages.emplace_back(std::move(imsg)); // FIXME data race with terminal_commands::set_terminal ?
+	std::scoped_lock lock{m_pending_mutex};
+	if (m_pending_messages.push(std::move(imsg))) {
+		++m_dropped_messages;
 	}
 }
 
+void terminal_commands::flush_() {
+	m_spill_file.flush();
+}
+
 void terminal_commands::clear(argument_type &arg) {
 	arg.term.clear();
 }
@@ -236,9 +358,10 @@ void terminal_commands::exit(argument_type &arg) {
 }
 
 void terminal_commands::help(argument_type &arg) {
+	const auto resources = utils::resource_manager::instance();
 	std::vector<std::pair<std::string_view, std::string_view>> commands; // name, description
 	for (const auto &cmd : local_command_list) {
-		auto opt = utils::resource_manager::instance().text_for(cmd.cmd);
+		auto opt = resources->text_for(cmd.cmd);
 		if (!opt) {
 			utils::log::warn( "terminal_commands.command_missing_name", "cmd_id"_a = static_cast<int>(cmd.cmd));
 			continue;
@@ -300,9 +423,7 @@ void terminal_commands::load_map(argument_type &arg) {
 }
 
 void terminal_commands::update_world(argument_type &arg) {
-	arg.val.model().bot_think();
-	arg.val.adapter().m_cells_changed_since_last_update.clear();
-	arg.val.model().world.update(arg.val.adapter());
+	arg.val.model().tick();
 }
 
 void terminal_commands::run_model(argument_type &arg) {
@@ -389,13 +510,12 @@ void terminal_commands::reconfigure(argument_type &arg) {
 		return;
 	}
 
-	if (!utils::resource_manager::instance().reload(/*arg.command_line.back()*/)) { // FIXME : path to config is ignored
+	// resources are published (and sprites reloaded) by the view once loaded
+	if (!utils::resource_manager::reload_async(/*arg.command_line.back()*/)) { // FIXME : path to config is ignored
 		log_formatted(arg, "terminal_commands.reload.fail", "file_path"_a = arg.command_line.back());
 	}
 	else {
-		log_formatted(arg, "terminal_commands.reload.success", "file_path"_a = arg.command_line.back());
-		arg.val.view().game().reload_sprites();
-		arg.val.terminal().get_terminal_helper()->load_commands();
+		log_formatted(arg, "terminal_commands.reload.started", "file_path"_a = arg.command_line.back());
 	}
 }
 
@@ -450,6 +570,57 @@ void terminal_commands::fire_actionable(argument_type &arg) {
 	arg.val.model().world.fire_actionable(arg.val.adapter(), *val);
 }
 
+void terminal_commands::profile(argument_type &arg) {
+#ifndef NINJACLOWN_PROFILER
+	log_formatted_err(arg, "terminal_commands.profile.compiled_out");
+#else
+	const auto &cmd_line = arg.command_line;
+	if (cmd_line.size() == 2 && cmd_line[1] == "start") {
+		utils::profiler::set_enabled(true);
+		log_formatted(arg, "terminal_commands.profile.started");
+	}
+	else if (cmd_line.size() == 2 && cmd_line[1] == "stop") {
+		utils::profiler::set_enabled(false);
+		log_formatted(arg, "terminal_commands.profile.stopped");
+	}
+	else if (cmd_line.size() == 3 && cmd_line[1] == "dump") {
+		if (utils::profiler::export_chrome_trace(cmd_line[2])) {
+			log_formatted(arg, "terminal_commands.profile.dumped", "file_path"_a = cmd_line[2]);
+		}
+		else {
+			log_formatted_err(arg, "terminal_commands.profile.dump_failed", "file_path"_a = cmd_line[2]);
+		}
+	}
+	else {
+		log_formatted_err(arg, "terminal_commands.profile.usage", "arg0"_a = cmd_line.front());
+	}
+#endif
+}
+
+void terminal_commands::save_state(argument_type &arg) {
+	if (arg.command_line.size() != 2) {
+		log_formatted_err(arg, "terminal_commands.save_state.usage", "arg0"_a = arg.command_line[0]);
+		return;
+	}
+	if (arg.val.model().is_running()) {
+		log_formatted_err(arg, "terminal_commands.state.model_running");
+		return;
+	}
+	arg.val.adapter().save_state(arg.command_line[1]);
+}
+
+void terminal_commands::load_state(argument_type &arg) {
+	if (arg.command_line.size() != 2) {
+		log_formatted_err(arg, "terminal_commands.load_state.usage", "arg0"_a = arg.command_line[0]);
+		return;
+	}
+	if (arg.val.model().is_running()) {
+		log_formatted_err(arg, "terminal_commands.state.model_running");
+		return;
+	}
+	arg.val.adapter().load_state(arg.command_line[1]);
+}
+
 std::vector<std::string> terminal_commands::autocomplete_path(argument_type &arg,
                                                               const std::initializer_list<std::string_view> &extensions) {
 	std::vector<std::string> paths;
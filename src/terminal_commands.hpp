@@ -1,6 +1,8 @@
 #ifndef NINJACLOWN_TERMINAL_COMMANDS_HPP
 #define NINJACLOWN_TERMINAL_COMMANDS_HPP
 
+#include <atomic>
+#include <filesystem>
 #include <initializer_list>
 #include <mutex>
 #include <string>
@@ -10,6 +12,9 @@
 #include <imterm/terminal.hpp>
 #include <imterm/terminal_helpers.hpp>
 
+#include "utils/mapped_file.hpp"
+#include "utils/ring_buffer.hpp"
+
 namespace utils {
 class resource_manager;
 }
@@ -20,7 +25,7 @@ namespace state {
 class holder;
 }
 
-class terminal_commands: public ImTerm::basic_spdlog_terminal_helper<terminal_commands, state::holder, misc::no_mutex> {
+class terminal_commands: public ImTerm::basic_spdlog_terminal_helper<terminal_commands, state::holder, std::mutex> {
 public:
 	/**
 	 * Loads commands into ImTerm, based on static variable local_command_list
@@ -33,15 +38,53 @@ public:
 	 */
 	[[maybe_unused]] void set_terminal(term_t &term) noexcept;
 
+	/**
+	 * Moves the messages logged since the last call to the terminal. Only call from the thread displaying the terminal:
+	 * messages are logged from spdlog's worker thread, that never touches the terminal itself.
+	 */
+	void forward_messages() noexcept;
+
+	/**
+	 * Additionally writes every accepted message to a memory mapped file of fixed size, one line per message, overwriting
+	 * the oldest lines once the file is full. The newest line is followed by spill_end_marker. The file of the previous run,
+	 * if any, is kept with a ".1" suffix. The file is flushed on warnings and errors, and when the sink is flushed.
+	 * @return false if the file could not be created (spilling is then disabled)
+	 */
+	bool spill_to(const std::filesystem::path &file, std::size_t file_size) noexcept;
+
+	// written after the newest line of the spill file, padded with '-' to the end of the line it overwrites
+	static constexpr std::string_view spill_end_marker = "---- newest message above, oldest below ";
+
+	// amount of messages added to the terminal so far, for the view to know when it should be drawn again
+	[[nodiscard]] std::size_t logged_messages() const noexcept {
+		return m_logged_messages.load(std::memory_order_relaxed);
+	}
+
+	// maximum amount of messages kept in memory, by the backlog and by the terminal
+	static constexpr std::size_t max_kept_messages = 2048;
+
 private:
 	/**
-	 * Automatically called by spdlog when logs are sent in.
-	 * Logs messages to the terminal or store them for later logging if the terminal wasn’t spawned yet.
+	 * Automatically called by spdlog when logs are sent in, with the sink's mutex held.
+	 * Stores messages until they are forwarded to the terminal.
 	 */
 	void sink_it_(const spdlog::details::log_msg &msg) override;
 
-	// messages that were logged before a terminal was linked to this instance
-	std::vector<ImTerm::message> m_pre_logged_messages{};
+	/**
+	 * Called by spdlog (eg: on shutdown), with the sink's mutex held
+	 */
+	void flush_() override;
+
+	void spill(std::string_view line) noexcept;
+
+	// messages that were not forwarded to the terminal yet (oldest ones are dropped), guarded by m_pending_mutex
+	std::mutex m_pending_mutex{};
+	utils::ring_buffer<ImTerm::message> m_pending_messages{max_kept_messages};
+	std::size_t m_dropped_messages{0};
+	std::atomic_size_t m_logged_messages{0};
+
+	utils::mapped_file m_spill_file{};
+	std::size_t m_spill_cursor{0};
 
 public:
 	static std::vector<std::string> no_completion(argument_type &) {
@@ -123,6 +166,21 @@ public:
 	 */
 	static void fire_actionable(argument_type &);
 
+	/**
+	 * Starts/stops the tick profiler, or dumps its records as Chrome trace-event JSON
+	 */
+	static void profile(argument_type &);
+
+	/**
+	 * Saves the state of the simulation
+	 */
+	static void save_state(argument_type &);
+
+	/**
+	 * Restores the simulation from a save state
+	 */
+	static void load_state(argument_type &);
+
 	/**
 	 * Completes a paths with files and folders corresponding to the prefix, and matching an extension.
 	 * Files are stored before folders.
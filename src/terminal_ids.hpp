@@ -16,6 +16,9 @@ enum class command_id {
     reconfigure         = COMMANDS_RELOAD_RESOURCES,
     fire_actionable     = COMMANDS_FIRE_ACTIONABLE,
     fire_activator      = COMMANDS_FIRE_ACTIVATOR,
+    profile             = COMMANDS_PROFILE,
+    save_state          = COMMANDS_SAVE_STATE,
+    load_state          = COMMANDS_LOAD_STATE,
     OUTOFRANGE
 };
 
@@ -23,6 +26,7 @@ enum class variable_id {
     average_fps        = VARIABLES_AVERAGE_FPSID,
     target_fps         = VARIABLES_TARGET_FPSID,
     display_debug_data = VARIABLES_DISPLAY_DEBUG_DATAID,
+    display_perf_overlay = VARIABLES_DISPLAY_PERF_OVERLAYID,
     OUTOFRANGE
 };
 
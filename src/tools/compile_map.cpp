@@ -0,0 +1,50 @@
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+#include "adapter/compiled_map.hpp"
+#include "adapter/map_data.hpp"
+#include "utils/hash.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/resource_manager.hpp"
+
+/**
+ * Compiles map files ahead of time:
+ *   ninja-clown-compile-map <map file> [output file]
+ * The output defaults to the map file with the compiled map extension. Compiled maps can be loaded directly by the game.
+ */
+int main(int argc, char **argv) {
+	utils::resource_manager::set_loading_mode(utils::resource_manager::loading_mode::headless);
+
+	if (argc != 2 && argc != 3) {
+		std::cerr << "usage: " << argv[0] << " <map file> [output file]\n"; // NOLINT
+		return EXIT_FAILURE;
+	}
+
+	const std::filesystem::path input{argv[1]}; // NOLINT
+	std::filesystem::path output = input;
+	output.replace_extension(adapter::map_data::compiled_extension);
+	if (argc == 3) {
+		output = argv[2]; // NOLINT
+	}
+
+	utils::mapped_file source;
+	if (!source.open(input)) {
+		std::cerr << "could not read " << input << '\n';
+		return EXIT_FAILURE;
+	}
+
+	std::optional<adapter::map_data::level> level = adapter::map_data::parse(source.view(), input.generic_string());
+	if (!level) {
+		std::cerr << "could not parse " << input << '\n';
+		return EXIT_FAILURE;
+	}
+
+	if (!adapter::map_data::write_compiled(*level, utils::fnv1a_64(source.view()), output)) {
+		std::cerr << "could not write " << output << '\n';
+		return EXIT_FAILURE;
+	}
+
+	std::cout << input.generic_string() << " -> " << output.generic_string() << " (" << level->width << 'x' << level->height << ")\n";
+	return EXIT_SUCCESS;
+}
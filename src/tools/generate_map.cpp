@@ -0,0 +1,147 @@
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+#include "adapter/compiled_map.hpp"
+#include "adapter/map_generator.hpp"
+#include "utils/resource_manager.hpp"
+
+namespace {
+template <typename T>
+bool parse_number(std::string_view text, T &value) {
+	const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+	return result.ec == std::errc{} && result.ptr == text.data() + text.size();
+}
+
+bool parse_number(std::string_view text, float &value) {
+	char *end{};
+	const std::string str{text};
+	value = std::strtof(str.c_str(), &end);
+	return !str.empty() && end == str.c_str() + str.size();
+}
+
+bool parse_number(std::string_view text, bool &value) {
+	unsigned int as_int{};
+	if (!parse_number(text, as_int) || as_int > 1) {
+		return false;
+	}
+	value = as_int != 0;
+	return true;
+}
+
+// sets the setting named `name`, returns false if the name or value is invalid
+bool set(adapter::map_data::generator_settings &settings, std::string_view name, std::string_view value) {
+	if (name == "width") {
+		return parse_number(value, settings.width);
+	}
+	if (name == "height") {
+		return parse_number(value, settings.height);
+	}
+	if (name == "size") {
+		return parse_number(value, settings.width) && parse_number(value, settings.height);
+	}
+	if (name == "seed") {
+		return parse_number(value, settings.seed);
+	}
+	if (name == "walls") {
+		return parse_number(value, settings.wall_density);
+	}
+	if (name == "chasms") {
+		return parse_number(value, settings.chasm_density);
+	}
+	if (name == "iron") {
+		return parse_number(value, settings.iron_density);
+	}
+	if (name == "gates") {
+		return parse_number(value, settings.gates);
+	}
+	if (name == "closed_gates") {
+		return parse_number(value, settings.closed_gates);
+	}
+	if (name == "autoshooters") {
+		return parse_number(value, settings.autoshooters);
+	}
+	if (name == "firing_rate") {
+		return parse_number(value, settings.firing_rate);
+	}
+	if (name == "activators") {
+		return parse_number(value, settings.activators);
+	}
+	if (name == "delay") {
+		return parse_number(value, settings.activator_delay);
+	}
+	if (name == "refire_after") {
+		return parse_number(value, settings.refire_after);
+	}
+	if (name == "refire_repeat") {
+		return parse_number(value, settings.refire_repeat);
+	}
+	if (name == "players") {
+		return parse_number(value, settings.players);
+	}
+	if (name == "harmless") {
+		return parse_number(value, settings.harmless);
+	}
+	if (name == "patrols") {
+		return parse_number(value, settings.patrols);
+	}
+	if (name == "aggressives") {
+		return parse_number(value, settings.aggressives);
+	}
+	return false;
+}
+} // namespace
+
+/**
+ * Generates a level, for benchmarks:
+ *   ninja-clown-generate-map <output file> [setting=value...]
+ * Settings are those of adapter::map_data::generator_settings: size (or width and height), seed, walls, chasms, iron,
+ * gates, closed_gates, autoshooters, firing_rate, activators, delay, refire_after, refire_repeat (0 or 1), players,
+ * harmless, patrols and aggressives. The output is a version 1.0.0 map file, or a compiled map if the output has the
+ * compiled map extension.
+ */
+int main(int argc, char **argv) {
+	utils::resource_manager::set_loading_mode(utils::resource_manager::loading_mode::headless);
+
+	if (argc < 2) {
+		std::cerr << "usage: " << argv[0] << " <output file> [setting=value...]\n"; // NOLINT
+		return EXIT_FAILURE;
+	}
+
+	const std::filesystem::path output{argv[1]}; // NOLINT
+
+	adapter::map_data::generator_settings settings;
+	for (int i = 2; i < argc; ++i) {
+		const std::string_view argument{argv[i]}; // NOLINT
+		const std::size_t equal = argument.find('=');
+		if (equal == std::string_view::npos || !set(settings, argument.substr(0, equal), argument.substr(equal + 1))) {
+			std::cerr << "invalid setting: " << argument << '\n';
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (std::string_view reason = adapter::map_data::invalid_setting(settings); !reason.empty()) {
+		std::cerr << "invalid settings: " << reason << '\n';
+		return EXIT_FAILURE;
+	}
+
+	std::optional<adapter::map_data::level> level = adapter::map_data::generate(settings);
+	if (!level) {
+		std::cerr << "could not generate the map: not enough ground cells for mobs and actors\n";
+		return EXIT_FAILURE;
+	}
+
+	const bool written = output.extension() == adapter::map_data::compiled_extension ?
+	                       adapter::map_data::write_compiled(*level, settings.seed, output) :
+	                       adapter::map_data::write_v1_0_0(*level, output);
+	if (!written) {
+		std::cerr << "could not write " << output << '\n';
+		return EXIT_FAILURE;
+	}
+
+	std::cout << output.generic_string() << " (" << level->width << 'x' << level->height << ", " << level->mobs.size() << " mobs, "
+	          << level->actors.size() << " actors, seed " << settings.seed << ")\n";
+	return EXIT_SUCCESS;
+}
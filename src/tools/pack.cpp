@@ -0,0 +1,47 @@
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+#include "utils/archive.hpp"
+#include "utils/resource_manager.hpp"
+
+/**
+ * Packs a directory (campaign, resource pack, ...) into a single archive:
+ *   ninja-clown-pack <directory> [output file]
+ * The output defaults to the directory name with the archive extension. Files within archives are then referred to as
+ * <archive>/<path of the file within the directory>, eg: "campaign.ncpack/maps/first.map".
+ */
+int main(int argc, char **argv) {
+	utils::resource_manager::set_loading_mode(utils::resource_manager::loading_mode::headless);
+
+	if (argc != 2 && argc != 3) {
+		std::cerr << "usage: " << argv[0] << " <directory> [output file]\n"; // NOLINT
+		return EXIT_FAILURE;
+	}
+
+	const std::filesystem::path input = std::filesystem::path{argv[1]}.lexically_normal(); // NOLINT
+	std::filesystem::path output      = input.has_filename() ? input : input.parent_path();
+	output.replace_extension(utils::archive::extension);
+	if (argc == 3) {
+		output = argv[2]; // NOLINT
+	}
+
+	if (!std::filesystem::is_directory(input)) {
+		std::cerr << input << " is not a directory\n";
+		return EXIT_FAILURE;
+	}
+
+	if (!utils::archive::pack(input, output)) {
+		std::cerr << "could not write " << output << '\n';
+		return EXIT_FAILURE;
+	}
+
+	utils::archive archive;
+	if (!archive.open(output)) {
+		std::cerr << "could not read back " << output << '\n';
+		return EXIT_FAILURE;
+	}
+
+	std::cout << input.generic_string() << " -> " << output.generic_string() << " (" << archive.entries().size() << " files)\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+#include "utils/archive.hpp"
+#include "utils/hash.hpp"
+
+namespace {
+constexpr std::array<char, 8> magic{'N', 'C', 'P', 'A', 'C', 'K', '\0', '\0'};
+constexpr std::uint32_t format_version = 1;
+constexpr std::size_t alignment        = 8;
+
+struct header {
+	std::array<char, 8> magic;
+	std::uint32_t version;
+	std::uint32_t entry_count;
+	std::uint64_t index_offset;
+};
+
+template <typename T>
+bool read(std::string_view &bytes, T &value) noexcept {
+	if (bytes.size() < sizeof(T)) {
+		return false;
+	}
+	std::memcpy(&value, bytes.data(), sizeof(T));
+	bytes.remove_prefix(sizeof(T));
+	return true;
+}
+
+template <typename T>
+void write(std::ofstream &stream, const T &value) {
+	stream.write(reinterpret_cast<const char *>(&value), sizeof(T)); // NOLINT
+}
+
+void pad(std::ofstream &stream, std::uint64_t &offset) {
+	static constexpr std::array<char, alignment> zeroes{};
+	const std::uint64_t padding = (alignment - offset % alignment) % alignment;
+	stream.write(zeroes.data(), static_cast<std::streamsize>(padding));
+	offset += padding;
+}
+} // namespace
+
+bool utils::archive::open(const std::filesystem::path &file) noexcept {
+	m_entries.clear();
+	if (!m_file.open(file)) {
+		return false;
+	}
+
+	const std::string_view bytes = m_file.view();
+	std::string_view cursor      = bytes;
+	header head{};
+	if (!read(cursor, head) || head.magic != magic || head.version != format_version || head.index_offset > bytes.size()) {
+		m_file.close();
+		return false;
+	}
+
+	try {
+		m_entries.reserve(head.entry_count);
+	}
+	catch (const std::bad_alloc &) {
+		m_file.close();
+		return false;
+	}
+
+	std::string_view index = bytes.substr(head.index_offset);
+	for (std::uint32_t i = 0; i < head.entry_count; ++i) {
+		std::uint32_t name_length{};
+		std::uint64_t offset{};
+		std::uint64_t length{};
+		std::uint64_t hash{};
+		if (!read(index, name_length) || index.size() < name_length) {
+			m_entries.clear();
+			m_file.close();
+			return false;
+		}
+		const std::string_view name = index.substr(0, name_length);
+		index.remove_prefix(name_length);
+
+		// names must be sorted for lookups
+		if (!read(index, offset) || !read(index, length) || !read(index, hash) || offset > bytes.size() || length > bytes.size() - offset
+		    || (!m_entries.empty() && !(m_entries.back().name < name))) {
+			m_entries.clear();
+			m_file.close();
+			return false;
+		}
+		m_entries.push_back({name, bytes.substr(offset, length), hash});
+	}
+	return true;
+}
+
+const utils::archive::entry *utils::archive::find(std::string_view name) const noexcept {
+	auto it = std::lower_bound(m_entries.begin(), m_entries.end(), name, [](const entry &lhs, std::string_view rhs) {
+		return lhs.name < rhs;
+	});
+	if (it == m_entries.end() || it->name != name) {
+		return nullptr;
+	}
+	return &*it;
+}
+
+bool utils::archive::pack(const std::filesystem::path &directory, const std::filesystem::path &archive_file) noexcept {
+	namespace fs = std::filesystem;
+	try {
+		std::vector<std::pair<std::string, fs::path>> files;
+		for (const fs::directory_entry &file : fs::recursive_directory_iterator{directory}) {
+			if (file.is_regular_file()) {
+				files.emplace_back(fs::relative(file.path(), directory).generic_string(), file.path());
+			}
+		}
+		std::sort(files.begin(), files.end());
+
+		struct index_entry {
+			std::uint64_t offset;
+			std::uint64_t length;
+			std::uint64_t hash;
+		};
+		std::vector<index_entry> index;
+		index.reserve(files.size());
+
+		std::ofstream stream{archive_file, std::ios::binary | std::ios::trunc};
+		write(stream, header{magic, format_version, static_cast<std::uint32_t>(files.size()), 0});
+		std::uint64_t offset = sizeof(header);
+
+		std::string content;
+		for (const auto &file : files) {
+			std::ifstream input{file.second, std::ios::binary};
+			content.assign(std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{});
+
+			pad(stream, offset);
+			index.push_back({offset, content.size(), fnv1a_64(content)});
+			stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+			offset += content.size();
+		}
+
+		pad(stream, offset);
+		const std::uint64_t index_offset = offset;
+		for (std::size_t i = 0; i < files.size(); ++i) {
+			write(stream, static_cast<std::uint32_t>(files[i].first.size()));
+			stream.write(files[i].first.data(), static_cast<std::streamsize>(files[i].first.size()));
+			write(stream, index[i]);
+		}
+
+		stream.seekp(0);
+		write(stream, header{magic, format_version, static_cast<std::uint32_t>(files.size()), index_offset});
+		return static_cast<bool>(stream);
+	}
+	catch (const std::exception &) {
+		return false;
+	}
+}
+
+std::shared_ptr<const utils::archive> utils::archive::shared(const std::filesystem::path &file) noexcept {
+	static std::mutex mutex;
+	static std::unordered_map<std::string, std::weak_ptr<const archive>> opened;
+
+	try {
+		const std::string key = file.lexically_normal().generic_string();
+
+		std::lock_guard lock{mutex};
+		if (std::shared_ptr<const archive> existing = opened[key].lock(); existing) {
+			return existing;
+		}
+
+		auto opening = std::make_shared<archive>();
+		if (!opening->open(file)) {
+			opened.erase(key);
+			return nullptr;
+		}
+		opened[key] = opening;
+		return opening;
+	}
+	catch (const std::exception &) {
+		return nullptr;
+	}
+}
+
+std::optional<std::pair<std::filesystem::path, std::string>> utils::archive::split(const std::filesystem::path &path) noexcept {
+	try {
+		std::filesystem::path archive_path;
+		for (auto it = path.begin(); it != path.end(); ++it) {
+			archive_path /= *it;
+			if (it->extension() == extension && std::next(it) != path.end() && std::filesystem::is_regular_file(archive_path)) {
+				std::filesystem::path inner;
+				for (auto inner_it = std::next(it); inner_it != path.end(); ++inner_it) {
+					inner /= *inner_it;
+				}
+				return std::pair{archive_path, inner.generic_string()};
+			}
+		}
+	}
+	catch (const std::exception &) {
+	}
+	return {};
+}
+
+std::optional<std::pair<std::shared_ptr<const utils::archive>, const utils::archive::entry *>>
+utils::archive::lookup(const std::filesystem::path &path) noexcept {
+	std::optional<std::pair<std::filesystem::path, std::string>> split_path = split(path);
+	if (!split_path) {
+		return {};
+	}
+
+	std::shared_ptr<const archive> holder = shared(split_path->first);
+	if (!holder) {
+		return {};
+	}
+
+	const entry *file = holder->find(split_path->second);
+	if (file == nullptr) {
+		return {};
+	}
+	return std::pair{std::move(holder), file};
+}
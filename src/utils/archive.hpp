@@ -0,0 +1,85 @@
+#ifndef NINJACLOWN_UTILS_ARCHIVE_HPP
+#define NINJACLOWN_UTILS_ARCHIVE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "utils/mapped_file.hpp"
+
+namespace utils {
+
+/**
+ * Read only, memory mapped, single file archive (eg: a campaign, with its maps and its texture pack).
+ *
+ * Layout (native endianness):
+ *   header  : magic, format version, entry count, offset of the index
+ *   data    : content of every file, 8 bytes aligned
+ *   index   : for every file, sorted by name: name length, name, offset, length, FNV-1a hash of the content
+ *
+ * Opening an archive only reads its index: files are then accessed in place, without copies.
+ * Within the program, files of an archive are designated by paths going through the archive, as if it was a folder:
+ * "campaigns/tournament.ncpack/maps/first.map".
+ */
+class archive {
+public:
+	static constexpr std::string_view extension = ".ncpack";
+
+	struct entry {
+		std::string_view name; //!< relative path, with '/' as separator
+		std::string_view data;
+		std::uint64_t hash;
+	};
+
+	/**
+	 * @return false if the file could not be mapped or is not a valid archive
+	 */
+	[[nodiscard]] bool open(const std::filesystem::path &file) noexcept;
+
+	/**
+	 * @return the file named `name`, in O(log n)
+	 */
+	[[nodiscard]] const entry *find(std::string_view name) const noexcept;
+
+	/**
+	 * @return every file, sorted by name
+	 */
+	[[nodiscard]] const std::vector<entry> &entries() const noexcept {
+		return m_entries;
+	}
+
+	/**
+	 * Packs every regular file of `directory` (recursively) into `archive_file`
+	 */
+	[[nodiscard]] static bool pack(const std::filesystem::path &directory, const std::filesystem::path &archive_file) noexcept;
+
+	/**
+	 * Archives shared by the program, opened once for all their users
+	 * @return nullptr if the archive could not be opened
+	 */
+	[[nodiscard]] static std::shared_ptr<const archive> shared(const std::filesystem::path &file) noexcept;
+
+	/**
+	 * Splits a path going through an archive into the path of the archive and the name of the file within it.
+	 * Only path components ending by the archive extension are checked on the file system.
+	 */
+	[[nodiscard]] static std::optional<std::pair<std::filesystem::path, std::string>> split(const std::filesystem::path &path) noexcept;
+
+	/**
+	 * Finds a file designated by a path going through an archive
+	 * @return the archive holding the file (keeping the file's data alive) and the file itself, or nothing
+	 */
+	[[nodiscard]] static std::optional<std::pair<std::shared_ptr<const archive>, const entry *>> lookup(const std::filesystem::path &path) noexcept;
+
+private:
+	mapped_file m_file{};
+	std::vector<entry> m_entries{};
+};
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_ARCHIVE_HPP
@@ -0,0 +1,162 @@
+#ifndef NINJACLOWN_UTILS_BINARY_STREAM_HPP
+#define NINJACLOWN_UTILS_BINARY_STREAM_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace utils {
+
+/**
+ * Writes trivially copyable values to a stream, in native byte order, through a fixed size buffer.
+ * Sizes and indexes are stored on 32 bits.
+ */
+class binary_writer {
+public:
+	static constexpr std::size_t buffer_size = 64 * 1024;
+
+	explicit binary_writer(std::ostream &stream) noexcept
+	    : m_stream{stream} { }
+
+	~binary_writer() {
+		flush();
+	}
+
+	binary_writer(const binary_writer &) = delete;
+	binary_writer &operator=(const binary_writer &) = delete;
+
+	template <typename T>
+	void write(const T &value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		write_bytes(reinterpret_cast<const char *>(&value), sizeof(T)); // NOLINT
+	}
+
+	void write_size(std::size_t value) {
+		write(static_cast<std::uint32_t>(value));
+	}
+
+	void write(std::string_view str) {
+		write_size(str.size());
+		write_bytes(str.data(), str.size());
+	}
+
+	void write(const std::string &str) {
+		write(std::string_view{str});
+	}
+
+	void write_bytes(const char *bytes, std::size_t size) {
+		if (m_used + size > buffer_size) {
+			flush();
+			if (size > buffer_size) {
+				m_stream.write(bytes, static_cast<std::streamsize>(size));
+				return;
+			}
+		}
+		std::memcpy(m_buffer.data() + m_used, bytes, size);
+		m_used += size;
+	}
+
+	/**
+	 * @return false if the stream failed at some point
+	 */
+	bool flush() {
+		if (m_used != 0) {
+			m_stream.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+			m_used = 0;
+		}
+		return static_cast<bool>(m_stream.flush());
+	}
+
+private:
+	std::ostream &m_stream;
+	std::array<char, buffer_size> m_buffer{};
+	std::size_t m_used{0};
+};
+
+/**
+ * Reads values written by a binary_writer from a byte range, failing (once and for all) instead of reading past its end
+ */
+class binary_reader {
+public:
+	explicit binary_reader(std::string_view bytes) noexcept
+	    : m_bytes{bytes} { }
+
+	template <typename T>
+	bool read(T &value) noexcept {
+		static_assert(std::is_trivially_copyable_v<T>);
+		if (!m_ok || m_bytes.size() < sizeof(T)) {
+			return m_ok = false;
+		}
+		std::memcpy(&value, m_bytes.data(), sizeof(T));
+		m_bytes.remove_prefix(sizeof(T));
+		return true;
+	}
+
+	bool read_size(std::size_t &value) noexcept {
+		std::uint32_t value32{};
+		read(value32);
+		value = value32;
+		return m_ok;
+	}
+
+	/**
+	 * Reads a string written by binary_writer::write(std::string_view)
+	 * @return a view on the bytes of the reader
+	 */
+	[[nodiscard]] std::string_view read_string() noexcept {
+		std::size_t size{};
+		read_size(size);
+		return take(size);
+	}
+
+	/**
+	 * @return a view on the next `size` bytes of the reader
+	 */
+	[[nodiscard]] std::string_view take(std::size_t size) noexcept {
+		if (!m_ok || m_bytes.size() < size) {
+			m_ok = false;
+			return {};
+		}
+		std::string_view taken = m_bytes.substr(0, size);
+		m_bytes.remove_prefix(size);
+		return taken;
+	}
+
+	// enumerations are only accepted up to their last value
+	template <typename Enum, typename Raw = std::underlying_type_t<Enum>>
+	bool read_enum(Enum &value, Enum last) noexcept {
+		Raw raw{};
+		if (!read(raw) || raw > static_cast<Raw>(last)) {
+			return m_ok = false;
+		}
+		value = static_cast<Enum>(raw);
+		return true;
+	}
+
+	/**
+	 * Marks the content as invalid
+	 */
+	bool fail() noexcept {
+		return m_ok = false;
+	}
+
+	[[nodiscard]] bool ok() const noexcept {
+		return m_ok;
+	}
+
+	[[nodiscard]] bool at_end() const noexcept {
+		return m_bytes.empty();
+	}
+
+private:
+	std::string_view m_bytes;
+	bool m_ok{true};
+};
+
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_BINARY_STREAM_HPP
@@ -0,0 +1,46 @@
+#ifndef NINJACLOWN_UTILS_DENSE_MAP_HPP
+#define NINJACLOWN_UTILS_DENSE_MAP_HPP
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Map whose keys are small consecutive integers (handles, indexes): values are stored in a vector indexed by key
+ */
+template <typename T>
+class dense_map {
+public:
+	void insert_or_assign(std::size_t key, T value) {
+		if (key >= m_values.size()) {
+			m_values.resize(key + 1);
+		}
+		m_values[key] = std::move(value);
+	}
+
+	void erase(std::size_t key) noexcept {
+		if (key < m_values.size()) {
+			m_values[key].reset();
+		}
+	}
+
+	[[nodiscard]] const T *find(std::size_t key) const noexcept {
+		return key < m_values.size() && m_values[key] ? &*m_values[key] : nullptr;
+	}
+
+	[[nodiscard]] T *find(std::size_t key) noexcept {
+		return key < m_values.size() && m_values[key] ? &*m_values[key] : nullptr;
+	}
+
+	void clear() noexcept {
+		m_values.clear();
+	}
+
+private:
+	std::vector<std::optional<T>> m_values{};
+};
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_DENSE_MAP_HPP
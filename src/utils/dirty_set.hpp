@@ -0,0 +1,77 @@
+#ifndef NINJACLOWN_UTILS_DIRTY_SET_HPP
+#define NINJACLOWN_UTILS_DIRTY_SET_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Set of items identified by a dense index, each item being stored at most once.
+ * Membership is tracked with a bitset, items are kept in insertion order in a compact list.
+ * Clearing is proportional to the amount of stored items, not to the range of indexes.
+ */
+template <typename T>
+class dirty_set {
+	static constexpr std::size_t word_bits = 64;
+
+public:
+	/**
+	 * Preallocates room for indexes in [0 ; index_count)
+	 */
+	void reserve(std::size_t index_count) {
+		if (index_count > m_bits.size() * word_bits) {
+			m_bits.resize((index_count + word_bits - 1) / word_bits, 0u);
+		}
+	}
+
+	/**
+	 * @return true if the item was inserted, false if its index was already marked
+	 */
+	bool insert(std::size_t index, const T &item) {
+		reserve(index + 1);
+
+		std::uint64_t &word      = m_bits[index / word_bits];
+		const std::uint64_t mask = std::uint64_t{1} << (index % word_bits);
+		if ((word & mask) != 0u) {
+			return false;
+		}
+
+		word |= mask;
+		m_items.push_back(item);
+		m_indexes.push_back(index);
+		return true;
+	}
+
+	[[nodiscard]] bool contains(std::size_t index) const noexcept {
+		return index / word_bits < m_bits.size() && (m_bits[index / word_bits] & (std::uint64_t{1} << (index % word_bits))) != 0u;
+	}
+
+	void clear() noexcept {
+		for (std::size_t index : m_indexes) {
+			m_bits[index / word_bits] = 0u;
+		}
+		m_items.clear();
+		m_indexes.clear();
+	}
+
+	[[nodiscard]] const std::vector<T> &items() const noexcept {
+		return m_items;
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept {
+		return m_items.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return m_items.empty();
+	}
+
+private:
+	std::vector<std::uint64_t> m_bits{};
+	std::vector<T> m_items{};
+	std::vector<std::size_t> m_indexes{};
+};
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_DIRTY_SET_HPP
@@ -0,0 +1,22 @@
+#ifndef NINJACLOWN_UTILS_HASH_HPP
+#define NINJACLOWN_UTILS_HASH_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace utils {
+
+/**
+ * 64 bits FNV-1a hash, for content keyed caches (not meant to resist collisions crafted on purpose)
+ */
+[[nodiscard]] constexpr std::uint64_t fnv1a_64(std::string_view bytes, std::uint64_t hash = 0xcbf29ce484222325ull) noexcept { // NOLINT
+	for (char c : bytes) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 0x100000001b3ull; // NOLINT
+	}
+	return hash;
+}
+
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_HASH_HPP
@@ -1,7 +1,168 @@
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/base_sink.h>
+
 #include "utils/logging.hpp"
 #include "utils/optional.hpp"
+#include "utils/rate_limiter.hpp"
 #include "utils/resource_manager.hpp"
 
-std::string_view utils::log::details::log_for(std::string_view key) noexcept {
-	return utils::resource_manager::instance().log_for(key);
+namespace {
+struct key_registry {
+	std::mutex mutex{};
+	std::deque<std::string> keys{}; // deque: interned keys are referenced by `ids` and must not move
+	std::unordered_map<std::string_view, utils::log::key_id> ids{};
+};
+
+key_registry &registry() {
+	static key_registry reg;
+	return reg;
+}
+
+/**
+ * Forwards messages to other sinks, letting through at most a given rate of messages per source (logger name). How many
+ * messages were dropped is reported once the source is allowed to log again.
+ */
+class rate_limited_sink final: public spdlog::sinks::base_sink<std::mutex> {
+public:
+	static constexpr float default_per_second = 1000.f;
+	static constexpr float default_burst      = 2000.f;
+
+	explicit rate_limited_sink(std::vector<spdlog::sink_ptr> sinks) noexcept
+	    : m_sinks{std::move(sinks)} { }
+
+	// sets the limit of `source`, before any message was logged
+	void limit(std::string source, float per_second, float burst) {
+		limiter_for(source) = utils::rate_limiter{per_second, burst};
+	}
+
+protected:
+	void sink_it_(const spdlog::details::log_msg &msg) override {
+		utils::rate_limiter &limiter = limiter_for({msg.logger_name.data(), msg.logger_name.size()});
+		if (!limiter.try_acquire()) {
+			return;
+		}
+		if (unsigned int dropped = limiter.take_dropped(); dropped != 0) {
+			report_dropped(msg, dropped);
+		}
+		forward(msg);
+	}
+
+	void flush_() override {
+		for (const spdlog::sink_ptr &sink : m_sinks) {
+			sink->flush();
+		}
+	}
+
+	void set_pattern_(const std::string &pattern) override {
+		for (const spdlog::sink_ptr &sink : m_sinks) {
+			sink->set_pattern(pattern);
+		}
+	}
+
+	void set_formatter_(std::unique_ptr<spdlog::formatter> formatter) override {
+		for (const spdlog::sink_ptr &sink : m_sinks) {
+			sink->set_formatter(formatter->clone());
+		}
+	}
+
+private:
+	utils::rate_limiter &limiter_for(std::string_view source) {
+		for (auto &[name, limiter] : m_limiters) {
+			if (name == source) {
+				return limiter;
+			}
+		}
+		return m_limiters.emplace_back(std::string{source}, utils::rate_limiter{default_per_second, default_burst}).second;
+	}
+
+	void forward(const spdlog::details::log_msg &msg) {
+		for (const spdlog::sink_ptr &sink : m_sinks) {
+			if (sink->should_log(msg.level)) {
+				sink->log(msg);
+			}
+		}
+	}
+
+	void report_dropped(const spdlog::details::log_msg &msg, unsigned int dropped) {
+		const auto resources       = utils::resource_manager::instance();
+		const std::string_view fmt = resources->log_for("logging.messages_dropped");
+		try {
+			using fmt::literals::operator""_a;
+			const std::string text = fmt::format(fmt, "count"_a = dropped, "source"_a = msg.logger_name);
+			forward(spdlog::details::log_msg{msg.logger_name, spdlog::level::warn, text});
+		}
+		catch (const fmt::format_error &) {
+			forward(spdlog::details::log_msg{msg.logger_name, spdlog::level::warn, "messages dropped"});
+		}
+	}
+
+	std::vector<spdlog::sink_ptr> m_sinks;
+	std::vector<std::pair<std::string, utils::rate_limiter>> m_limiters{}; //! few sources: searched linearly
+};
+} // namespace
+
+utils::log::key_id utils::log::intern(std::string_view key) {
+	key_registry &reg = registry();
+	std::scoped_lock lock{reg.mutex};
+
+	if (auto it = reg.ids.find(key); it != reg.ids.end()) {
+		return it->second;
+	}
+
+	const key_id id{static_cast<std::uint32_t>(reg.keys.size())};
+	reg.keys.emplace_back(key);
+	reg.ids.emplace(reg.keys.back(), id);
+	return id;
+}
+
+void utils::log::make_default_logger_async(std::size_t queue_size, const std::vector<spdlog::sink_ptr> &extra_sinks) {
+	std::shared_ptr<spdlog::logger> sync_logger = spdlog::default_logger();
+
+	std::vector<spdlog::sink_ptr> sinks = sync_logger->sinks();
+	sinks.insert(sinks.end(), extra_sinks.begin(), extra_sinks.end());
+	auto limited = std::make_shared<rate_limited_sink>(std::move(sinks));
+	limited->limit(std::string{bot_source}, 200.f, 400.f); // NOLINT: bots may log up to 200 messages per second, with bursts of 400
+
+	spdlog::init_thread_pool(queue_size, 1);
+	auto async_logger = std::make_shared<spdlog::async_logger>(sync_logger->name(), limited, spdlog::thread_pool(),
+	                                                           spdlog::async_overflow_policy::overrun_oldest);
+	async_logger->set_level(sync_logger->level());
+
+	auto bot_logger = std::make_shared<spdlog::async_logger>(std::string{bot_source}, limited, spdlog::thread_pool(),
+	                                                         spdlog::async_overflow_policy::overrun_oldest);
+	bot_logger->set_level(sync_logger->level());
+
+	spdlog::drop(std::string{bot_source});
+	spdlog::register_logger(bot_logger);
+	spdlog::set_default_logger(std::move(async_logger));
+}
+
+std::shared_ptr<spdlog::logger> utils::log::logger_for(std::string_view source) {
+	if (std::shared_ptr<spdlog::logger> logger = spdlog::get(std::string{source}); logger) {
+		return logger;
+	}
+	return spdlog::default_logger();
+}
+
+utils::log::details::log_text utils::log::details::log_for(std::string_view key) noexcept {
+	std::shared_ptr<const utils::resource_manager> resources = utils::resource_manager::instance();
+	const std::string_view text                             = resources->log_for(key);
+	return {std::move(resources), text};
+}
+
+utils::log::details::log_text utils::log::details::log_for(key_id key) noexcept {
+	std::shared_ptr<const utils::resource_manager> resources = utils::resource_manager::instance();
+	if (const std::string_view text = resources->log_for(key); text.data() != nullptr) {
+		return {std::move(resources), text};
+	}
+
+	// untranslated key: fall back to the key itself, as for string keys
+	key_registry &reg = registry();
+	std::scoped_lock lock{reg.mutex};
+	return {nullptr, reg.keys[key.value]};
 }
@@ -2,42 +2,90 @@
 #define NINJACLOWN_UTILS_LOGGING_HPP
 
 #include <spdlog/spdlog.h>
+#include <cstdint>
+#include <memory>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 namespace utils::log {
+
+/**
+ * Logging key interned to an integer. Hot paths should intern their keys once (eg: in a static local)
+ * to skip the string lookup when logging
+ */
+struct key_id {
+	std::uint32_t value;
+};
+
+/**
+ * @return the id associated to key, creating it if needed. Ids are stable for the whole run (across language reloads)
+ */
+[[nodiscard]] key_id intern(std::string_view key);
+
+//! name of the logger used for messages sent by bots
+constexpr std::string_view bot_source = "bot";
+
+/**
+ * Replaces the default logger by an asynchronous one: messages are formatted by the caller and handed to a
+ * background thread through a bounded queue. When the queue is full, the oldest messages are dropped (logging never blocks).
+ * Also registers a logger for bot_source. Messages are then rate limited by source (logger name) before reaching the sinks
+ * of the former default logger and `extra_sinks`: sinks cannot be added once the background thread runs.
+ */
+void make_default_logger_async(std::size_t queue_size, const std::vector<spdlog::sink_ptr> &extra_sinks);
+
+/**
+ * @return the logger registered for `source`, or the default logger if there is none
+ */
+[[nodiscard]] std::shared_ptr<spdlog::logger> logger_for(std::string_view source);
+
 namespace details {
-	[[nodiscard]] std::string_view log_for(std::string_view key) noexcept;
-}
+	struct log_text {
+		std::shared_ptr<const void> owner; //!< keeps `text` alive (resources may be reloaded meanwhile)
+		std::string_view text;
+	};
+
+	[[nodiscard]] log_text log_for(std::string_view key) noexcept;
+	[[nodiscard]] log_text log_for(key_id key) noexcept;
+
+	template <typename Key, typename... Args>
+	void log(spdlog::level::level_enum level, Key fmt_key, Args &&... args) {
+		spdlog::logger *logger = spdlog::default_logger_raw();
+		if (logger->should_log(level)) {
+			const log_text fmt = log_for(fmt_key);
+			logger->log(level, fmt.text, std::forward<Args>(args)...);
+		}
+	}
+} // namespace details
 
-template <typename... Args>
-void trace(std::string_view fmt_key, Args &&... args) {
-    spdlog::trace(details::log_for(fmt_key), std::forward<Args>(args)...);
+template <typename Key, typename... Args>
+void trace(Key fmt_key, Args &&... args) {
+	details::log(spdlog::level::trace, fmt_key, std::forward<Args>(args)...);
 }
 
-template <typename... Args>
-void debug(std::string_view fmt_key, Args &&... args) {
-    spdlog::debug(details::log_for(fmt_key), std::forward<Args>(args)...);
+template <typename Key, typename... Args>
+void debug(Key fmt_key, Args &&... args) {
+	details::log(spdlog::level::debug, fmt_key, std::forward<Args>(args)...);
 }
 
-template <typename... Args>
-void info(std::string_view fmt_key, Args &&... args) {
-    spdlog::info(details::log_for(fmt_key), std::forward<Args>(args)...);
+template <typename Key, typename... Args>
+void info(Key fmt_key, Args &&... args) {
+	details::log(spdlog::level::info, fmt_key, std::forward<Args>(args)...);
 }
 
-template <typename... Args>
-void warn(std::string_view fmt_key, Args &&... args) {
-    spdlog::warn(details::log_for(fmt_key), std::forward<Args>(args)...);
+template <typename Key, typename... Args>
+void warn(Key fmt_key, Args &&... args) {
+	details::log(spdlog::level::warn, fmt_key, std::forward<Args>(args)...);
 }
 
-template <typename... Args>
-void error(std::string_view fmt_key, Args &&... args) {
-    spdlog::error(details::log_for(fmt_key), std::forward<Args>(args)...);
+template <typename Key, typename... Args>
+void error(Key fmt_key, Args &&... args) {
+	details::log(spdlog::level::err, fmt_key, std::forward<Args>(args)...);
 }
 
-template <typename... Args>
-void critical(std::string_view fmt_key, Args &&... args) {
-    spdlog::critical(details::log_for(fmt_key), std::forward<Args>(args)...);
+template <typename Key, typename... Args>
+void critical(Key fmt_key, Args &&... args) {
+	details::log(spdlog::level::critical, fmt_key, std::forward<Args>(args)...);
 }
 } // namespace utils::log
 
@@ -35,6 +35,13 @@ void utils::loop_per_sec_limit::wait() noexcept {
 	}
 }
 
+void utils::loop_per_sec_limit::idle(std::chrono::milliseconds duration) noexcept {
+	std::this_thread::sleep_for(duration);
+	m_last_tick = std::chrono::system_clock::now();
+	// idle time would otherwise lower the measured lps, and make .wait shorten the loop duration to catch up
+	m_refresh_loop_duration = true;
+}
+
 float utils::loop_per_sec_limit::average_lps() const {
 	using namespace std::chrono; // NOLINT
 	auto display_duration = static_cast<float>(duration_cast<milliseconds>(system_clock::now() - *m_starting_time.acquire()).count());
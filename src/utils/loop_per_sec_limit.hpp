@@ -24,6 +24,10 @@ public:
 	// Do not call this method concurrently with itself or with .start_now
 	void wait() noexcept;
 
+	// Sleeps for `duration` instead of running a loop: the loop is not counted, and the next .wait starts measuring anew
+	// Do not call this method concurrently with .wait or with .start_now
+	void idle(std::chrono::milliseconds duration) noexcept;
+
 	// can be called concurrently with any other method
 	[[nodiscard]] unsigned int loop_count() const {
 		return m_loop_count;
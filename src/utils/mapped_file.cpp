@@ -0,0 +1,148 @@
+#include <utility>
+
+#include "utils/mapped_file.hpp"
+
+#if defined OS_LINUX
+#	include <fcntl.h>    // open
+#	include <sys/mman.h> // mmap, munmap, msync
+#	include <sys/stat.h> // fstat
+#	include <unistd.h>   // close, ftruncate
+#elif defined OS_WINDOWS
+#	include <Windows.h> // CreateFileW, CreateFileMappingW, MapViewOfFile, UnmapViewOfFile, FlushViewOfFile
+#else
+#	error "Unsupported system"
+#endif
+
+namespace {
+#if defined OS_LINUX
+char *map(const std::filesystem::path &file, std::size_t &size, bool create) noexcept {
+	const int fd = create ? ::open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : ::open(file.c_str(), O_RDONLY); // NOLINT
+	if (fd < 0) {
+		return nullptr;
+	}
+
+	if (create) {
+		if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+			::close(fd);
+			return nullptr;
+		}
+	}
+	else {
+		struct stat st {};
+		if (::fstat(fd, &st) != 0) {
+			::close(fd);
+			return nullptr;
+		}
+		size = static_cast<std::size_t>(st.st_size);
+	}
+
+	if (size == 0) {
+		::close(fd);
+		return nullptr;
+	}
+
+	void *ptr = ::mmap(nullptr, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0); // NOLINT
+	::close(fd); // the mapping keeps its own reference to the file
+	if (ptr == MAP_FAILED) { // NOLINT
+		return nullptr;
+	}
+	return static_cast<char *>(ptr);
+}
+#elif defined OS_WINDOWS
+char *map(const std::filesystem::path &file, std::size_t &size, bool create) noexcept {
+	HANDLE handle = CreateFileW(file.c_str(), create ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+	                            create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+
+	if (!create) {
+		LARGE_INTEGER file_size{};
+		if (!GetFileSizeEx(handle, &file_size)) {
+			CloseHandle(handle);
+			return nullptr;
+		}
+		size = static_cast<std::size_t>(file_size.QuadPart);
+	}
+
+	if (size == 0) {
+		CloseHandle(handle);
+		return nullptr;
+	}
+
+	const auto size64 = static_cast<unsigned long long>(size);
+	const auto high   = static_cast<DWORD>(size64 >> 32u);
+	const auto low    = static_cast<DWORD>(size64 & 0xFFFFFFFFu);
+	HANDLE mapping    = CreateFileMappingW(handle, nullptr, create ? PAGE_READWRITE : PAGE_READONLY, high, low, nullptr);
+	CloseHandle(handle);
+	if (mapping == nullptr) {
+		return nullptr;
+	}
+
+	void *ptr = MapViewOfFile(mapping, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+	CloseHandle(mapping); // the view keeps its own reference to the mapping
+	return static_cast<char *>(ptr);
+}
+#endif
+} // namespace
+
+utils::mapped_file::~mapped_file() {
+	close();
+}
+
+utils::mapped_file::mapped_file(mapped_file &&other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)}
+    , m_size{std::exchange(other.m_size, 0)}
+    , m_writable{std::exchange(other.m_writable, false)} { }
+
+utils::mapped_file &utils::mapped_file::operator=(mapped_file &&other) noexcept {
+	if (this != &other) {
+		close();
+		m_data     = std::exchange(other.m_data, nullptr);
+		m_size     = std::exchange(other.m_size, 0);
+		m_writable = std::exchange(other.m_writable, false);
+	}
+	return *this;
+}
+
+bool utils::mapped_file::open(const std::filesystem::path &file) noexcept {
+	close();
+	std::size_t size{0};
+	m_data     = map(file, size, false);
+	m_size     = m_data == nullptr ? 0 : size;
+	m_writable = false;
+	return m_data != nullptr;
+}
+
+bool utils::mapped_file::create(const std::filesystem::path &file, std::size_t size) noexcept {
+	close();
+	m_data     = map(file, size, true);
+	m_size     = m_data == nullptr ? 0 : size;
+	m_writable = m_data != nullptr;
+	return m_data != nullptr;
+}
+
+void utils::mapped_file::flush() noexcept {
+	if (m_data == nullptr || !m_writable) {
+		return;
+	}
+#if defined OS_LINUX
+	::msync(m_data, m_size, MS_ASYNC);
+#elif defined OS_WINDOWS
+	FlushViewOfFile(m_data, m_size);
+#endif
+}
+
+void utils::mapped_file::close() noexcept {
+	if (m_data == nullptr) {
+		return;
+	}
+#if defined OS_LINUX
+	::munmap(m_data, m_size);
+#elif defined OS_WINDOWS
+	UnmapViewOfFile(m_data);
+#endif
+	m_data     = nullptr;
+	m_size     = 0;
+	m_writable = false;
+}
@@ -0,0 +1,71 @@
+#ifndef NINJACLOWN_UTILS_MAPPED_FILE_HPP
+#define NINJACLOWN_UTILS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace utils {
+
+/**
+ * File mapped in memory (mmap / MapViewOfFile). The mapping stays valid until close() or destruction.
+ */
+class mapped_file {
+public:
+	mapped_file() noexcept = default;
+	~mapped_file();
+
+	mapped_file(const mapped_file &) = delete;
+	mapped_file &operator=(const mapped_file &) = delete;
+
+	mapped_file(mapped_file &&other) noexcept;
+	mapped_file &operator=(mapped_file &&other) noexcept;
+
+	/**
+	 * Maps a whole existing file, read only
+	 */
+	[[nodiscard]] bool open(const std::filesystem::path &file) noexcept;
+
+	/**
+	 * Creates (or truncates) a file of `size` bytes, filled with zeroes, and maps it read/write
+	 */
+	[[nodiscard]] bool create(const std::filesystem::path &file, std::size_t size) noexcept;
+
+	/**
+	 * Writes modified pages back to the file (asynchronously when the system allows it)
+	 */
+	void flush() noexcept;
+
+	void close() noexcept;
+
+	explicit operator bool() const noexcept {
+		return m_data != nullptr;
+	}
+
+	[[nodiscard]] const char *data() const noexcept {
+		return m_data;
+	}
+
+	/**
+	 * Only valid for files mapped through `create`
+	 */
+	[[nodiscard]] char *writable_data() noexcept {
+		return m_writable ? m_data : nullptr;
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept {
+		return m_size;
+	}
+
+	[[nodiscard]] std::string_view view() const noexcept {
+		return {m_data, m_size};
+	}
+
+private:
+	char *m_data{nullptr};
+	std::size_t m_size{0};
+	bool m_writable{false};
+};
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_MAPPED_FILE_HPP
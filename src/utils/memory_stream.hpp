@@ -0,0 +1,32 @@
+#ifndef NINJACLOWN_UTILS_MEMORY_STREAM_HPP
+#define NINJACLOWN_UTILS_MEMORY_STREAM_HPP
+
+#include <istream>
+#include <streambuf>
+#include <string_view>
+
+namespace utils {
+
+namespace details {
+	class view_buffer: public std::streambuf {
+	public:
+		explicit view_buffer(std::string_view bytes) noexcept {
+			// std::streambuf never writes through get area pointers
+			char *begin = const_cast<char *>(bytes.data()); // NOLINT
+			setg(begin, begin, begin + bytes.size());
+		}
+	};
+} // namespace details
+
+/**
+ * Input stream reading from memory that it does not own (eg: a mapped file), without copying it
+ */
+class memory_istream: private details::view_buffer, public std::istream {
+public:
+	explicit memory_istream(std::string_view bytes)
+	    : details::view_buffer{bytes}
+	    , std::istream{static_cast<std::streambuf *>(this)} { }
+};
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_MEMORY_STREAM_HPP
@@ -0,0 +1,65 @@
+#include <cstdlib>
+#include <new>
+
+#include "utils/perf_monitor.hpp"
+
+namespace {
+thread_local std::uint64_t allocation_count{0}; // NOLINT
+} // namespace
+
+#ifdef NINJACLOWN_PROFILER
+// Global allocation functions are replaced so that the performance overlay can report heap allocations per tick.
+// Other forms of operator new (array, nothrow) forward to this one by default.
+void *operator new(std::size_t size) {
+	++allocation_count;
+	if (size == 0) {
+		size = 1;
+	}
+
+	while (true) {
+		if (void *ptr = std::malloc(size); ptr != nullptr) { // NOLINT
+			return ptr;
+		}
+
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr) {
+			throw std::bad_alloc{};
+		}
+		handler();
+	}
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr); // NOLINT
+}
+
+void operator delete(void *ptr, std::size_t /* size */) noexcept {
+	std::free(ptr); // NOLINT
+}
+#endif
+
+utils::perf_monitor &utils::perf_monitor::instance() noexcept {
+	static perf_monitor monitor;
+	return monitor;
+}
+
+void utils::perf_monitor::push(metric m, float value) noexcept {
+	if (!is_recording()) {
+		return;
+	}
+
+	auto ring                = m_rings[static_cast<std::size_t>(m)].acquire();
+	ring->values[ring->next] = value;
+	ring->next               = (ring->next + 1) % history_size;
+}
+
+void utils::perf_monitor::history(metric m, history_t &out) const noexcept {
+	auto ring = m_rings[static_cast<std::size_t>(m)].acquire();
+	for (std::size_t i = 0; i < history_size; ++i) {
+		out[i] = ring->values[(ring->next + i) % history_size];
+	}
+}
+
+std::uint64_t utils::thread_allocation_count() noexcept {
+	return allocation_count;
+}
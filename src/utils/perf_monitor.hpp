@@ -0,0 +1,71 @@
+#ifndef NINJACLOWN_UTILS_PERF_MONITOR_HPP
+#define NINJACLOWN_UTILS_PERF_MONITOR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "utils/spinlock.hpp"
+#include "utils/synchronized.hpp"
+
+namespace utils {
+
+/**
+ * Rolling history of per-tick and per-frame metrics, displayed by the performance overlay.
+ * Samples are only kept while recording (ie: while the overlay is shown)
+ */
+class perf_monitor {
+public:
+	enum class metric {
+		tick_time,        // ms, whole model tick
+		bot_think_time,   // ms, bot_think only
+		frame_time,       // ms, view frame, excluding the fps limiter wait
+		collision_tests,  // per tick
+		events_fired,     // per tick
+		dirty_entities,   // per tick
+		dirty_cells,      // per tick
+		heap_allocations, // per tick, model thread only
+		OUTOFRANGE
+	};
+
+	static constexpr std::size_t history_size = 120;
+
+	using history_t = std::array<float, history_size>;
+
+	static perf_monitor &instance() noexcept;
+
+	[[nodiscard]] bool is_recording() const noexcept {
+		return m_recording.load(std::memory_order_relaxed);
+	}
+
+	void set_recording(bool recording) noexcept {
+		m_recording.store(recording, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Appends a sample to the history of a metric. No-op when not recording
+	 */
+	void push(metric m, float value) noexcept;
+
+	/**
+	 * Copies the history of a metric into out, oldest sample first
+	 */
+	void history(metric m, history_t &out) const noexcept;
+
+private:
+	struct ring {
+		history_t values{};
+		std::size_t next{0};
+	};
+
+	std::atomic_bool m_recording{false};
+	std::array<synchronized<ring, spinlock>, static_cast<std::size_t>(metric::OUTOFRANGE)> m_rings;
+};
+
+/**
+ * @return number of calls to operator new made by the calling thread since it started (always 0 if NINJACLOWN_PROFILER is not defined)
+ */
+[[nodiscard]] std::uint64_t thread_allocation_count() noexcept;
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_PERF_MONITOR_HPP
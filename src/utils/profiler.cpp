@@ -0,0 +1,154 @@
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "utils/profiler.hpp"
+
+std::atomic_bool utils::profiler::details::enabled{false}; // NOLINT
+
+namespace {
+struct event {
+	const char *name;
+	std::uint64_t begin_ns;
+	std::uint64_t end_ns;
+};
+
+/**
+ * Ring buffer slot, guarded by a sequence number (seqlock): `sequence` is the index of the event it holds plus one, or
+ * 0 while the event is being written. Events overwritten while being read are skipped.
+ */
+struct slot {
+	std::atomic<std::uint64_t> sequence{0};
+	std::atomic<const char *> name{nullptr};
+	std::atomic<std::uint64_t> begin_ns{0};
+	std::atomic<std::uint64_t> end_ns{0};
+
+	void write(std::uint64_t index, const event &ev) noexcept {
+		sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		name.store(ev.name, std::memory_order_relaxed);
+		begin_ns.store(ev.begin_ns, std::memory_order_relaxed);
+		end_ns.store(ev.end_ns, std::memory_order_relaxed);
+		sequence.store(index + 1, std::memory_order_release);
+	}
+
+	// returns false if the slot does not hold the event `index` (anymore)
+	bool read(std::uint64_t index, event &ev) const noexcept {
+		if (sequence.load(std::memory_order_acquire) != index + 1) {
+			return false;
+		}
+		ev.name     = name.load(std::memory_order_relaxed);
+		ev.begin_ns = begin_ns.load(std::memory_order_relaxed);
+		ev.end_ns   = end_ns.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return sequence.load(std::memory_order_relaxed) == index + 1;
+	}
+};
+
+/**
+ * Single producer ring buffer: only its owning thread writes to it. The exporter reads events up to `written`, possibly
+ * while the owner keeps recording (an event being timed when recording was paused may still be written).
+ */
+struct thread_buffer {
+	explicit thread_buffer(std::uint32_t id) noexcept
+	    : tid{id} { }
+
+	const std::uint32_t tid;
+	std::atomic<std::uint64_t> written{0};
+	std::array<slot, utils::profiler::events_per_thread> slots{};
+};
+
+// buffers are never freed before exit so that events of finished threads can still be exported
+std::mutex buffers_mutex;                            // NOLINT
+std::vector<std::unique_ptr<thread_buffer>> buffers; // NOLINT
+
+// events that began before this instant belong to a previous recording
+std::atomic<std::uint64_t> recording_start_ns{0}; // NOLINT
+
+const auto epoch = std::chrono::steady_clock::now(); // NOLINT
+
+thread_buffer *local_buffer() noexcept {
+	thread_local thread_buffer *buffer = nullptr;
+	if (buffer == nullptr) {
+		try {
+			std::scoped_lock lock{buffers_mutex};
+			buffers.emplace_back(std::make_unique<thread_buffer>(static_cast<std::uint32_t>(buffers.size())));
+			buffer = buffers.back().get();
+		}
+		catch (const std::bad_alloc &) {
+			return nullptr;
+		}
+	}
+	return buffer;
+}
+} // namespace
+
+std::uint64_t utils::profiler::details::now_ns() noexcept {
+	// + 1 : 0 is reserved for "not timed"
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count())
+	       + 1u;
+}
+
+void utils::profiler::details::record(const char *name, std::uint64_t begin_ns, std::uint64_t end_ns) noexcept {
+	thread_buffer *buffer = local_buffer();
+	if (buffer == nullptr) {
+		return;
+	}
+
+	const std::uint64_t index = buffer->written.load(std::memory_order_relaxed);
+	buffer->slots[index % events_per_thread].write(index, {name, begin_ns, end_ns});
+	buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void utils::profiler::set_enabled(bool enabled) noexcept {
+	if (enabled && !is_enabled()) {
+		recording_start_ns.store(details::now_ns());
+	}
+	details::enabled.store(enabled);
+}
+
+bool utils::profiler::export_chrome_trace(const std::filesystem::path &file) noexcept {
+	const bool was_enabled = details::enabled.exchange(false);
+
+	bool success = false;
+	try {
+		std::ofstream out{file};
+		if (out) {
+			const std::uint64_t start = recording_start_ns.load();
+			fmt::memory_buffer buff;
+			fmt::format_to(std::back_inserter(buff), R"({{"displayTimeUnit":"ns","traceEvents":[)");
+
+			bool first = true;
+			std::scoped_lock lock{buffers_mutex};
+			for (const auto &buffer : buffers) {
+				const std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+				const std::uint64_t begin   = written > events_per_thread ? written - events_per_thread : 0u;
+				for (std::uint64_t i = begin; i < written; ++i) {
+					event ev{};
+					if (!buffer->slots[i % events_per_thread].read(i, ev) || ev.begin_ns < start) {
+						continue;
+					}
+					fmt::format_to(std::back_inserter(buff), R"({}{{"name":"{}","cat":"ninja-clown","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+					               first ? "\n" : ",\n", ev.name, buffer->tid, static_cast<double>(ev.begin_ns - start) / 1000.,
+					               static_cast<double>(ev.end_ns - ev.begin_ns) / 1000.);
+					first = false;
+				}
+			}
+			fmt::format_to(std::back_inserter(buff), "\n]}}\n");
+
+			out.write(buff.data(), static_cast<std::streamsize>(buff.size()));
+			success = static_cast<bool>(out);
+		}
+	}
+	catch (const std::exception &) {
+		success = false;
+	}
+
+	details::enabled.store(was_enabled);
+	return success;
+}
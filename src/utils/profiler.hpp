@@ -0,0 +1,79 @@
+#ifndef NINJACLOWN_UTILS_PROFILER_HPP
+#define NINJACLOWN_UTILS_PROFILER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+
+#include "utils/macros.hpp"
+
+/**
+ * Lightweight scoped timers, exported as Chrome trace-event JSON (readable by chrome://tracing and Perfetto).
+ *
+ * Compiled in when NINJACLOWN_PROFILER is defined (see cmake/config.cmake). Recording is off by default ; when disabled,
+ * a timer costs a single relaxed atomic load.
+ */
+namespace utils::profiler {
+
+namespace details {
+	extern std::atomic_bool enabled; // NOLINT
+
+	[[nodiscard]] std::uint64_t now_ns() noexcept;
+
+	// records a complete event in the calling thread’s buffer. Never blocks, never allocates (except on the thread’s first call).
+	// Safe to call while events are exported
+	void record(const char *name, std::uint64_t begin_ns, std::uint64_t end_ns) noexcept;
+} // namespace details
+
+// maximum amount of events kept per thread. Older events are overwritten
+constexpr std::size_t events_per_thread = 1u << 16u;
+
+[[nodiscard]] inline bool is_enabled() noexcept {
+	return details::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Starts or stops recording. Starting a recording discards previously recorded events
+ */
+void set_enabled(bool enabled) noexcept;
+
+/**
+ * Writes every recorded event as Chrome trace-event JSON. Recording is paused while exporting ; events written concurrently
+ * anyway (timers started before the pause) are skipped rather than read half written.
+ * @return false if the file could not be written
+ */
+[[nodiscard]] bool export_chrome_trace(const std::filesystem::path &file) noexcept;
+
+/**
+ * Times the enclosing scope. name must have static storage duration.
+ */
+class scoped_timer {
+public:
+	explicit scoped_timer(const char *name) noexcept
+	    : m_name{name}
+	    , m_begin{is_enabled() ? details::now_ns() : 0u} { }
+
+	scoped_timer(const scoped_timer &) = delete;
+	scoped_timer(scoped_timer &&)      = delete;
+	scoped_timer &operator=(const scoped_timer &) = delete;
+	scoped_timer &operator=(scoped_timer &&) = delete;
+
+	~scoped_timer() {
+		if (m_begin != 0u && is_enabled()) {
+			details::record(m_name, m_begin, details::now_ns());
+		}
+	}
+
+private:
+	const char *m_name;
+	std::uint64_t m_begin;
+};
+} // namespace utils::profiler
+
+#ifdef NINJACLOWN_PROFILER
+#	define NINJACLOWN_PROFILE_SCOPE(name) const ::utils::profiler::scoped_timer NINJACLOWN_MAKE_VAR_NAME{name}
+#else
+#	define NINJACLOWN_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif //NINJACLOWN_UTILS_PROFILER_HPP
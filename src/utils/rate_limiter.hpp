@@ -0,0 +1,55 @@
+#ifndef NINJACLOWN_UTILS_RATE_LIMITER_HPP
+#define NINJACLOWN_UTILS_RATE_LIMITER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace utils {
+
+/**
+ * Token bucket: lets through at most `burst` events at once, refilled at `per_second` events per second.
+ * Not thread safe.
+ */
+class rate_limiter {
+	using clock = std::chrono::steady_clock;
+
+public:
+	rate_limiter(float per_second, float burst) noexcept
+	    : m_per_second{per_second}
+	    , m_burst{burst}
+	    , m_tokens{burst} { }
+
+	/**
+	 * @return true if the event may go through, false if it should be dropped
+	 */
+	[[nodiscard]] bool try_acquire() noexcept {
+		const clock::time_point now = clock::now();
+		m_tokens      = std::min(m_burst, m_tokens + std::chrono::duration<float>(now - m_last_refill).count() * m_per_second);
+		m_last_refill = now;
+
+		if (m_tokens < 1.f) {
+			++m_dropped;
+			return false;
+		}
+		m_tokens -= 1.f;
+		return true;
+	}
+
+	/**
+	 * @return the amount of events dropped since the last call
+	 */
+	[[nodiscard]] unsigned int take_dropped() noexcept {
+		return std::exchange(m_dropped, 0u);
+	}
+
+private:
+	float m_per_second;
+	float m_burst;
+	float m_tokens;
+	unsigned int m_dropped{0};
+	clock::time_point m_last_refill{clock::now()};
+};
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_RATE_LIMITER_HPP
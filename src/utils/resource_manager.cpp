@@ -5,26 +5,113 @@
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
 
+#include "utils/archive.hpp"
 #include "utils/logging.hpp"
+#include "utils/memory_stream.hpp"
 
 #include "utils/resource_manager.hpp"
 #include "utils/resources_type.hpp"
+#include "utils/startup_timings.hpp"
 #include "utils/system.hpp"
+#include "utils/thread_pool.hpp"
 
 using utils::optional;
 using utils::resource_manager;
 
 namespace {
-resource_manager create_and_load_resource_manager() {
-	resource_manager rm;
-	rm.load_config();
-	return rm;
+// resources in use, and reloads in progress
+struct reload_state {
+	// returned by resource_manager::instance(), only accessed through std::atomic_load/store. Replaced resources are freed
+	// once the last thread using them lets go of its handle.
+	std::shared_ptr<resource_manager> current{};
+
+	std::atomic<resource_manager::loading_mode> mode{resource_manager::loading_mode::full};
+	std::atomic_bool initial_loading{false};
+	//! returned by resource_manager::instance() during the initial loading
+	const std::shared_ptr<resource_manager> placeholder{std::make_shared<resource_manager>()};
+
+	std::atomic_bool busy{false}; //!< a reload is in progress, queued, or not published yet
+
+	// guards worker and queued
+	std::mutex control{};
+	std::thread worker{};
+	std::function<bool(resource_manager &)> queued{}; //!< reload requested while the worker was busy
+
+	// written by the worker once done
+	std::mutex mutex{};
+	std::unique_ptr<resource_manager> ready{};
+	std::optional<bool> outcome{};
+
+	~reload_state() {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+};
+
+reload_state &reloads() {
+	static reload_state state;
+	return state;
+}
+
+std::shared_ptr<resource_manager> current_resources(const reload_state &state) noexcept {
+	return std::atomic_load_explicit(&state.current, std::memory_order_acquire);
+}
+
+// state.control must be locked
+bool start_reload_locked(reload_state &state, std::function<bool(resource_manager &)> load) noexcept {
+	try {
+		if (state.worker.joinable()) {
+			state.queued = std::move(load);
+			return true;
+		}
+
+		state.worker = std::thread{[&state, load = std::move(load)]() {
+			std::unique_ptr<resource_manager> next;
+			bool success{false};
+			try {
+				next    = std::make_unique<resource_manager>();
+				success = load(*next);
+			}
+			catch (const std::bad_alloc &) {
+				success = false;
+			}
+
+			std::lock_guard lock{state.mutex};
+			state.outcome = success;
+			if (success) {
+				state.ready = std::move(next);
+			}
+		}};
+	}
+	catch (const std::exception &) {
+		return false;
+	}
+	state.busy.store(true, std::memory_order_release);
+	return true;
+}
+
+bool start_reload(std::function<bool(resource_manager &)> load) noexcept {
+	reload_state &state = reloads();
+	std::lock_guard lock{state.control};
+	return start_reload_locked(state, std::move(load));
 }
 
 std::shared_ptr<cpptoml::table> parse_file(const std::string &path) {
 	try {
+		// files within archives are parsed in place
+		if (auto archived = utils::archive::lookup(path); archived) {
+			utils::memory_istream stream{archived->second->data};
+			return cpptoml::parser{stream}.parse();
+		}
 		return cpptoml::parse_file(path);
 	}
 	catch (const cpptoml::parse_exception &e) {
@@ -151,7 +238,7 @@ namespace config_keys {
 
 } // namespace config_keys
 
-optional<view::animation> load_animation(const std::shared_ptr<cpptoml::table> &anim_config, sf::Texture &texture,
+optional<view::animation> load_animation(const std::shared_ptr<cpptoml::table> &anim_config, const view::texture_atlas::region &texture,
                                          std::string_view anim_type, std::string_view anim_name) {
 	optional<view::animation> ans{};
 
@@ -189,11 +276,26 @@ optional<view::animation> load_animation(const std::shared_ptr<cpptoml::table> &
 
 	view::animation &animation = ans.emplace();
 	for (int i = 0; i < *frame_count; ++i) {
-		animation.add_frame({texture, {*pos_x + *width * i, *pos_y, *width, *height}});
+		animation.add_frame({*texture.texture, {texture.offset.x + *pos_x + *width * i, texture.offset.y + *pos_y, *width, *height}});
 	}
 	return {animation};
 }
 
+// adds the image files overriding the default one within an animation table (tiles, mobs or objects)
+void referenced_images(const std::shared_ptr<cpptoml::table> &anims_config, std::vector<std::string> &files) {
+	auto list = anims_config->get_array_of<std::string>(config_keys::list);
+	if (!list) {
+		return;
+	}
+	for (const std::string &name : *list) {
+		if (auto entry = anims_config->get_table(name); entry) {
+			if (auto file = entry->get_qualified_as<std::string>(config_keys::file); file) {
+				files.emplace_back(std::move(*file));
+			}
+		}
+	}
+}
+
 template <typename T>
 T parse_lang_info_impl(std::filesystem::path &&path) {
 	namespace meta = config_keys::meta;
@@ -250,7 +352,7 @@ T parse_lang_info(std::filesystem::path &&path) {
 resource_manager::resource_pack_info parse_resource_pack_info(std::filesystem::path &&path) {
 	resource_manager::resource_pack_info info;
 	try {
-		std::shared_ptr<cpptoml::table> table = cpptoml::parse_file(path.generic_string());
+		std::shared_ptr<cpptoml::table> table = parse_file(path);
 		info.file                             = std::move(path);
 		if (!table) {
 			return info;
@@ -295,15 +397,39 @@ resource_manager::resource_pack_info parse_resource_pack_info(const std::filesys
 
 } // namespace
 
-static resource_manager static_resource_manager_instance{create_and_load_resource_manager()};
+namespace {
+// calls to resource_manager::instance() made during the initial loading (eg: to log loading errors, possibly from the threads
+// loading resources) get resources without any text nor graphics
+std::shared_ptr<resource_manager> load_initial_resources(reload_state &state) noexcept {
+	if (state.initial_loading.exchange(true)) {
+		std::shared_ptr<resource_manager> current = current_resources(state);
+		return current ? std::move(current) : state.placeholder;
+	}
+
+	const utils::startup::step step{"resources"};
+	auto initial = std::make_shared<resource_manager>();
+	initial->load_config();
+	std::atomic_store_explicit(&state.current, initial, std::memory_order_release);
+	return initial;
+}
+} // namespace
+
+std::shared_ptr<resource_manager> resource_manager::instance() noexcept {
+	reload_state &state = reloads();
+	if (std::shared_ptr<resource_manager> current = current_resources(state); current) {
+		return current;
+	}
+	return load_initial_resources(state);
+}
 
-resource_manager &resource_manager::instance() noexcept {
-	return static_resource_manager_instance;
+void resource_manager::set_loading_mode(loading_mode mode) noexcept {
+	reloads().mode.store(mode);
 }
 
 bool resource_manager::load_config() noexcept {
+	namespace user = config_keys::user;
 
-	auto log_warn = [this]() {
+	auto log_warn = []() {
 		spdlog::warn("State holder failed to load resource resources from file \"{}\".", CONFIG_FILE);
 	};
 
@@ -313,29 +439,119 @@ bool resource_manager::load_config() noexcept {
 		return false;
 	}
 
-	auto resource_pack = config->get_qualified_as<std::string>(config_keys::graphics_resource_file);
-	if (!resource_pack) {
+	selection selected;
+	if (auto resource_pack = config->get_qualified_as<std::string>(config_keys::graphics_resource_file); resource_pack) {
+		selected.resource_pack = *resource_pack;
+	}
+	else {
 		spdlog::error("No resource pack specified in config file");
 		log_warn();
 		return false;
 	}
 
-	auto graphics = parse_file(*resource_pack);
-	if (!graphics) {
-		spdlog::error("Failed to load graphics from config file");
+	auto lang_config = config->get_table(user::main_table);
+	if (!lang_config) {
+		spdlog::error("{}: \"{}\" {}", error_msgs::loading_failed, user::main_table, error_msgs::missing_table);
 		log_warn();
 		return false;
 	}
-	m_user_resource_pack = parse_resource_pack_info(*resource_pack);
-	if (!(load_graphics(graphics, std::filesystem::path{*resource_pack}.parent_path()) && load_texts(config))) {
-		spdlog::error("Failed to load graphics from resource pack or texts from translation files");
+
+	auto general_lang = lang_config->get_qualified_as<std::string>(user::general_lang);
+	if (!general_lang) {
+		spdlog::error(R"({}: "{}.{}" {})", error_msgs::loading_failed, user::main_table, user::general_lang, error_msgs::missing_key);
 		log_warn();
 		return false;
 	}
 
+	// other languages default to the general one, relative paths are relative to the lang folder
+	const std::filesystem::path lang_directory = utils::resources_directory() / lang_folder;
+	auto lang_file = [&](const char *key) {
+		std::filesystem::path file{lang_config->get_qualified_as<std::string>(key).value_or(*general_lang)};
+		return file.is_relative() ? lang_directory / file : file;
+	};
+	selected.general_lang = lang_file(user::general_lang);
+	selected.command_lang = lang_file(user::commands_lang);
+	selected.gui_lang     = lang_file(user::gui_lang);
+	selected.log_lang     = lang_file(user::log_lang);
+
+	if (!load(selected)) {
+		log_warn();
+		return false;
+	}
 	return true;
 }
 
+bool resource_manager::load(const selection &selected) noexcept {
+	m_user_resource_pack = parse_resource_pack_info(std::filesystem::path{selected.resource_pack});
+
+	// every part fills its own members: they are loaded concurrently
+	std::vector<std::function<bool()>> parts;
+	try {
+		if (reloads().mode.load() == loading_mode::full) {
+			parts.emplace_back([&] {
+				const startup::step step{"resources: graphics"};
+				return load_resource_pack(selected.resource_pack);
+			});
+		}
+		parts.emplace_back([&] {
+			const startup::step step{"resources: language information"};
+			m_user_general_lang = parse_lang_info<lang_info>(selected.general_lang);
+			return true;
+		});
+		parts.emplace_back([&] {
+			const startup::step step{"resources: command texts"};
+			m_user_command_lang.file = selected.command_lang;
+			auto file                = parse_file(selected.command_lang);
+			return file && load_command_texts(file);
+		});
+		parts.emplace_back([&] {
+			const startup::step step{"resources: gui texts"};
+			m_user_gui_lang.file = selected.gui_lang;
+			auto file            = parse_file(selected.gui_lang);
+			return file && load_gui_texts(file);
+		});
+		parts.emplace_back([&] {
+			// tooltips are part of the log language file
+			const startup::step step{"resources: log and tooltip texts"};
+			m_user_log_lang.file = selected.log_lang;
+			auto file            = parse_file(selected.log_lang);
+			return file && load_logging_texts(file) && load_tooltip_texts(file);
+		});
+	}
+	catch (const std::bad_alloc &) {
+		return false;
+	}
+
+	std::vector<char> loaded(parts.size(), false);
+	thread_pool::instance().parallel_for(parts.size(), 1, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			loaded[i] = parts[i]();
+		}
+	});
+	++m_tooltip_texts_version;
+
+	if (std::find(loaded.begin(), loaded.end(), false) != loaded.end()) {
+		spdlog::error("Failed to load graphics from resource pack or texts from translation files");
+		return false;
+	}
+	return true;
+}
+
+bool resource_manager::load_resource_pack(const std::filesystem::path &file) noexcept {
+	// keeps the resource pack's archive (if any) opened while loading its textures
+	auto pinned_archive = archive::lookup(file);
+	auto graphics       = parse_file(file);
+	if (!graphics) {
+		spdlog::error("Failed to load graphics from config file");
+		return false;
+	}
+	return load_graphics(graphics, file.parent_path());
+}
+
+resource_manager::selection resource_manager::user_selection() const {
+	return {m_user_general_lang.file, m_user_command_lang.file, m_user_gui_lang.file, m_user_log_lang.file, m_user_resource_pack.file};
+}
+
 optional<const view::animation &> resource_manager::tile_animation(resources_type::tile_id tile) const noexcept {
 	auto it = m_tiles_anims.find(tile);
 	if (it == m_tiles_anims.end()) {
@@ -376,6 +592,13 @@ std::string_view resource_manager::log_for(std::string_view key) const noexcept
 	return key;
 }
 
+std::string_view resource_manager::log_for(log::key_id key) const noexcept {
+	if (key.value < m_log_strings_by_id.size()) {
+		return m_log_strings_by_id[key.value];
+	}
+	return {};
+}
+
 std::string_view resource_manager::tooltip_for(std::string_view key) const noexcept {
 	auto it = m_tooltip_strings.find(key);
 	if (it != m_tooltip_strings.end()) {
@@ -394,7 +617,7 @@ std::string_view resource_manager::gui_text_for(std::string_view key) const noex
 
 bool resource_manager::load_graphics(std::shared_ptr<cpptoml::table> config, const std::filesystem::path &resourcepack_directory) noexcept {
 	assert(m_textures_by_file.empty());
-	assert(m_textures_holder.empty());
+	assert(m_atlas.page_count() == 0);
 	assert(m_tiles_anims.empty());
 	assert(m_objects_anims.empty());
 	assert(m_mobs_anims.empty());
@@ -434,6 +657,14 @@ bool resource_manager::load_graphics(std::shared_ptr<cpptoml::table> config, con
 		return false;
 	}
 
+	std::vector<std::string> image_files{graphics_file};
+	referenced_images(tiles_config, image_files);
+	referenced_images(mobs_config, image_files);
+	referenced_images(objects_config, image_files);
+	if (!load_images(std::move(image_files))) {
+		return false;
+	}
+
 	bool success = load_tiles_anims(tiles_config, graphics_file);
 	success      = load_mobs_anims(mobs_config, graphics_file) && success;
 	success      = load_objects_anims(objects_config, graphics_file) && success;
@@ -467,7 +698,7 @@ bool resource_manager::load_mobs_anims(const std::shared_ptr<cpptoml::table> &mo
 			continue;
 		}
 
-		sf::Texture *texture = get_texture(current_mob->get_qualified_as<std::string>(config_keys::file).value_or(graph_file));
+		const view::texture_atlas::region *texture = get_texture(current_mob->get_qualified_as<std::string>(config_keys::file).value_or(graph_file));
 		if (texture == nullptr) {
 			success = false;
 			continue;
@@ -513,7 +744,8 @@ bool resource_manager::load_mobs_anims(const std::shared_ptr<cpptoml::table> &mo
 }
 
 bool resource_manager::load_mob_anim(const std::shared_ptr<cpptoml::table> &mob_anim_config, std::string_view mob_name,
-                                     view::facing_direction::type dir, view::mob_animations &anims, sf::Texture &texture) noexcept {
+                                     view::facing_direction::type dir, view::mob_animations &anims,
+                                     const view::texture_atlas::region &texture) noexcept {
 	auto anim = load_animation(mob_anim_config, texture, config_keys::mobs::anims, mob_name);
 	if (!anim) {
 		return false;
@@ -618,7 +850,7 @@ bool resource_manager::load_tiles_anims(const std::shared_ptr<cpptoml::table> &t
 			continue;
 		}
 
-		sf::Texture *texture = get_texture(current_tile->get_qualified_as<std::string>(config_keys::file).value_or(graph_file));
+		const view::texture_atlas::region *texture = get_texture(current_tile->get_qualified_as<std::string>(config_keys::file).value_or(graph_file));
 		if (texture == nullptr) {
 			success = false;
 			continue;
@@ -626,7 +858,7 @@ bool resource_manager::load_tiles_anims(const std::shared_ptr<cpptoml::table> &t
 
 		view::animation animation;
 		for (int i = 0; i < *frame_count; ++i) {
-			animation.add_frame({*texture, {*pos_x + *width * i, *pos_y, *width, *height}});
+			animation.add_frame({*texture->texture, {texture->offset.x + *pos_x + *width * i, texture->offset.y + *pos_y, *width, *height}});
 		}
 		m_tiles_anims.emplace(static_cast<resources_type::tile_id>(*id), std::move(animation));
 	}
@@ -696,7 +928,7 @@ bool resource_manager::load_objects_anims(const std::shared_ptr<cpptoml::table>
 			continue;
 		}
 
-		sf::Texture *texture = get_texture(current_object->get_qualified_as<std::string>(config_keys::file).value_or(graph_file));
+		const view::texture_atlas::region *texture = get_texture(current_object->get_qualified_as<std::string>(config_keys::file).value_or(graph_file));
 		if (texture == nullptr) {
 			success = false;
 			continue;
@@ -707,7 +939,7 @@ bool resource_manager::load_objects_anims(const std::shared_ptr<cpptoml::table>
 
 		view::shifted_animation animation;
 		for (int i = 0; i < *frame_count; ++i) {
-			animation.add_frame({*texture, {*pos_x + *width * i, *pos_y, *width, *height}});
+			animation.add_frame({*texture->texture, {texture->offset.x + *pos_x + *width * i, texture->offset.y + *pos_y, *width, *height}});
 		}
 		animation.set_shift(static_cast<float>(xshift.value_or(0)), static_cast<float>(yshift.value_or(0)));
 		m_objects_anims.emplace(static_cast<resources_type::object_id>(*id), std::move(animation));
@@ -715,72 +947,6 @@ bool resource_manager::load_objects_anims(const std::shared_ptr<cpptoml::table>
 	return success;
 }
 
-bool resource_manager::load_texts(const std::shared_ptr<cpptoml::table> &config) noexcept {
-	namespace user = config_keys::user;
-
-	auto lang_config = config->get_table(config_keys::user::main_table);
-	if (!lang_config) {
-		spdlog::error("{}: \"{}\" {}", error_msgs::loading_failed, user::main_table, error_msgs::missing_table);
-		return false;
-	}
-
-	auto general_lang  = lang_config->get_qualified_as<std::string>(user::general_lang);
-	auto commands_lang = lang_config->get_qualified_as<std::string>(user::commands_lang);
-	auto gui_lang      = lang_config->get_qualified_as<std::string>(user::gui_lang);
-	auto log_lang      = lang_config->get_qualified_as<std::string>(user::log_lang);
-
-	if (!general_lang) {
-		spdlog::error(R"({}: "{}.{}" {})", error_msgs::loading_failed, user::main_table, user::general_lang, error_msgs::missing_key);
-		return false;
-	}
-
-	std::filesystem::path res_dir = utils::resources_directory();
-	{
-		std::filesystem::path gen_lang_path(*general_lang);
-		if (gen_lang_path.is_relative()) {
-			m_user_general_lang = parse_lang_info<lang_info>(res_dir / lang_folder / gen_lang_path);
-		}
-		else {
-			m_user_general_lang = parse_lang_info<lang_info>(gen_lang_path);
-		}
-	}
-
-	auto parse = [&general_lang, &res_dir](cpptoml::option<std::string> &to_parse, lang_info &related_info) {
-		if (!to_parse) {
-			to_parse = general_lang;
-		}
-		std::filesystem::path as_path{*to_parse};
-		if (as_path.is_relative()) {
-			related_info.file = res_dir / lang_folder / as_path;
-		}
-		else {
-			related_info.file = std::move(as_path);
-		}
-		return parse_file(related_info.file);
-	};
-
-	std::shared_ptr<cpptoml::table> log_text_file = parse(log_lang, m_user_log_lang);
-	if (!log_text_file) {
-		return false;
-	}
-
-	std::shared_ptr<cpptoml::table> commands_text_file = parse(commands_lang, m_user_command_lang);
-	if (!commands_text_file) {
-		return false;
-	}
-
-	std::shared_ptr<cpptoml::table> gui_text_file = parse(gui_lang, m_user_gui_lang);
-	if (!gui_text_file) {
-		return false;
-	}
-
-	bool success = load_logging_texts(log_text_file);
-	success      = load_tooltip_texts(log_text_file) && success;
-	success      = load_command_texts(commands_text_file) && success;
-	success      = load_gui_texts(gui_text_file) && success;
-	return success;
-}
-
 bool resource_manager::load_command_texts(const std::shared_ptr<cpptoml::table> &lang_file) noexcept {
 	namespace cmds = config_keys::lang::internal::commands;
 
@@ -840,7 +1006,28 @@ bool resource_manager::load_logging_texts(const std::shared_ptr<cpptoml::table>
 	m_user_log_lang.map_name  = try_read(config_keys::meta::maps_to);
 
 	std::shared_ptr<cpptoml::table_array> logs = lang_file->get_table_array_qualified(log_ns::main_name);
-	return generic_load_keyed_texts(logs, log_ns::id, log_ns::text, m_log_strings, m_log_string_keys);
+	if (!generic_load_keyed_texts(logs, log_ns::id, log_ns::text, m_log_strings, m_log_string_keys)) {
+		return false;
+	}
+
+	try {
+		index_logging_texts();
+	}
+	catch (const std::bad_alloc &) {
+		return false;
+	}
+	return true;
+}
+
+void resource_manager::index_logging_texts() {
+	m_log_strings_by_id.clear();
+	for (const auto &[key, text] : m_log_strings) {
+		const log::key_id id = log::intern(key);
+		if (id.value >= m_log_strings_by_id.size()) {
+			m_log_strings_by_id.resize(id.value + 1);
+		}
+		m_log_strings_by_id[id.value] = text;
+	}
 }
 
 bool resource_manager::load_tooltip_texts(const std::shared_ptr<cpptoml::table> &lang_file) noexcept {
@@ -869,22 +1056,53 @@ bool resource_manager::load_gui_texts(const std::shared_ptr<cpptoml::table> &gui
 	return generic_load_keyed_texts(gui_strings, gui_ns::id, gui_ns::text, m_gui_strings, m_gui_string_keys);
 }
 
-sf::Texture *resource_manager::get_texture(const std::string &file) noexcept {
-	auto it = m_textures_by_file.find(file);
-	if (it != m_textures_by_file.end()) {
-		return it->second;
+bool resource_manager::load_images(std::vector<std::string> files) noexcept {
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+
+	// sf::Image only decodes on the CPU: unlike textures, images can be loaded from any thread
+	std::vector<sf::Image> images(files.size());
+	std::vector<char> decoded(files.size(), false);
+	thread_pool::instance().parallel_for(files.size(), 1, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			if (auto archived = archive::lookup(files[i]); archived) {
+				decoded[i] = images[i].loadFromMemory(archived->second->data.data(), archived->second->data.size());
+			}
+			else {
+				decoded[i] = images[i].loadFromFile(files[i]);
+			}
+		}
+	});
+
+	std::vector<const sf::Image *> packed_images;
+	std::vector<const std::string *> packed_files;
+	for (std::size_t i = 0; i < files.size(); ++i) {
+		if (decoded[i]) {
+			packed_images.push_back(&images[i]);
+			packed_files.push_back(&files[i]);
+		}
+		else {
+			spdlog::error("{}: \"{}\": {}", error_msgs::loading_failed, files[i], error_msgs::bad_image_file);
+		}
 	}
 
-	m_textures_holder.emplace_front();
-	sf::Texture *texture = &m_textures_holder.front();
-	if (!texture->loadFromFile(file)) {
-		m_textures_holder.pop_front();
-		spdlog::error("{}: \"{}\": {}", error_msgs::loading_failed, file, error_msgs::bad_image_file);
-		return nullptr;
+	std::vector<view::texture_atlas::region> regions = m_atlas.build(packed_images);
+	if (regions.size() != packed_images.size()) {
+		spdlog::error("{}: texture atlas", error_msgs::loading_failed);
+		return false;
 	}
+	for (std::size_t i = 0; i < regions.size(); ++i) {
+		m_textures_by_file.emplace(*packed_files[i], regions[i]);
+	}
+	return true;
+}
 
-	m_textures_by_file.emplace(file, texture);
-	return texture;
+const view::texture_atlas::region *resource_manager::get_texture(const std::string &file) const noexcept {
+	auto it = m_textures_by_file.find(file);
+	if (it == m_textures_by_file.end()) {
+		return nullptr;
+	}
+	return &it->second;
 }
 
 bool resource_manager::generic_load_keyed_texts(const std::shared_ptr<cpptoml::table_array> &table_array, const char *id_key,
@@ -952,19 +1170,27 @@ void resource_manager::refresh_language_list() {
 	if (language_directories.empty()) {
 		return;
 	}
-	m_available_langs.clear();
-
 	namespace fs = std::filesystem;
 
+	std::vector<fs::path> lang_files;
 	for (const fs::path &directory : language_directories) {
 		for (const fs::directory_entry &file : fs::directory_iterator{directory}) {
 			const fs::path &file_path = file.path();
 			if (file.is_regular_file() && file_path.extension() == lang_file_ext) {
-				m_available_langs.emplace_back(parse_lang_info<lang_info>(file_path));
+				lang_files.push_back(file_path);
 			}
 		}
 	}
 
+	// every language file is parsed as a whole
+	m_available_langs.clear();
+	m_available_langs.resize(lang_files.size());
+	thread_pool::instance().parallel_for(lang_files.size(), 1, [this, &lang_files](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			m_available_langs[i] = parse_lang_info<lang_info>(lang_files[i]);
+		}
+	});
+
 	std::sort(m_available_langs.begin(), m_available_langs.end(), [](const lang_info &lhs, const lang_info &rhs) {
 		return lhs.name < rhs.name;
 	});
@@ -974,12 +1200,17 @@ void resource_manager::refresh_resource_pack_list() {
 	m_resource_packs.clear();
 	try {
 		for (const auto &entry : std::filesystem::directory_iterator{resources_directory() / resource_pack_folder}) {
-			if (!entry.is_directory()) {
-				continue;
-			}
 			std::filesystem::path toml_path = entry.path() / resource_pack_toml_name;
-			if (std::filesystem::is_regular_file(toml_path)) {
-				m_resource_packs.emplace_back(parse_resource_pack_info(toml_path));
+			if (entry.is_directory()) {
+				if (std::filesystem::is_regular_file(toml_path)) {
+					m_resource_packs.emplace_back(parse_resource_pack_info(toml_path));
+				}
+			}
+			else if (entry.path().extension() == archive::extension) {
+				std::shared_ptr<const archive> pack = archive::shared(entry.path());
+				if (pack && pack->find(resource_pack_toml_name) != nullptr) {
+					m_resource_packs.emplace_back(parse_resource_pack_info(toml_path));
+				}
 			}
 		}
 	}
@@ -988,96 +1219,57 @@ void resource_manager::refresh_resource_pack_list() {
 	}
 }
 
-void resource_manager::set_user_general_lang(const lang_info &lang) noexcept {
-	m_user_general_lang = lang; // todo : sans effet
+bool resource_manager::reload_async() noexcept {
+	return start_reload([](resource_manager &next) { return next.load_config(); });
 }
 
-// TODO : mettre les trois "set_user_*_lang" fonctions ensemble
-void resource_manager::set_user_command_lang(const lang_info &lang) noexcept {
-	try {
-		std::unordered_map<command_id, std::pair<std::string, std::string>> str_backup;
-		std::swap(str_backup, m_commands_strings);
-
-		std::shared_ptr<cpptoml::table> config = cpptoml::parse_file(lang.file.generic_string());
-		if (!config || !load_command_texts(config)) {
-			std::swap(str_backup, m_commands_strings);
-			spdlog::warn(log_for("resource_manager.commands_texts.reload_failed"));
-		}
-		m_user_command_lang.file = lang.file;
-	}
-	catch (const std::exception &e) {
-		spdlog::error("{}", e.what());
-	}
+bool resource_manager::reload_async(selection selected) noexcept {
+	return start_reload([selected = std::move(selected)](resource_manager &next) { return next.load(selected); });
 }
 
-void resource_manager::set_user_gui_lang(const lang_info &lang) noexcept {
-	try {
-		std::unordered_map<std::string_view, std::string> str_backup;
-		std::vector<std::string> keys_backup;
-		std::swap(str_backup, m_gui_strings);
-		std::swap(keys_backup, m_gui_string_keys);
-
-		std::shared_ptr<cpptoml::table> config = cpptoml::parse_file(lang.file.generic_string());
-		if (!config || !load_gui_texts(config)) {
-			std::swap(str_backup, m_gui_strings);
-			std::swap(keys_backup, m_gui_string_keys);
-			spdlog::warn(log_for("resource_manager.gui_texts.reload_failed"));
-		}
-		m_user_gui_lang.file = lang.file;
-	}
-	catch (const std::exception &e) {
-		spdlog::error("{}", e.what());
-	}
+bool resource_manager::reloading() noexcept {
+	return reloads().busy.load(std::memory_order_acquire);
 }
 
-void resource_manager::set_user_log_lang(const lang_info &lang) noexcept {
-	try {
-		std::unordered_map<std::string_view, std::string> str_backup;
-		std::vector<std::string> keys_backup;
-		std::swap(str_backup, m_log_strings);
-		std::swap(keys_backup, m_log_string_keys);
-
-		std::shared_ptr<cpptoml::table> config = cpptoml::parse_file(lang.file.generic_string());
-		if (!config || !load_logging_texts(config)) {
-			std::swap(str_backup, m_log_strings);
-			std::swap(keys_backup, m_log_string_keys);
-			spdlog::warn(log_for("resource_manger.log_texts.reload_failed"));
-		}
-		m_user_log_lang.file = lang.file;
+std::optional<bool> resource_manager::publish_reload() noexcept {
+	reload_state &state = reloads();
+
+	std::optional<bool> outcome;
+	std::unique_ptr<resource_manager> next;
+	{
+		std::lock_guard lock{state.mutex};
+		outcome = std::exchange(state.outcome, std::nullopt);
+		next    = std::move(state.ready);
 	}
-	catch (const std::exception &e) {
-		spdlog::error("{}", e.what());
+	if (!outcome) {
+		return {};
 	}
-}
-
-void resource_manager::set_user_resource_pack(const resource_pack_info &res_pack) noexcept {
 
-	std::unordered_map<std::string, sf::Texture *> textures_by_file_backup{};
-	std::forward_list<sf::Texture> textures_holder_backup{};
-	std::unordered_map<resources_type::tile_id, view::animation> tiles_anims_backup{};
-	std::unordered_map<resources_type::object_id, view::shifted_animation> objects_anims_backup{};
-	std::unordered_map<resources_type::mob_id, view::mob_animations> mobs_anims_backup{};
-	std::swap(textures_by_file_backup, m_textures_by_file);
-	std::swap(textures_holder_backup, m_textures_holder);
-	std::swap(tiles_anims_backup, m_tiles_anims);
-	std::swap(objects_anims_backup, m_objects_anims);
-	std::swap(mobs_anims_backup, m_mobs_anims);
+	std::lock_guard lock{state.control};
+	state.worker.join();
 
-	std::shared_ptr<cpptoml::table> toml = parse_file(res_pack.file);
-	if (toml && load_graphics(toml, res_pack.file.parent_path())) {
-		m_user_resource_pack = res_pack;
+	if (next) {
+		// state that is not loaded from files is carried over. It is copied, as the previous resources may still be in use.
+		if (std::shared_ptr<const resource_manager> previous = current_resources(state); previous) {
+			try {
+				next->m_available_langs = previous->m_available_langs;
+				next->m_resource_packs  = previous->m_resource_packs;
+			}
+			catch (const std::bad_alloc &) {
+				// lists are refreshed when the configurator opens
+			}
+			next->m_tooltip_texts_version = previous->m_tooltip_texts_version + 1;
+		}
+		std::atomic_store_explicit(&state.current, std::shared_ptr<resource_manager>{std::move(next)}, std::memory_order_release);
 	}
-	else {
-		std::swap(textures_by_file_backup, m_textures_by_file);
-		std::swap(textures_holder_backup, m_textures_holder);
-		std::swap(tiles_anims_backup, m_tiles_anims);
-		std::swap(objects_anims_backup, m_objects_anims);
-		std::swap(mobs_anims_backup, m_mobs_anims);
-		spdlog::warn(log_for("resource_manager.resource_pack.reload_failed"));
+
+	if (!state.queued || !start_reload_locked(state, std::exchange(state.queued, nullptr))) {
+		state.busy.store(false, std::memory_order_release);
 	}
+	return outcome;
 }
 
-bool resource_manager::save_user_config() const noexcept {
+bool resource_manager::save_config(const selection &selected) noexcept {
 	using namespace fmt::literals;
 	namespace uk   = config_keys::user;
 	namespace uknq = config_keys::user::non_qualified;
@@ -1085,14 +1277,14 @@ bool resource_manager::save_user_config() const noexcept {
 	std::filesystem::path config_file = utils::config_directory() / CONFIG_FILE;
 
 	std::shared_ptr<cpptoml::table> lang_config = cpptoml::make_table();
-	lang_config->insert(uknq::general_lang, m_user_general_lang.file.generic_string());
-	lang_config->insert(uknq::commands_lang, m_user_command_lang.file.generic_string());
-	lang_config->insert(uknq::gui_lang, m_user_gui_lang.file.generic_string());
-	lang_config->insert(uknq::log_lang, m_user_log_lang.file.generic_string());
+	lang_config->insert(uknq::general_lang, selected.general_lang.generic_string());
+	lang_config->insert(uknq::commands_lang, selected.command_lang.generic_string());
+	lang_config->insert(uknq::gui_lang, selected.gui_lang.generic_string());
+	lang_config->insert(uknq::log_lang, selected.log_lang.generic_string());
 
 	std::shared_ptr<cpptoml::table> config = cpptoml::make_table();
 	config->insert(uk::lang_table, lang_config);
-	config->insert(config_keys::unqualified_graph_res_file, m_user_resource_pack.file.generic_string());
+	config->insert(config_keys::unqualified_graph_res_file, selected.resource_pack.generic_string());
 
 	std::ofstream ofs(config_file, std::ios_base::trunc | std::ios_base::out);
 	if (!ofs) {
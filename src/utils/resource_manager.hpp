@@ -2,7 +2,8 @@
 #define NINJACLOWN_UTILS_RESOURCE_MANAGER_HPP
 
 #include <filesystem>
-#include <forward_list>
+#include <memory>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
@@ -16,9 +17,14 @@
 
 #include "view/assets/animation.hpp"
 #include "view/assets/mob_animations.hpp"
+#include "view/assets/texture_atlas.hpp"
 
 namespace utils {
 
+namespace log {
+	struct key_id;
+}
+
 namespace resources_type {
 	enum class mob_id;
 
@@ -58,7 +64,25 @@ class resource_manager {
 
 public:
 
-	static resource_manager& instance() noexcept;
+	/**
+	 * Resources loaded on the first call to instance()
+	 */
+	enum class loading_mode {
+		full,
+		headless, //!< no graphics, for programs that never open a window (tools, tests)
+	};
+
+	/**
+	 * Resources are loaded on the first call, with graphics, texts of every kind and language information loaded concurrently.
+	 * References and string_views obtained from the returned resources stay valid as long as the handle is kept, even if
+	 * a reload is published in the meantime.
+	 */
+	static std::shared_ptr<resource_manager> instance() noexcept;
+
+	/**
+	 * To be called before the first call to instance(). Also applies to reloads.
+	 */
+	static void set_loading_mode(loading_mode mode) noexcept;
 
 	struct resource_pack_info {
 		std::string default_name;
@@ -66,16 +90,51 @@ public:
 		std::filesystem::path file;
 	};
 
+	/**
+	 * Files resources are loaded from
+	 */
+	struct selection {
+		std::filesystem::path general_lang;
+		std::filesystem::path command_lang;
+		std::filesystem::path gui_lang;
+		std::filesystem::path log_lang;
+		std::filesystem::path resource_pack;
+	};
+
 	bool load_config() noexcept;
 
-	[[nodiscard]] bool reload() noexcept {
-		resource_manager new_config{};
-		if (new_config.load_config()) {
-			*this = std::move(new_config);
-			return true;
-		}
-		return false;
-	}
+	bool load(const selection &selected) noexcept;
+
+	/**
+	 * @return the files the current resources were loaded from
+	 */
+	[[nodiscard]] selection user_selection() const;
+
+	/**
+	 * Loads a new set of resources from the config file on a worker thread. They replace the current ones once published
+	 * (see publish_reload): the resource manager in use is never modified.
+	 * If a reload is already in progress, this one starts once the former is published, replacing any reload queued before.
+	 * @return false if the worker thread could not be started
+	 */
+	static bool reload_async() noexcept;
+
+	/**
+	 * Same as reload_async(), loading resources from `selected` rather than from the config file
+	 */
+	static bool reload_async(selection selected) noexcept;
+
+	/**
+	 * @return true if resources are being loaded or queued for loading, or were loaded but not published yet
+	 */
+	[[nodiscard]] static bool reloading() noexcept;
+
+	/**
+	 * To be called by the rendering thread between two frames. Publishes resources loaded by reload_async, if any. Replaced
+	 * resources are freed once every handle to them was released.
+	 * Sprites referring to the previous resources must be reloaded when a reload was published.
+	 * @return nothing if no reload completed since the last call, otherwise whether the reload succeeded
+	 */
+	static std::optional<bool> publish_reload() noexcept;
 
 	[[nodiscard]] utils::optional<const view::animation &> tile_animation(resources_type::tile_id) const noexcept;
 
@@ -87,10 +146,22 @@ public:
 
 	[[nodiscard]] std::string_view log_for(std::string_view key) const noexcept;
 
+	/**
+	 * @return the logging text for an interned key, or an empty string_view with a null data pointer if there is none
+	 */
+	[[nodiscard]] std::string_view log_for(log::key_id key) const noexcept;
+
 	[[nodiscard]] std::string_view tooltip_for(std::string_view key) const noexcept;
 
 	[[nodiscard]] std::string_view gui_text_for(std::string_view key) const noexcept;
 
+	/**
+	 * @return a value that changes every time tooltip texts are reloaded
+	 */
+	[[nodiscard]] unsigned int tooltip_texts_version() const noexcept {
+		return m_tooltip_texts_version;
+	}
+
 	[[nodiscard]] const tiles_infos_t &tiles_infos() const noexcept {
 		return m_tiles_infos;
 	}
@@ -135,37 +206,49 @@ public:
 	    return m_user_resource_pack;
   }
 
-	void set_user_general_lang(const lang_info&) noexcept;
-	void set_user_command_lang(const lang_info&) noexcept;
-	void set_user_gui_lang(const lang_info&) noexcept;
-	void set_user_log_lang(const lang_info&) noexcept;
-	void set_user_resource_pack(const resource_pack_info&) noexcept;
-
-	[[nodiscard]] bool save_user_config() const noexcept;
+	/**
+	 * Writes `selected` to the config file, to be loaded on the next launch
+	 */
+	[[nodiscard]] static bool save_config(const selection &selected) noexcept;
 
 private:
+	[[nodiscard]] bool load_resource_pack(const std::filesystem::path &file) noexcept;
 	[[nodiscard]] bool load_graphics(std::shared_ptr<cpptoml::table> config, const std::filesystem::path &resourcepack_directory) noexcept;
 
 	[[nodiscard]] bool load_tiles_anims(const std::shared_ptr<cpptoml::table> &tiles_config, const std::string &graph_file) noexcept;
 	[[nodiscard]] bool load_objects_anims(const std::shared_ptr<cpptoml::table> &objects_config, const std::string &graph_file) noexcept;
 	[[nodiscard]] bool load_mobs_anims(const std::shared_ptr<cpptoml::table> &mobs_config, const std::string &graph_file) noexcept;
 	[[nodiscard]] bool load_mob_anim(const std::shared_ptr<cpptoml::table> &mob_anim_config, std::string_view mob_name,
-	                                 view::facing_direction::type dir, view::mob_animations &anims, sf::Texture &) noexcept;
+	                                 view::facing_direction::type dir, view::mob_animations &anims,
+	                                 const view::texture_atlas::region &) noexcept;
 
-	[[nodiscard]] bool load_texts(const std::shared_ptr<cpptoml::table> &config) noexcept;
 	[[nodiscard]] bool load_command_texts(const std::shared_ptr<cpptoml::table> &lang_file) noexcept;
 	[[nodiscard]] bool load_logging_texts(const std::shared_ptr<cpptoml::table> &lang_file) noexcept;
 	[[nodiscard]] bool load_tooltip_texts(const std::shared_ptr<cpptoml::table> &lang_file) noexcept;
 	[[nodiscard]] bool load_gui_texts(const std::shared_ptr<cpptoml::table> &lang_file) noexcept;
 
+	/**
+	 * Interns the keys of m_log_strings and fills m_log_strings_by_id accordingly
+	 */
+	void index_logging_texts();
+
 	[[nodiscard]] static bool generic_load_keyed_texts(const std::shared_ptr<cpptoml::table_array> &table_array, const char *id_key,
 	                                                   const char *text_key, std::unordered_map<std::string_view, std::string> &strings_out,
 	                                                   std::vector<std::string> &keys_out) noexcept;
 
-	sf::Texture *get_texture(const std::string &file) noexcept;
+	/**
+	 * Decodes the images in parallel and packs them into m_atlas
+	 * @return false if the atlas could not be built (images that failed to decode are only logged)
+	 */
+	[[nodiscard]] bool load_images(std::vector<std::string> files) noexcept;
+
+	/**
+	 * @return where the image was packed by load_images, or nullptr if it could not be decoded
+	 */
+	[[nodiscard]] const view::texture_atlas::region *get_texture(const std::string &file) const noexcept;
 
-	std::unordered_map<std::string, sf::Texture *> m_textures_by_file{};
-	std::forward_list<sf::Texture> m_textures_holder{};
+	std::unordered_map<std::string, view::texture_atlas::region> m_textures_by_file{};
+	view::texture_atlas m_atlas{};
 
 	std::unordered_map<resources_type::tile_id, view::animation> m_tiles_anims{};
 	std::unordered_map<resources_type::object_id, view::shifted_animation> m_objects_anims{};
@@ -175,15 +258,17 @@ private:
 
 	std::unordered_map<std::string_view, std::string> m_log_strings{};
 	std::vector<std::string> m_log_string_keys{};
+	std::vector<std::string_view> m_log_strings_by_id{}; // indexed by log::key_id, views to m_log_strings
 	std::unordered_map<std::string_view, std::string> m_tooltip_strings{};
 	std::vector<std::string> m_tooltip_string_keys{};
+	unsigned int m_tooltip_texts_version{0};
 	std::unordered_map<std::string_view, std::string> m_gui_strings{};
 	std::vector<std::string> m_gui_string_keys{};
 
 	std::vector<lang_info> m_available_langs;
 	std::vector<resource_pack_info> m_resource_packs;
 
-	// user config (saved by "save_user_config")
+	// user config (see save_config)
 	lang_info m_user_general_lang{};
 	lang_info m_user_command_lang{};
 	lang_info m_user_gui_lang{};
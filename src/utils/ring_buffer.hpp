@@ -0,0 +1,74 @@
+#ifndef NINJACLOWN_UTILS_RING_BUFFER_HPP
+#define NINJACLOWN_UTILS_RING_BUFFER_HPP
+
+#include <cassert>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Fixed capacity FIFO. Pushing into a full buffer evicts (and returns) the oldest element.
+ */
+template <typename T>
+class ring_buffer {
+public:
+	explicit ring_buffer(std::size_t capacity)
+	    : m_storage(capacity) {
+		assert(capacity != 0);
+	}
+
+	/**
+	 * @return the evicted element, if the buffer was full
+	 */
+	std::optional<T> push(T &&value) {
+		std::optional<T> evicted;
+		if (m_size == m_storage.size()) {
+			evicted.emplace(std::move(m_storage[m_first]));
+			m_storage[m_first] = std::move(value);
+			m_first            = (m_first + 1) % m_storage.size();
+		}
+		else {
+			m_storage[(m_first + m_size) % m_storage.size()] = std::move(value);
+			++m_size;
+		}
+		return evicted;
+	}
+
+	/**
+	 * Calls func on each element, oldest first, then empties the buffer
+	 */
+	template <typename FuncT>
+	void drain(FuncT &&func) {
+		for (std::size_t i = 0; i < m_size; ++i) {
+			func(std::move(m_storage[(m_first + i) % m_storage.size()]));
+		}
+		clear();
+	}
+
+	void clear() noexcept {
+		m_first = 0;
+		m_size  = 0;
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept {
+		return m_size;
+	}
+
+	[[nodiscard]] std::size_t capacity() const noexcept {
+		return m_storage.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return m_size == 0;
+	}
+
+private:
+	std::vector<T> m_storage;
+	std::size_t m_first{0};
+	std::size_t m_size{0};
+};
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_RING_BUFFER_HPP
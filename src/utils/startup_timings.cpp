@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "utils/logging.hpp"
+#include "utils/startup_timings.hpp"
+
+using fmt::operator""_a;
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+struct recorded_step {
+	const char *name;
+	clock_type::time_point start;
+	clock_type::time_point end;
+};
+
+struct timeline {
+	std::mutex mutex{};
+	clock_type::time_point start{clock_type::now()};
+	std::vector<recorded_step> steps{};
+	bool reported{false};
+};
+
+timeline &launch() {
+	static timeline instance;
+	return instance;
+}
+
+float milliseconds(clock_type::duration duration) {
+	return std::chrono::duration<float, std::milli>{duration}.count();
+}
+} // namespace
+
+void utils::startup::begin() noexcept {
+	timeline &line = launch();
+	std::lock_guard lock{line.mutex};
+	line.start = clock_type::now();
+}
+
+void utils::startup::record(const char *name, clock_type::time_point start, clock_type::time_point end) noexcept {
+	timeline &line = launch();
+	std::lock_guard lock{line.mutex};
+	if (line.reported) {
+		return;
+	}
+
+	try {
+		line.steps.push_back({name, start, end});
+	}
+	catch (const std::bad_alloc &) {
+		// timings are informative only
+	}
+}
+
+void utils::startup::report() noexcept {
+	timeline &line = launch();
+	std::vector<recorded_step> steps;
+	clock_type::time_point start;
+	{
+		std::lock_guard lock{line.mutex};
+		if (line.reported) {
+			return;
+		}
+		line.reported = true;
+		steps.swap(line.steps);
+		start = line.start;
+	}
+
+	std::sort(steps.begin(), steps.end(), [](const recorded_step &lhs, const recorded_step &rhs) { return lhs.start < rhs.start; });
+	for (const recorded_step &step : steps) {
+		utils::log::info("startup.step", "step"_a = step.name, "start_ms"_a = milliseconds(step.start - start),
+		                 "duration_ms"_a = milliseconds(step.end - step.start));
+	}
+	utils::log::info("startup.done", "duration_ms"_a = milliseconds(clock_type::now() - start));
+}
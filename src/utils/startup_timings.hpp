@@ -0,0 +1,50 @@
+#ifndef NINJACLOWN_UTILS_STARTUP_TIMINGS_HPP
+#define NINJACLOWN_UTILS_STARTUP_TIMINGS_HPP
+
+#include <chrono>
+
+/**
+ * Duration of the steps of the program's launch, logged once it is done to show where launch time goes.
+ * Steps may run concurrently: the report gives when each of them started.
+ */
+namespace utils::startup {
+
+/**
+ * Marks the beginning of the launch, to be called first thing in main
+ */
+void begin() noexcept;
+
+/**
+ * Records a step. Steps recorded after the report are ignored. name must have static storage duration.
+ */
+void record(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) noexcept;
+
+/**
+ * Logs every step recorded since begin(), by start time. Only the first call does something.
+ */
+void report() noexcept;
+
+/**
+ * Times the enclosing scope as a launch step. name must have static storage duration.
+ */
+class step {
+public:
+	explicit step(const char *name) noexcept
+	    : m_name{name} { }
+
+	step(const step &) = delete;
+	step(step &&)      = delete;
+	step &operator=(const step &) = delete;
+	step &operator=(step &&) = delete;
+
+	~step() {
+		record(m_name, m_start, std::chrono::steady_clock::now());
+	}
+
+private:
+	const char *m_name;
+	std::chrono::steady_clock::time_point m_start{std::chrono::steady_clock::now()};
+};
+} // namespace utils::startup
+
+#endif //NINJACLOWN_UTILS_STARTUP_TIMINGS_HPP
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "utils/thread_pool.hpp"
+
+namespace {
+struct parallel_job {
+	std::function<void(std::size_t, std::size_t)> func;
+	std::size_t count;
+	std::size_t grain;
+	std::size_t chunk_count;
+
+	std::atomic_size_t next_chunk{0};
+	std::size_t done_chunks{0};
+	std::mutex mutex{};
+	std::condition_variable cv{};
+
+	// processes chunks until there is none left
+	void run() {
+		std::size_t processed{0};
+		for (std::size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) {
+			const std::size_t begin = chunk * grain;
+			func(begin, std::min(begin + grain, count));
+			++processed;
+		}
+
+		if (processed != 0) {
+			std::lock_guard lock{mutex};
+			done_chunks += processed;
+			if (done_chunks == chunk_count) {
+				cv.notify_all();
+			}
+		}
+	}
+};
+} // namespace
+
+utils::thread_pool::thread_pool(std::size_t worker_count) {
+	m_workers.reserve(worker_count);
+	for (std::size_t i = 0; i < worker_count; ++i) {
+		m_workers.emplace_back(&thread_pool::work, this);
+	}
+}
+
+utils::thread_pool::~thread_pool() {
+	{
+		std::lock_guard lock{m_mutex};
+		m_stopping = true;
+	}
+	m_cv.notify_all();
+	for (std::thread &worker : m_workers) {
+		worker.join();
+	}
+}
+
+utils::thread_pool &utils::thread_pool::instance() {
+	static thread_pool pool{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+	return pool;
+}
+
+void utils::thread_pool::push(std::function<void()> task) {
+	{
+		std::lock_guard lock{m_mutex};
+		m_tasks.emplace_back(std::move(task));
+	}
+	m_cv.notify_one();
+}
+
+void utils::thread_pool::parallel_for(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)> &func) {
+	if (count == 0) {
+		return;
+	}
+	grain = std::max<std::size_t>(grain, 1);
+
+	const std::size_t chunk_count = (count + grain - 1) / grain;
+	if (chunk_count == 1 || m_workers.empty()) {
+		for (std::size_t begin = 0; begin < count; begin += grain) {
+			func(begin, std::min(begin + grain, count));
+		}
+		return;
+	}
+
+	// the job is shared with the queued tasks, as some of them may only be scheduled once this call returned
+	auto job = std::make_shared<parallel_job>();
+	job->func        = func;
+	job->count       = count;
+	job->grain       = grain;
+	job->chunk_count = chunk_count;
+
+	const std::size_t helpers = std::min(m_workers.size(), chunk_count - 1);
+	for (std::size_t i = 0; i < helpers; ++i) {
+		push([job] { job->run(); });
+	}
+	job->run();
+
+	std::unique_lock lock{job->mutex};
+	job->cv.wait(lock, [&job] { return job->done_chunks == job->chunk_count; });
+}
+
+void utils::thread_pool::work() noexcept {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock lock{m_mutex};
+			m_cv.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+			if (m_tasks.empty()) {
+				return;
+			}
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
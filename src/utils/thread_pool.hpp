@@ -0,0 +1,60 @@
+#ifndef NINJACLOWN_UTILS_THREAD_POOL_HPP
+#define NINJACLOWN_UTILS_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Fixed set of worker threads consuming a FIFO of tasks
+ */
+class thread_pool {
+public:
+	/**
+	 * @param worker_count amount of threads in addition to the callers of parallel_for
+	 */
+	explicit thread_pool(std::size_t worker_count);
+	~thread_pool();
+
+	thread_pool(const thread_pool &) = delete;
+	thread_pool &operator=(const thread_pool &) = delete;
+
+	/**
+	 * Pool shared by the whole program, with one thread less than the amount of hardware threads
+	 */
+	static thread_pool &instance();
+
+	/**
+	 * Queues a task. Tasks must not throw.
+	 */
+	void push(std::function<void()> task);
+
+	/**
+	 * Calls func(begin, end) on consecutive ranges of at most `grain` items covering [0 ; count), from the workers and from
+	 * the calling thread, and returns once every range was processed. The way ranges are spread over threads is unspecified:
+	 * func should only write to the items of its range.
+	 */
+	void parallel_for(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)> &func);
+
+	[[nodiscard]] std::size_t worker_count() const noexcept {
+		return m_workers.size();
+	}
+
+private:
+	void work() noexcept;
+
+	std::vector<std::thread> m_workers{};
+	std::deque<std::function<void()>> m_tasks{};
+	std::mutex m_mutex{};
+	std::condition_variable m_cv{};
+	bool m_stopping{false};
+};
+} // namespace utils
+
+#endif //NINJACLOWN_UTILS_THREAD_POOL_HPP
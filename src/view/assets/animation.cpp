@@ -2,10 +2,13 @@
 #include "view/game/map_viewer.hpp"
 
 namespace {
-void print_tile(view::map_viewer& viewer, sf::Sprite &frame,
+void print_tile(view::map_viewer& viewer, sf::Sprite &frame, bool animated,
                 float x, float y, float xshift = 0.f, float yshift = 0.f) noexcept {
 	auto [screen_x, screen_y] = viewer.to_screen_coords(x, y);
 	frame.setPosition(screen_x + xshift, screen_y + yshift);
+	if (animated && frame.getGlobalBounds().intersects(viewer.visible_area())) {
+		viewer.show_animated();
+	}
 	viewer.draw(frame);
 }
 
@@ -16,17 +19,22 @@ sf::Sprite &select(std::chrono::system_clock::time_point starting_time, std::vec
 } // namespace
 
 void view::animation::print(view::map_viewer& viewer, float posx, float posy) const noexcept {
-	print_tile(viewer, select(viewer.starting_time(), m_frames, SINGLE_IMAGE_DURATION), posx, posy);
+	print_tile(viewer, select(viewer.starting_time(), m_frames, SINGLE_IMAGE_DURATION), m_frames.size() > 1, posx, posy);
+}
+
+std::size_t view::animation::frame_index(std::chrono::system_clock::time_point starting_time) const noexcept {
+	auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - starting_time);
+	return static_cast<std::size_t>(duration.count() / SINGLE_IMAGE_DURATION) % m_frames.size();
 }
 
 void view::animation::highlight(view::map_viewer& viewer, float posx, float posy) const noexcept {
 	sf::Sprite frame = select(viewer.starting_time(), m_frames, SINGLE_IMAGE_DURATION);
 	frame.setColor(sf::Color{128, 255, 128});
-	print_tile(viewer, frame, posx, posy);
+	print_tile(viewer, frame, m_frames.size() > 1, posx, posy);
 }
 
 void view::shifted_animation::print(view::map_viewer& viewer, float posx, float posy) const noexcept {
-	print_tile(viewer, select(viewer.starting_time(), m_frames, SINGLE_IMAGE_DURATION), posx, posy, m_xshift, m_yshift);
+	print_tile(viewer, select(viewer.starting_time(), m_frames, SINGLE_IMAGE_DURATION), m_frames.size() > 1, posx, posy, m_xshift, m_yshift);
 }
 
 bool view::shifted_animation::is_hovered(view::map_viewer& viewer) const noexcept {
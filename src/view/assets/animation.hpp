@@ -1,6 +1,8 @@
 #ifndef NINJACLOWN_VIEW_ANIMATION_HPP
 #define NINJACLOWN_VIEW_ANIMATION_HPP
 
+#include <chrono>
+#include <cstddef>
 #include <vector>
 
 #include <SFML/Graphics/Sprite.hpp>
@@ -20,6 +22,19 @@ public:
 
 	void highlight(map_viewer &viewer, float posx, float posy) const noexcept;
 
+	/**
+	 * @return index of the frame to display at this instant
+	 */
+	[[nodiscard]] std::size_t frame_index(std::chrono::system_clock::time_point starting_time) const noexcept;
+
+	[[nodiscard]] const sf::Sprite &frame(std::size_t index) const noexcept {
+		return m_frames[index];
+	}
+
+	[[nodiscard]] std::size_t frame_count() const noexcept {
+		return m_frames.size();
+	}
+
 	friend class shifted_animation;
 
 private:
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <numeric>
+#include <optional>
+
+#include "view/assets/texture_atlas.hpp"
+
+std::vector<view::texture_atlas::placement> view::texture_atlas::pack(const std::vector<sf::Vector2u> &sizes, unsigned int page_size,
+                                                                      std::vector<sf::Vector2u> &page_sizes) {
+	std::vector<std::size_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), std::size_t{0});
+	std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t lhs, std::size_t rhs) { return sizes[lhs].y > sizes[rhs].y; });
+
+	struct shelf {
+		unsigned int y;
+		unsigned int height;
+		unsigned int used_width;
+	};
+
+	std::vector<placement> placements(sizes.size());
+	std::vector<std::vector<shelf>> shelves;
+	page_sizes.clear();
+
+	auto new_page = [&]() {
+		page_sizes.emplace_back(0u, 0u);
+		shelves.emplace_back();
+		return page_sizes.size() - 1;
+	};
+
+	for (std::size_t index : order) {
+		const unsigned int width  = sizes[index].x + 2 * padding;
+		const unsigned int height = sizes[index].y + 2 * padding;
+
+		if (width > page_size || height > page_size) {
+			const std::size_t page = new_page();
+			page_sizes[page]       = {width, height};
+			placements[index]      = {page, padding, padding};
+			continue;
+		}
+
+		// first shelf with enough room, on any page, or a new shelf below the last one of a page
+		// (pages holding an oversized image have no shelf)
+		std::optional<placement> found;
+		for (std::size_t page = 0; page < shelves.size() && !found; ++page) {
+			for (shelf &current : shelves[page]) {
+				if (height <= current.height && current.used_width + width <= page_size) {
+					found = placement{page, current.used_width + padding, current.y + padding};
+					current.used_width += width;
+					break;
+				}
+			}
+			if (!found && !shelves[page].empty()) {
+				const unsigned int bottom = shelves[page].back().y + shelves[page].back().height;
+				if (bottom + height <= page_size) {
+					shelves[page].push_back({bottom, height, width});
+					found = placement{page, padding, bottom + padding};
+				}
+			}
+		}
+		if (!found) {
+			const std::size_t page = new_page();
+			shelves[page].push_back({0u, height, width});
+			found = placement{page, padding, padding};
+		}
+
+		placements[index]         = *found;
+		sf::Vector2u &page_extent = page_sizes[found->page];
+		page_extent.x             = std::max(page_extent.x, found->x - padding + width);
+		page_extent.y             = std::max(page_extent.y, found->y - padding + height);
+	}
+
+	return placements;
+}
+
+std::vector<view::texture_atlas::region> view::texture_atlas::build(const std::vector<const sf::Image *> &images) noexcept {
+	m_pages.clear();
+	try {
+		std::vector<sf::Vector2u> sizes;
+		sizes.reserve(images.size());
+		for (const sf::Image *image : images) {
+			sizes.push_back(image->getSize());
+		}
+
+		std::vector<sf::Vector2u> page_sizes;
+		const std::vector<placement> placements = pack(sizes, std::min(sf::Texture::getMaximumSize(), max_page_size), page_sizes);
+
+		std::vector<sf::Image> page_images(page_sizes.size());
+		for (std::size_t page = 0; page < page_sizes.size(); ++page) {
+			page_images[page].create(page_sizes[page].x, page_sizes[page].y, sf::Color::Transparent);
+		}
+		for (std::size_t i = 0; i < images.size(); ++i) {
+			page_images[placements[i].page].copy(*images[i], placements[i].x, placements[i].y);
+		}
+
+		// pages are stored in reverse order, so that their addresses are known once all of them are uploaded
+		std::vector<const sf::Texture *> pages(page_sizes.size());
+		for (std::size_t page = page_sizes.size(); page-- > 0;) {
+			m_pages.emplace_front();
+			if (!m_pages.front().loadFromImage(page_images[page])) {
+				m_pages.clear();
+				return {};
+			}
+			pages[page] = &m_pages.front();
+		}
+
+		std::vector<region> regions;
+		regions.reserve(images.size());
+		for (const placement &placed : placements) {
+			regions.push_back({pages[placed.page], sf::Vector2i{static_cast<int>(placed.x), static_cast<int>(placed.y)}});
+		}
+		return regions;
+	}
+	catch (const std::bad_alloc &) {
+		m_pages.clear();
+		return {};
+	}
+}
@@ -0,0 +1,67 @@
+#ifndef NINJACLOWN_VIEW_TEXTURE_ATLAS_HPP
+#define NINJACLOWN_VIEW_TEXTURE_ATLAS_HPP
+
+#include <cstddef>
+#include <forward_list>
+#include <iterator>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+namespace view {
+
+/**
+ * Images packed into as few textures (pages) as possible, so that sprites coming from different images can be drawn
+ * in a single batch.
+ */
+class texture_atlas {
+public:
+	static constexpr unsigned int max_page_size = 4096;
+	static constexpr unsigned int padding       = 1; //!< transparent pixels around every image, against bleeding
+
+	/**
+	 * Where an image ended up
+	 */
+	struct region {
+		const sf::Texture *texture;
+		sf::Vector2i offset;
+	};
+
+	/**
+	 * Position of an image of a given size within the pages
+	 */
+	struct placement {
+		std::size_t page;
+		unsigned int x;
+		unsigned int y;
+	};
+
+	/**
+	 * Shelf packing, tallest images first. Images wider or taller than `page_size` get a page of their own.
+	 * @param page_sizes set to the size of every page
+	 * @return the placement of every size, in order
+	 */
+	static std::vector<placement> pack(const std::vector<sf::Vector2u> &sizes, unsigned int page_size, std::vector<sf::Vector2u> &page_sizes);
+
+	/**
+	 * Replaces the atlas' pages by new ones holding `images`
+	 * @return where each image was placed, in order, or nothing if the pages could not be uploaded
+	 */
+	[[nodiscard]] std::vector<region> build(const std::vector<const sf::Image *> &images) noexcept;
+
+	void clear() noexcept {
+		m_pages.clear();
+	}
+
+	[[nodiscard]] std::size_t page_count() const noexcept {
+		return static_cast<std::size_t>(std::distance(m_pages.begin(), m_pages.end()));
+	}
+
+private:
+	std::forward_list<sf::Texture> m_pages{};
+};
+
+} // namespace view
+
+#endif //NINJACLOWN_VIEW_TEXTURE_ATLAS_HPP
@@ -34,20 +34,20 @@ view::game_menu::user_request view::game_menu::show() {
 		m_currently_open = true;
 	}
 
-	const auto &res   = utils::resource_manager::instance();
+	const auto res   = utils::resource_manager::instance();
 	const auto &style = ImGui::GetStyle();
 
-	const std::string_view resume            = res.gui_text_for("view.in_game_menu.resume");
-	const std::string_view load_dll          = res.gui_text_for("view.in_game_menu.dll");
-	const std::string_view restart           = res.gui_text_for("view.in_game_menu.restart");
-	const std::string_view settings          = res.gui_text_for("view.in_game_menu.settings");
-	const std::string_view load_map          = res.gui_text_for("view.in_game_menu.load_map");
-	const std::string_view import            = res.gui_text_for("view.in_game_menu.import_maps");
-	const std::string_view credits           = res.gui_text_for("view.in_game_menu.credits");
-	const std::string_view map_editor        = res.gui_text_for("view.in_game_menu.map_editor");
-	const std::string_view campaign_editor   = res.gui_text_for("view.in_game_menu.campaign_editor");
-	const std::string_view back_to_main_menu = res.gui_text_for("view.in_game_menu.return_to_main_menu");
-	const std::string_view quit              = res.gui_text_for("view.in_game_menu.quit");
+	const std::string_view resume            = res->gui_text_for("view.in_game_menu.resume");
+	const std::string_view load_dll          = res->gui_text_for("view.in_game_menu.dll");
+	const std::string_view restart           = res->gui_text_for("view.in_game_menu.restart");
+	const std::string_view settings          = res->gui_text_for("view.in_game_menu.settings");
+	const std::string_view load_map          = res->gui_text_for("view.in_game_menu.load_map");
+	const std::string_view import            = res->gui_text_for("view.in_game_menu.import_maps");
+	const std::string_view credits           = res->gui_text_for("view.in_game_menu.credits");
+	const std::string_view map_editor        = res->gui_text_for("view.in_game_menu.map_editor");
+	const std::string_view campaign_editor   = res->gui_text_for("view.in_game_menu.campaign_editor");
+	const std::string_view back_to_main_menu = res->gui_text_for("view.in_game_menu.return_to_main_menu");
+	const std::string_view quit              = res->gui_text_for("view.in_game_menu.quit");
 
 	ImVec2 max_text_size{0.f, 0.f};
 	auto update_sz = [&max_text_size](std::string_view str) {
@@ -43,6 +43,13 @@ public:
 
 	void close();
 
+	/**
+	 * @return true if the menu changes without user input, because it waits for background work (eg: directory listings)
+	 */
+	[[nodiscard]] bool needs_redraw() const noexcept {
+		return m_current_state == state::filesystem && m_explorer.listing_in_progress();
+	}
+
 	const std::filesystem::path& path() const noexcept {
 		return m_path;
 	}
@@ -61,6 +61,12 @@ void view::game_viewer::restart() noexcept {
 	m_autostep_bot = false;
 }
 
+bool view::game_viewer::needs_redraw() noexcept {
+	const std::size_t animation_step = m_map.animation_step();
+	const bool next_animation_frame  = std::exchange(m_last_animation_step, animation_step) != animation_step && m_map.shows_animations();
+	return m_invalidated.exchange(false) || next_animation_frame || (m_showing_menu && m_menu.needs_redraw());
+}
+
 bool view::game_viewer::show(bool show_debug_data) {
 	m_window_size = m_window.getSize();
 	m_map.print(show_debug_data);
@@ -6,6 +6,8 @@
 
 #include "terminal_commands.hpp"
 
+#include <atomic>
+
 namespace sf {
 class RenderWindow;
 class Event;
@@ -29,6 +31,7 @@ public:
 	void set_map(map_viewer &&map_viewer) {
 		m_map = std::move(map_viewer);
 		m_map.set_render_window(m_window);
+		m_invalidated = true;
 	}
 
 	void pause() noexcept;
@@ -52,20 +55,49 @@ public:
 
     void move_entity(const adapter::view_handle& handle, float new_x, float new_y) {
         m_map.acquire_overmap()->move_entity(handle, new_x, new_y);
+        m_invalidated = true;
     }
 
     void rotate_entity(const adapter::view_handle& handle, ::view::facing_direction::type value) {
         m_map.acquire_overmap()->rotate_entity(handle, value);
+        m_invalidated = true;
+    }
+
+    void set_projectiles(const std::vector<float>& xs, const std::vector<float>& ys) {
+        m_map.set_projectiles(xs, ys);
+        m_invalidated = true;
+    }
+
+    void invalidate_tile(std::size_t x, std::size_t y) {
+        m_map.invalidate_tile(x, y);
+        m_invalidated = true;
+    }
+
+    void set_tile(std::size_t x, std::size_t y, map::cell value) {
+        m_map.set_tile(x, y, value);
+        m_invalidated = true;
+    }
+
+    [[nodiscard]] std::optional<map::cell> tile_at(std::size_t x, std::size_t y) {
+        return m_map.tile_at(x, y);
     }
 
     void reveal(const adapter::view_handle& handle) {
         m_map.acquire_overmap()->reveal(handle);
+        m_invalidated = true;
     }
 
     void hide(const adapter::view_handle& handle) {
         m_map.acquire_overmap()->hide(handle);
+        m_invalidated = true;
     }
 
+	/**
+	 * Returns true if the game should be drawn again: the map was modified since the last call, time went on to the next
+	 * animation frame while something animated is on screen, or the open menu waits for background work
+	 */
+	[[nodiscard]] bool needs_redraw() noexcept;
+
 	/**
 	 * Displays the rightmost bar (play, pause, step, ... buttons).
 	 */
@@ -93,6 +125,9 @@ private:
 	std::optional<sf::Vector2i> m_right_click_pos{};
 
 	bool m_autostep_bot{false};
+
+	std::atomic_bool m_invalidated{true}; //! Set by the adapter's thread when the map is modified
+	std::size_t m_last_animation_step{0};
 };
 } // namespace view
 
@@ -1,11 +1,16 @@
 #include "map.hpp"
 #include "utils/optional.hpp"
+#include "utils/profiler.hpp"
 #include "utils/resource_manager.hpp"
 #include "utils/resources_type.hpp"
+#include "view/assets/animation.hpp"
 #include "view/game/map_viewer.hpp"
 
+#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/System/Vector2.hpp>
 
+#include <algorithm>
+
 sf::Vector2u view::map::level_size() const noexcept {
 	if (m_cells.empty()) {
 		return {0u, 0u};
@@ -13,35 +18,65 @@ sf::Vector2u view::map::level_size() const noexcept {
 	return {static_cast<unsigned int>(m_cells.size()), static_cast<unsigned int>(m_cells.front().size())};
 }
 
+void view::map::invalidate_all() noexcept {
+	for (chunk &chunk : m_chunks) {
+		chunk.placed = false;
+		chunk.dirty  = true;
+	}
+}
+
 void view::map::print(view::map_viewer &view) const noexcept {
 	static_assert(static_cast<int>(cell::iron_tile) == 0);
 	static_assert(static_cast<int>(cell::concrete_tile) == 1);
 	static_assert(static_cast<int>(cell::abyss) == 2);
-	const auto& resources = utils::resource_manager::instance();
+	const auto resources = utils::resource_manager::instance();
 
-	std::array<utils::optional<const view::animation &>, 4> animations{resources.tile_animation(utils::resources_type::tile_id::iron),
-	                                                                   resources.tile_animation(utils::resources_type::tile_id::concrete),
-	                                                                   resources.tile_animation(utils::resources_type::tile_id::chasm)};
+	const std::array<utils::optional<const view::animation &>, tile_kinds> optional_animations{
+	  resources->tile_animation(utils::resources_type::tile_id::iron), resources->tile_animation(utils::resources_type::tile_id::concrete),
+	  resources->tile_animation(utils::resources_type::tile_id::chasm)};
 
-	for (unsigned int x = 0; x < m_cells.size(); ++x) {
-		for (unsigned int y = 0; y < m_cells[x].size(); ++y) {
-			auto value = static_cast<int>(m_cells[x][y]);
-			assert(animations[value]);
-			animations[value]->print(view, static_cast<float>(x), static_cast<float>(y));
+	std::array<const animation *, tile_kinds> animations{};
+	std::array<std::size_t, tile_kinds> frames{};
+	for (std::size_t i = 0; i < tile_kinds; ++i) {
+		assert(optional_animations[i]);
+		animations[i] = &*optional_animations[i];
+		frames[i]     = animations[i]->frame_index(view.starting_time());
+	}
+
+	const sf::FloatRect visible = view.visible_area();
+	for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+		chunk &chunk = m_chunks[i];
+		if (!chunk.placed) {
+			place(view, chunk, i / m_chunk_rows, i % m_chunk_rows);
+		}
+		if (!chunk.bounds.intersects(visible)) {
+			continue;
+		}
+
+		if (chunk.dirty || chunk.baked_frames != frames) {
+			rebuild(view, chunk, i / m_chunk_rows, i % m_chunk_rows, animations, frames);
+		}
+		for (const auto &[texture, vertices] : chunk.batches) {
+			view.draw(vertices, texture);
+		}
+		for (std::size_t kind = 0; kind < tile_kinds; ++kind) {
+			if (chunk.kinds[kind] && animations[kind]->frame_count() > 1) {
+				view.show_animated();
+			}
 		}
 	}
 }
 
 void view::map::highlight_tile(view::map_viewer &view, size_t x, size_t y) const noexcept {
-	const auto& resources = utils::resource_manager::instance();
+	const auto resources = utils::resource_manager::instance();
 
 	utils::optional<const view::animation &> anim;
 	switch (m_cells[x][y]) {
 		case cell::iron_tile:
-			anim = resources.tile_animation(utils::resources_type::tile_id::iron);
+			anim = resources->tile_animation(utils::resources_type::tile_id::iron);
 			break;
 		case cell::concrete_tile:
-			anim = resources.tile_animation(utils::resources_type::tile_id::concrete);
+			anim = resources->tile_animation(utils::resources_type::tile_id::concrete);
 			break;
 		case cell::abyss:
 			break;
@@ -54,8 +89,79 @@ void view::map::highlight_tile(view::map_viewer &view, size_t x, size_t y) const
 }
 
 void view::map::frame_tile(view::map_viewer &view, size_t x, size_t y) const noexcept {
-	auto animation = utils::resource_manager::instance().tile_animation(utils::resources_type::tile_id::frame);
+	const auto resources = utils::resource_manager::instance();
+	auto animation       = resources->tile_animation(utils::resources_type::tile_id::frame);
 	if (animation) {
 		animation->print(view, static_cast<float>(x), static_cast<float>(y));
 	}
 }
+
+void view::map::reset_chunks() {
+	m_chunks.clear();
+	if (m_cells.empty()) {
+		m_chunk_rows = 0;
+		return;
+	}
+
+	m_chunk_rows = (m_cells.front().size() + chunk_size - 1) / chunk_size;
+	m_chunks.resize((m_cells.size() + chunk_size - 1) / chunk_size * m_chunk_rows);
+}
+
+void view::map::place(view::map_viewer &view, chunk &chunk, std::size_t chunk_x, std::size_t chunk_y) const noexcept {
+	const auto tiles = utils::resource_manager::instance()->tiles_infos();
+
+	// to_screen_coords being affine, the extremes are reached on the corner cells
+	const auto first_x = static_cast<float>(chunk_x * chunk_size);
+	const auto first_y = static_cast<float>(chunk_y * chunk_size);
+	const auto last_x  = static_cast<float>(std::min((chunk_x + 1) * chunk_size, m_cells.size()) - 1);
+	const auto last_y  = static_cast<float>(std::min((chunk_y + 1) * chunk_size, m_cells.front().size()) - 1);
+
+	const std::array<sf::Vector2f, 4> corners{view.to_screen_coords(first_x, first_y), view.to_screen_coords(last_x, first_y),
+	                                          view.to_screen_coords(first_x, last_y), view.to_screen_coords(last_x, last_y)};
+	sf::Vector2f min = corners.front();
+	sf::Vector2f max = corners.front();
+	for (const sf::Vector2f &corner : corners) {
+		min.x = std::min(min.x, corner.x);
+		min.y = std::min(min.y, corner.y);
+		max.x = std::max(max.x, corner.x);
+		max.y = std::max(max.y, corner.y);
+	}
+
+	chunk.bounds = {min.x, min.y, max.x - min.x + static_cast<float>(tiles.width), max.y - min.y + static_cast<float>(tiles.height)};
+	chunk.placed = true;
+}
+
+void view::map::rebuild(view::map_viewer &view, chunk &chunk, std::size_t chunk_x, std::size_t chunk_y,
+                        const std::array<const animation *, tile_kinds> &animations,
+                        const std::array<std::size_t, tile_kinds> &frames) const noexcept {
+	NINJACLOWN_PROFILE_SCOPE("map::rebuild");
+	chunk.batches.clear();
+	chunk.kinds = {};
+
+	const std::size_t end_x = std::min((chunk_x + 1) * chunk_size, m_cells.size());
+	const std::size_t end_y = std::min((chunk_y + 1) * chunk_size, m_cells.front().size());
+	for (std::size_t x = chunk_x * chunk_size; x < end_x; ++x) {
+		for (std::size_t y = chunk_y * chunk_size; y < end_y; ++y) {
+			const auto kind          = static_cast<std::size_t>(m_cells[x][y]);
+			const sf::Sprite &sprite = animations[kind]->frame(frames[kind]);
+			chunk.kinds[kind]        = true;
+			if (chunk.batches.empty() || chunk.batches.back().first != sprite.getTexture()) {
+				chunk.batches.emplace_back(sprite.getTexture(), sf::VertexArray{sf::Quads});
+			}
+
+			const sf::IntRect rect = sprite.getTextureRect();
+			const sf::Vector2f pos = view.to_screen_coords(static_cast<float>(x), static_cast<float>(y));
+			const sf::Vector2f size{static_cast<float>(rect.width), static_cast<float>(rect.height)};
+			const sf::Vector2f tex{static_cast<float>(rect.left), static_cast<float>(rect.top)};
+
+			sf::VertexArray &vertices = chunk.batches.back().second;
+			vertices.append(sf::Vertex{pos, tex});
+			vertices.append(sf::Vertex{{pos.x + size.x, pos.y}, {tex.x + size.x, tex.y}});
+			vertices.append(sf::Vertex{pos + size, tex + size});
+			vertices.append(sf::Vertex{{pos.x, pos.y + size.y}, {tex.x, tex.y + size.y}});
+		}
+	}
+
+	chunk.baked_frames = frames;
+	chunk.dirty        = false;
+}
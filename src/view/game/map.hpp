@@ -1,14 +1,21 @@
 #ifndef NINJACLOWN_VIEW_MAP_HPP
 #define NINJACLOWN_VIEW_MAP_HPP
 
+#include <array>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
 namespace adapter {
 class adapter;
 }
 
 namespace sf {
 class RenderWindow;
+class Texture;
 
 template <typename>
 class Vector2;
@@ -20,8 +27,14 @@ class resource_manager;
 }
 
 namespace view {
+class animation;
 class map_viewer;
 
+/**
+ * Static tile layer. Tiles are baked into vertex arrays, one per chunk of chunk_size * chunk_size cells, that are only rebuilt
+ * when one of their cells changed or when the tile animations move to their next frame. Chunks out of the view are neither
+ * rebuilt nor drawn.
+ */
 class map {
 public:
 	enum class cell {
@@ -30,10 +43,48 @@ public:
 		abyss,
 	};
 
+	static constexpr std::size_t chunk_size = 16;
+
 	void set(std::vector<std::vector<cell>> &&cells) {
 		m_cells = std::move(cells);
+		reset_chunks();
 	}
 
+	/**
+	 * Changes the tile of the cell (x, y). Cells out of the map are ignored.
+	 */
+	void set_cell(std::size_t x, std::size_t y, cell value) noexcept {
+		if (contains(x, y)) {
+			m_cells[x][y] = value;
+			invalidate(x, y);
+		}
+	}
+
+	/**
+	 * @pre (x, y) is within the map
+	 */
+	[[nodiscard]] cell cell_at(std::size_t x, std::size_t y) const noexcept {
+		return m_cells[x][y];
+	}
+
+	/**
+	 * Rebuilds the chunk holding the cell (x, y) on next print. Cells out of the map are ignored.
+	 */
+	void invalidate(std::size_t x, std::size_t y) noexcept {
+		if (contains(x, y)) {
+			m_chunks[x / chunk_size * m_chunk_rows + y / chunk_size].dirty = true;
+		}
+	}
+
+	[[nodiscard]] bool contains(std::size_t x, std::size_t y) const noexcept {
+		return x < m_cells.size() && y < m_cells[x].size();
+	}
+
+	/**
+	 * Rebuilds every chunk on next print (eg: tile sprites were reloaded)
+	 */
+	void invalidate_all() noexcept;
+
 	[[nodiscard]] sf::Vector2u level_size() const noexcept;
 
 	void print(map_viewer& view) const noexcept;
@@ -47,8 +98,32 @@ public:
 	}
 
 private:
+	static constexpr std::size_t tile_kinds = 3;
+
+	struct chunk {
+		// consecutive tiles sharing a texture, in drawing order
+		std::vector<std::pair<const sf::Texture *, sf::VertexArray>> batches{};
+		sf::FloatRect bounds{}; //!< on screen
+		std::array<std::size_t, tile_kinds> baked_frames{};
+		std::array<bool, tile_kinds> kinds{}; //!< whether tiles of each kind were baked
+		bool placed{false}; //!< bounds are up to date
+		bool dirty{true};   //!< batches must be rebuilt
+	};
+
+	void reset_chunks();
+
+	void place(map_viewer &view, chunk &chunk, std::size_t chunk_x, std::size_t chunk_y) const noexcept;
+
+	void rebuild(map_viewer &view, chunk &chunk, std::size_t chunk_x, std::size_t chunk_y,
+	             const std::array<const animation *, tile_kinds> &animations,
+	             const std::array<std::size_t, tile_kinds> &frames) const noexcept;
+
 	std::vector<std::vector<cell>> m_cells;
 
+	// indexed by chunk_x * m_chunk_rows + chunk_y, in the same order as the cells are drawn
+	mutable std::vector<chunk> m_chunks{};
+	std::size_t m_chunk_rows{0};
+
 	friend class adapter::adapter;
 };
 } // namespace view
@@ -1,36 +1,46 @@
-#include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
-#include <SFML/Window/Mouse.hpp>
 
 #include <imgui.h>
 #include <utility>
 
 #include "map_viewer.hpp"
+#include "model/projectiles.hpp"
 #include "state_holder.hpp"
+#include "utils/profiler.hpp"
 #include "utils/resource_manager.hpp"
+#include "view/assets/animation.hpp"
 
 view::map_viewer::map_viewer(state::holder &state) noexcept
     : m_state{&state} { }
 
-void view::map_viewer::print(bool show_debug_data) {
-	assert(m_window);
+std::size_t view::map_viewer::animation_step() const noexcept {
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - m_starting_time);
+	return static_cast<std::size_t>(elapsed.count()) / animation::SINGLE_IMAGE_DURATION;
+}
+
+void view::map_viewer::build(const camera &camera, bool show_debug_data) {
+	NINJACLOWN_PROFILE_SCOPE("map_viewer::build");
 	assert(m_state);
-	const auto& resources = utils::resource_manager::instance();
+	const auto resources = utils::resource_manager::instance();
+
+	m_commands.clear();
+	m_camera = camera;
 
 	++m_current_frame;
+	m_shows_animations = false;
 	m_map.acquire()->print(*this);
+	print_projectiles();
 
+	auto overmap = m_overmap.acquire();
+	overmap->sort_draw_order();
 	if (!show_debug_data) {
-		m_overmap.acquire()->print_all(*this);
+		overmap->print_all(*this);
 		return;
 	}
 
-	const sf::Vector2u window_size = m_window->getSize();
-
-	std::vector<std::vector<std::string>> printable_info
-	  = m_overmap.acquire()->print_all(*this, state::access<map_viewer>::adapter(*m_state));
+	std::vector<std::vector<std::string>> printable_info = overmap->print_all(*this, state::access<map_viewer>::adapter(*m_state));
 
-	const auto &tiles_infos = resources.tiles_infos();
+	const auto &tiles_infos = resources->tiles_infos();
 	sf::Vector2f mouse_pos  = get_mouse_pos();
 	mouse_pos.y /= static_cast<float>(tiles_infos.yspacing);
 	mouse_pos.x = (mouse_pos.x - (mouse_pos.y - 1) * static_cast<float>(tiles_infos.y_xshift)) / static_cast<float>(tiles_infos.xspacing);
@@ -39,13 +49,30 @@ void view::map_viewer::print(bool show_debug_data) {
 		return;
 	}
 
-	const sf::Vector2i win_mouse_pos = sf::Mouse::getPosition(*m_window);
-	if (win_mouse_pos.x <= 0 || win_mouse_pos.y <= 0 || win_mouse_pos.x >= window_size.x || win_mouse_pos.y >= window_size.y) {
+	const sf::Vector2i win_mouse_pos = camera.mouse.value_or(sf::Vector2i{});
+	if (win_mouse_pos.x <= 0 || win_mouse_pos.y <= 0 || win_mouse_pos.x >= camera.target_size.x || win_mouse_pos.y >= camera.target_size.y) {
 		return;
 	}
 
 	printable_info.emplace_back().emplace_back("x : " + std::to_string(static_cast<int>(mouse_pos.x)));
 	printable_info.back().emplace_back("y : " + std::to_string(static_cast<int>(mouse_pos.y)));
+	m_commands.tooltip() = std::move(printable_info);
+}
+
+void view::map_viewer::print(bool show_debug_data) {
+	NINJACLOWN_PROFILE_SCOPE("map_viewer::print");
+	assert(m_window);
+
+	build(camera::of(*m_window), show_debug_data);
+	m_commands.submit(*m_window);
+	print_tooltip();
+}
+
+void view::map_viewer::print_tooltip() {
+	const std::vector<std::vector<std::string>> &printable_info = m_commands.tooltip();
+	if (printable_info.empty()) {
+		return;
+	}
 
 	auto &style = ImGui::GetStyle();
 	float x_text_size{0.f};
@@ -62,7 +89,7 @@ void view::map_viewer::print(bool show_debug_data) {
 	x_text_size += style.WindowPadding.x * 2;
 
 	const float prev = std::exchange(style.WindowRounding, 0.f);
-	const ImVec2 pos = {0, static_cast<float>(window_size.y) - y_text_size};
+	const ImVec2 pos = {0, static_cast<float>(m_camera.target_size.y) - y_text_size};
 	ImGui::SetNextWindowPos(pos, ImGuiCond_Always);
 	ImGui::SetNextWindowSize(ImVec2{x_text_size, y_text_size});
 	if (ImGui::Begin("##corner info window", nullptr,
@@ -82,31 +109,62 @@ void view::map_viewer::print(bool show_debug_data) {
 	style.WindowRounding = prev;
 }
 
-void view::map_viewer::draw(sf::Sprite &d) {
-	assert(m_window);
-	m_window->draw(d);
+void view::map_viewer::draw(const sf::Sprite &d) {
+	m_commands.add_sprite(d);
 }
 
-void view::map_viewer::draw(sf::RectangleShape &d) {
-	assert(m_window);
-	m_window->draw(d);
+void view::map_viewer::draw(sf::FloatRect rect, sf::Color color) {
+	m_commands.add_rect(rect, color);
+}
+
+void view::map_viewer::draw(const sf::VertexArray &vertices, const sf::Texture *texture) {
+	m_commands.add_baked(vertices, texture);
+}
+
+sf::FloatRect view::map_viewer::visible_area() const noexcept {
+	const sf::View &view = m_camera.view;
+	return {view.getCenter() - view.getSize() / 2.f, view.getSize()};
 }
 
 void view::map_viewer::highlight_tile(sf::Vector2i tile_coord) {
 	m_map.acquire()->highlight_tile(*this, tile_coord.x, tile_coord.y);
 }
 
+void view::map_viewer::set_projectiles(const std::vector<float> &xs, const std::vector<float> &ys) {
+	auto projectiles = m_projectiles.acquire();
+	projectiles->resize(xs.size());
+	for (std::size_t i = 0; i < xs.size(); ++i) {
+		(*projectiles)[i] = {xs[i], ys[i]};
+	}
+}
+
+void view::map_viewer::print_projectiles() {
+	const auto tiles = utils::resource_manager::instance()->tiles_infos();
+	const float half  = model::projectile_pool::radius * static_cast<float>(tiles.xspacing);
+	const sf::Color color{255, 200, 40}; // NOLINT
+
+	auto projectiles = m_projectiles.acquire();
+	for (const sf::Vector2f &projectile : *projectiles) {
+		const sf::Vector2f center = to_screen_coords(projectile.x, projectile.y);
+		m_commands.add_rect({center.x - half, center.y - half, 2 * half, 2 * half}, color);
+	}
+}
+
 void view::map_viewer::reload_sprites() {
 	m_overmap.acquire()->reload_sprites();
+	m_map.acquire()->invalidate_all();
 }
 
 // conversions necessary to account for the viewport
 sf::Vector2f view::map_viewer::get_mouse_pos() const noexcept {
-	auto view = m_window->getView();
-	auto size = m_window->getSize();
+	const sf::View &view = m_camera.view;
+	const sf::Vector2u size = m_camera.target_size;
+	if (!m_camera.mouse || size.x == 0 || size.y == 0) {
+		return view.getCenter() - view.getSize() / 2.f;
+	}
 	const sf::Vector2f ratio{view.getSize().x / static_cast<float>(size.x), view.getSize().y / static_cast<float>(size.y)};
 
-	sf::Vector2f mouse(sf::Mouse::getPosition(*m_window));
+	sf::Vector2f mouse(*m_camera.mouse);
 	mouse.x *= ratio.x;
 	mouse.y *= ratio.y;
 
@@ -114,7 +172,7 @@ sf::Vector2f view::map_viewer::get_mouse_pos() const noexcept {
 }
 
 sf::Vector2f view::map_viewer::to_screen_coords(float x, float y) const noexcept {
-	const auto &tiles = utils::resource_manager::instance().tiles_infos();
+	const auto tiles = utils::resource_manager::instance()->tiles_infos();
 	sf::Vector2f screen;
 
 	screen.x = x * static_cast<float>(tiles.xspacing) + y * static_cast<float>(tiles.y_xshift);
@@ -122,3 +180,18 @@ sf::Vector2f view::map_viewer::to_screen_coords(float x, float y) const noexcept
 
 	return screen;
 }
+
+sf::Vector2f view::map_viewer::to_world_coords(sf::Vector2f screen) const noexcept {
+	const auto tiles = utils::resource_manager::instance()->tiles_infos();
+	const auto xspacing = static_cast<float>(tiles.xspacing);
+	const auto y_xshift = static_cast<float>(tiles.y_xshift);
+	const auto x_yshift = static_cast<float>(tiles.x_yshift);
+	const auto yspacing = static_cast<float>(tiles.yspacing);
+
+	// inverse of to_screen_coords
+	const float determinant = xspacing * yspacing - y_xshift * x_yshift;
+	if (determinant == 0.f) {
+		return {};
+	}
+	return {(screen.x * yspacing - screen.y * y_xshift) / determinant, (screen.y * xspacing - screen.x * x_yshift) / determinant};
+}
@@ -1,8 +1,11 @@
 #ifndef NINJACLOWN_VIEW_MAP_VIEWER_HPP
 #define NINJACLOWN_VIEW_MAP_VIEWER_HPP
 
+#include <optional>
+
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/Vector2.hpp>
 
 #include "utils/synchronized.hpp"
@@ -10,11 +13,12 @@
 
 #include "map.hpp"
 #include "overmap_collection.hpp"
+#include "render_list.hpp"
 
 namespace sf {
 class RenderWindow;
 class Sprite;
-class RectangleShape;
+class Texture;
 }
 
 namespace adapter {
@@ -52,26 +56,76 @@ public:
 	}
 
 	/**
-	 * Prints the map plus some tooltip infos
+	 * Fills commands() with the map, the projectiles and the overmap as seen through `camera`, plus the infos of the hovered
+	 * entities and tile if `show_debug_data` is set. No render target is involved: this can run headless (eg: benchmarks).
+	 */
+	void build(const camera &camera, bool show_debug_data);
+
+	/**
+	 * Prints the map plus some tooltip infos: builds the render list for the window, then submits it
 	 */
 	void print(bool show_debug_data);
+
 	/**
-	 * Prints some tooltip infos
+	 * Commands built by the last call to build
 	 */
-	void print_tile_info(bool show_debug_data);
+	[[nodiscard]] const render_list &commands() const noexcept {
+		return m_commands;
+	}
 
     // converts world grid coords to on-screen coords
     sf::Vector2f to_screen_coords(float x, float y) const noexcept;
 
+    // converts on-screen coords to world grid coords
+    sf::Vector2f to_world_coords(sf::Vector2f screen) const noexcept;
+
     // coords within the viewport
     sf::Vector2f get_mouse_pos() const noexcept;
 
-    void draw(sf::Sprite&);
+    // the following add to the render list being built
 
-    void draw(sf::RectangleShape&);
+    void draw(const sf::Sprite&);
+
+    void draw(sf::FloatRect rect, sf::Color color);
+
+    // `vertices` is referenced until the list is submitted
+    void draw(const sf::VertexArray& vertices, const sf::Texture* texture);
+
+    // part of the map currently within the window, in on-screen coords
+    [[nodiscard]] sf::FloatRect visible_area() const noexcept;
+
+    /**
+     * To be called when the cell (x, y) changed, so that its tile is baked again
+     */
+    void invalidate_tile(std::size_t x, std::size_t y) {
+		m_map.acquire()->invalidate(x, y);
+    }
+
+    /**
+     * Changes the tile of the cell (x, y), baking it again
+     */
+    void set_tile(std::size_t x, std::size_t y, map::cell value) {
+		m_map.acquire()->set_cell(x, y, value);
+    }
+
+    /**
+     * @return the tile of the cell (x, y), or nothing if it is out of the map
+     */
+    [[nodiscard]] std::optional<map::cell> tile_at(std::size_t x, std::size_t y) {
+		auto map = m_map.acquire();
+		if (!map->contains(x, y)) {
+			return {};
+		}
+		return map->cell_at(x, y);
+    }
 
     void highlight_tile(sf::Vector2i tile_coord);
 
+    /**
+     * Replaces projectiles positions (world coordinates)
+     */
+    void set_projectiles(const std::vector<float>& xs, const std::vector<float>& ys);
+
 	[[nodiscard]] unsigned int current_frame() const noexcept {
 		return m_current_frame;
 	}
@@ -82,6 +136,19 @@ public:
 		return m_starting_time;
 	}
 
+	// amount of animation frames elapsed since the map was loaded: sprites only change when it does
+	[[nodiscard]] std::size_t animation_step() const noexcept;
+
+	// to be called while building when something on screen has more than one animation frame
+	void show_animated() noexcept {
+		m_shows_animations = true;
+	}
+
+	// whether the last built frame showed something that changes with animation_step()
+	[[nodiscard]] bool shows_animations() const noexcept {
+		return m_shows_animations;
+	}
+
     [[nodiscard]] bool is_filled() const noexcept {
 		return !m_map.acquire()->empty();
     }
@@ -92,6 +159,12 @@ public:
 
 private:
 
+	// all projectiles are drawn as untextured quads
+	void print_projectiles();
+
+	// displays the tooltip of the render list in a corner of the window, through ImGui
+	void print_tooltip();
+
 	void set_map(std::vector<std::vector<map::cell>>&& new_map) {
         auto map = m_map.acquire();
         map->set(std::move(new_map));
@@ -106,12 +179,17 @@ private:
 
     utils::synchronized_moveable<overmap_collection> m_overmap{};
     utils::synchronized_moveable<map, utils::spinlock> m_map{};
+    utils::synchronized_moveable<std::vector<sf::Vector2f>, utils::spinlock> m_projectiles{};
 	sf::Vector2u m_level_size{};
 
+	render_list m_commands{};
+	camera m_camera{}; //! camera of the render list being built
+
 	sf::FloatRect m_viewport{};
 	sf::FloatRect m_drawing_region_viewport{};
 
 	unsigned int m_current_frame{};
+	bool m_shows_animations{false};
 
 
     friend class adapter::adapter;
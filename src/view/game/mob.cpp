@@ -11,7 +11,8 @@ void view::mob::set_mob_id(utils::resources_type::mob_id id) {
 }
 
 void view::mob::reload_sprites() {
-	auto anim = utils::resource_manager::instance().mob_animations(m_mob_id);
+	const auto resources = utils::resource_manager::instance();
+	auto anim            = resources->mob_animations(m_mob_id);
 	assert(anim);
     m_animations = std::make_unique<view::mob_animations>(*anim);
 }
@@ -11,7 +11,8 @@ void view::object::set_id(utils::resources_type::object_id id) {
 }
 
 void view::object::reload_sprites() {
-	utils::optional<const shifted_animation &> animation = utils::resource_manager::instance().object_animation(m_object_id);
+	const auto resources                                 = utils::resource_manager::instance();
+	utils::optional<const shifted_animation &> animation = resources->object_animation(m_object_id);
 	assert(animation);
 	m_animation = std::make_unique<view::shifted_animation>(*animation);
 }
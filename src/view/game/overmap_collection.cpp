@@ -2,12 +2,11 @@
 #include "overmap_collection.hpp"
 #include "adapter/adapter.hpp"
 #include "utils/logging.hpp"
+#include "utils/profiler.hpp"
 #include "utils/resource_manager.hpp"
 #include "utils/visitor.hpp"
 #include "view/game/map_viewer.hpp"
 
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/RenderWindow.hpp>
 #include <spdlog/spdlog.h>
 
 using fmt::literals::operator""_a;
@@ -22,19 +21,42 @@ void view::overmap_collection::reload_sprites() noexcept {
 }
 
 void view::overmap_collection::clear() noexcept {
-	m_ordered_displayable.clear();
+	m_draw_order.clear();
+	m_draw_order_dirty = false;
+	m_picking.clear();
 	m_mobs.clear();
 	m_objects.clear();
 }
 
+void view::overmap_collection::sort_draw_order() noexcept {
+	if (!m_draw_order_dirty) {
+		return;
+	}
+	NINJACLOWN_PROFILE_SCOPE("overmap_collection::sort_draw_order");
+
+	for (std::size_t i = 1; i < m_draw_order.size(); ++i) {
+		const adapter::view_handle handle            = m_draw_order[i];
+		const overmap_displayable_interface &current = displayable(handle);
+
+		std::size_t slot = i;
+		for (; slot > 0 && current < displayable(m_draw_order[slot - 1]); --slot) {
+			m_draw_order[slot] = m_draw_order[slot - 1];
+		}
+		m_draw_order[slot] = handle;
+	}
+	m_draw_order_dirty = false;
+}
+
 void view::overmap_collection::print_all(view::map_viewer &viewer) const noexcept {
-	for (const auto &displayable : m_ordered_displayable) {
-		displayable.first->print(viewer);
+	NINJACLOWN_PROFILE_SCOPE("overmap_collection::print_all");
+	for (adapter::view_handle handle : m_draw_order) {
+		displayable(handle).print(viewer);
 	}
 }
 
 std::vector<std::vector<std::string>> view::overmap_collection::print_all(view::map_viewer &viewer,
                                                                           adapter::adapter &adapter) const noexcept {
+	NINJACLOWN_PROFILE_SCOPE("overmap_collection::print_all");
 
 	std::vector<std::string> local_info;
 	utils::visitor request_visitor{[&](const adapter::request::hitbox &hitbox) {
@@ -44,11 +66,8 @@ std::vector<std::vector<std::string>> view::overmap_collection::print_all(view::
 		                               screen_width -= screen_x;
 		                               screen_height -= screen_y;
 
-		                               sf::RectangleShape rect{{screen_width, screen_height}};
-		                               rect.setPosition(screen_x, screen_y);
-		                               rect.setFillColor(sf::Color{128, 255, 128, 128}); // todo externalize
-
-		                               viewer.draw(rect);
+		                               viewer.draw(sf::FloatRect{screen_x, screen_y, screen_width, screen_height},
+		                                           sf::Color{128, 255, 128, 128}); // todo externalize
 	                               },
 	                               [&](const adapter::request::coords &coord) {
 		                               viewer.highlight_tile({static_cast<int>(coord.x), static_cast<int>(coord.y)});
@@ -57,18 +76,28 @@ std::vector<std::vector<std::string>> view::overmap_collection::print_all(view::
 		                               std::move(info.lines.begin(), info.lines.end(), std::back_inserter(local_info));
 	                               }};
 
+	print_all(viewer);
+
+	std::vector<adapter::view_handle> hovered;
+	const sf::Vector2f cursor = viewer.to_world_coords(viewer.get_mouse_pos());
+	m_picking.visit_near(cursor.x, cursor.y, pick_radius, [&](adapter::view_handle handle) {
+		if (displayable(handle).is_hovered(viewer)) {
+			hovered.push_back(handle);
+		}
+	});
+	// buckets are visited in no meaningful order
+	std::sort(hovered.begin(), hovered.end(), [](adapter::view_handle lhs, adapter::view_handle rhs) {
+		return std::pair{lhs.is_mob, lhs.handle} < std::pair{rhs.is_mob, rhs.handle};
+	});
+
 	std::vector<std::vector<std::string>> ret;
-	for (const auto &displayable : m_ordered_displayable) {
-		displayable.first->print(viewer);
-		if (displayable.first->is_hovered(viewer)) {
-			local_info.clear();
-			adapter::draw_request requests = adapter.tooltip_for(displayable.second);
-			for (const adapter::draw_request::value_type &request : requests) {
-				std::visit(request_visitor, request);
-			}
-			if (!local_info.empty()) {
-				ret.emplace_back(std::move(local_info));
-			}
+	for (adapter::view_handle handle : hovered) {
+		local_info.clear();
+		for (const adapter::draw_request::value_type &request : adapter.tooltip_for(handle)) {
+			std::visit(request_visitor, request);
+		}
+		if (!local_info.empty()) {
+			ret.emplace_back(std::move(local_info));
 		}
 	}
 	return ret;
@@ -77,42 +106,40 @@ std::vector<std::vector<std::string>> view::overmap_collection::print_all(view::
 adapter::view_handle view::overmap_collection::add_object(object &&obj) noexcept {
 	adapter::view_handle handle{false, m_objects.size()};
 	m_objects.emplace_back(std::move(obj));
-	m_ordered_displayable.emplace(&m_objects.back(), handle);
+	m_picking.place(handle, m_objects.back().posx(), m_objects.back().posy());
+	m_draw_order.push_back(handle);
+	m_draw_order_dirty = true;
 	return handle;
 }
 
 adapter::view_handle view::overmap_collection::add_mob(mob &&mb) noexcept {
 	adapter::view_handle handle{true, m_mobs.size()};
 	m_mobs.emplace_back(std::move(mb));
-	m_ordered_displayable.emplace(&m_mobs.back(), handle);
+	m_picking.place(handle, m_mobs.back().posx(), m_mobs.back().posy());
+	m_draw_order.push_back(handle);
+	m_draw_order_dirty = true;
 	return handle;
 }
 
 void view::overmap_collection::move_entity(adapter::view_handle handle, float newx, float newy) {
-	const auto& res = utils::resource_manager::instance();
-
-	auto it = std::find_if(m_ordered_displayable.begin(), m_ordered_displayable.end(), [handle](const auto &entity) {
-		return entity.second == handle;
-	});
-
-	if (it == m_ordered_displayable.end()) {
+	if (!contains(handle)) {
 		utils::log::error("overmap_collection.unknown_entity_move", "is_mob"_a = handle.is_mob, "handle"_a = handle.handle);
 		spdlog::error("Tried to move unknown view entity {{{} {}}}", handle.is_mob, handle.handle);
 		return;
 	}
 
-	m_ordered_displayable.erase(it);
-	auto target = std::next(m_mobs.begin(), handle.handle);
 	if (handle.is_mob) {
-		utils::log::trace( "overmap_collection.moving_mob", "handle"_a = handle.handle, "x"_a = newx, "y"_a = newy);
-		target->set_pos(newx, newy);
-		m_ordered_displayable.emplace(std::pair{&*target, handle});
+		static const utils::log::key_id moving_mob = utils::log::intern("overmap_collection.moving_mob");
+		utils::log::trace(moving_mob, "handle"_a = handle.handle, "x"_a = newx, "y"_a = newy);
+		m_mobs[handle.handle].set_pos(newx, newy);
 	}
 	else {
-		utils::log::trace("overmap_collection.moving_object", "handle"_a = handle.handle, "x"_a = newx, "y"_a = newy);
-		target->set_pos(newx, newy);
-		m_ordered_displayable.emplace(std::pair{&*target, handle});
+		static const utils::log::key_id moving_object = utils::log::intern("overmap_collection.moving_object");
+		utils::log::trace(moving_object, "handle"_a = handle.handle, "x"_a = newx, "y"_a = newy);
+		m_objects[handle.handle].set_pos(newx, newy);
 	}
+	m_picking.place(handle, displayable(handle).posx(), displayable(handle).posy());
+	m_draw_order_dirty = true;
 }
 
 void view::overmap_collection::rotate_entity(adapter::view_handle handle,
@@ -122,23 +149,27 @@ void view::overmap_collection::rotate_entity(adapter::view_handle handle,
 		return;
 	}
 
-	std::next(m_mobs.begin(), handle.handle)->set_direction(new_direction);
+	m_mobs[handle.handle].set_direction(new_direction);
 }
 
 void view::overmap_collection::hide(adapter::view_handle handle) {
-	if (handle.is_mob) {
-		std::next(m_mobs.begin(), handle.handle)->hide();
-	}
-	else {
-		std::next(m_objects.begin(), handle.handle)->hide();
-	}
+	displayable(handle).hide();
 }
 
 void view::overmap_collection::reveal(adapter::view_handle handle) {
+	displayable(handle).reveal();
+}
+
+view::overmap_displayable_interface &view::overmap_collection::displayable(adapter::view_handle handle) noexcept {
 	if (handle.is_mob) {
-		std::next(m_mobs.begin(), handle.handle)->reveal();
+		return m_mobs[handle.handle];
 	}
-	else {
-		std::next(m_objects.begin(), handle.handle)->reveal();
+	return m_objects[handle.handle];
+}
+
+const view::overmap_displayable_interface &view::overmap_collection::displayable(adapter::view_handle handle) const noexcept {
+	if (handle.is_mob) {
+		return m_mobs[handle.handle];
 	}
+	return m_objects[handle.handle];
 }
@@ -3,11 +3,11 @@
 
 #include "mob.hpp"
 #include "object.hpp"
+#include "picking_grid.hpp"
 
 #include "adapter/adapter.hpp"
 
-#include <list>
-#include <set>
+#include <vector>
 
 namespace utils {
 class resource_manager;
@@ -16,18 +16,23 @@ class resource_manager;
 namespace view {
 class map_viewer;
 
+/**
+ * Mobs and objects, stored contiguously and indexed by their view handle. They are drawn by increasing y, the draw order being
+ * re-sorted at most once per frame, when something moved.
+ */
 class overmap_collection {
-	using pair_type = std::pair<const overmap_displayable_interface *, adapter::view_handle>;
-
-	struct less {
-		bool operator()(const pair_type &rhs, const pair_type &lhs) const noexcept {
-			return *rhs.first < *lhs.first;
-		}
-	};
-
 public:
+	//! sprites may be drawn that many cells away from the position of their entity
+	static constexpr int pick_radius = 2;
+
 	void reload_sprites() noexcept;
 
+	/**
+	 * Restores the drawing order after some entities moved. Insertion sort: close to linear, as few entities move by more than
+	 * one place at each frame.
+	 */
+	void sort_draw_order() noexcept;
+
 	void print_all(map_viewer &) const noexcept;
 
 	[[nodiscard]] std::vector<std::vector<std::string>> print_all(map_viewer &, adapter::adapter &) const noexcept;
@@ -45,10 +50,23 @@ public:
 	void clear() noexcept;
 
 private:
-	std::multiset<pair_type, less> m_ordered_displayable;
+	[[nodiscard]] bool contains(adapter::view_handle handle) const noexcept {
+		return handle.handle < (handle.is_mob ? m_mobs.size() : m_objects.size());
+	}
+
+	[[nodiscard]] overmap_displayable_interface &displayable(adapter::view_handle handle) noexcept;
+	[[nodiscard]] const overmap_displayable_interface &displayable(adapter::view_handle handle) const noexcept;
+
+	// indexed by view_handle::handle
+	std::vector<mob> m_mobs;
+	std::vector<object> m_objects;
+
+	// handles of every mob and object, by increasing y once sorted
+	std::vector<adapter::view_handle> m_draw_order;
+	bool m_draw_order_dirty{false};
 
-	std::list<mob> m_mobs;
-	std::list<object> m_objects;
+	// only the entities close to the cursor are tested for hovering
+	picking_grid m_picking{};
 };
 } // namespace view
 
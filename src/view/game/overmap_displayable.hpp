@@ -20,6 +20,14 @@ public:
 		return !m_hidden && vis_hovered(v);
 	}
 
+	[[nodiscard]] float posx() const noexcept {
+		return p_posx;
+	}
+
+	[[nodiscard]] float posy() const noexcept {
+		return p_posy;
+	}
+
 	bool operator<(const overmap_displayable_interface& other) const noexcept {
 		return p_posy < other.p_posy;
 	}
@@ -0,0 +1,33 @@
+#include <cmath>
+
+#include "view/game/picking_grid.hpp"
+
+void view::picking_grid::clear() noexcept {
+	for (std::vector<adapter::view_handle> &bucket : m_buckets) {
+		bucket.clear();
+	}
+	m_mob_buckets.clear();
+	m_object_buckets.clear();
+}
+
+void view::picking_grid::place(adapter::view_handle handle, float x, float y) {
+	std::vector<std::size_t> &buckets = handle.is_mob ? m_mob_buckets : m_object_buckets;
+	if (handle.handle >= buckets.size()) {
+		buckets.resize(handle.handle + 1, no_bucket);
+	}
+
+	const std::size_t new_bucket = bucket_of(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)));
+	std::size_t &current_bucket  = buckets[handle.handle];
+	if (current_bucket == new_bucket) {
+		return;
+	}
+
+	if (current_bucket != no_bucket) {
+		std::vector<adapter::view_handle> &bucket = m_buckets[current_bucket];
+		auto it                                   = std::find(bucket.begin(), bucket.end(), handle);
+		*it                                       = bucket.back();
+		bucket.pop_back();
+	}
+	m_buckets[new_bucket].push_back(handle);
+	current_bucket = new_bucket;
+}
@@ -0,0 +1,78 @@
+#ifndef NINJACLOWN_VIEW_PICKING_GRID_HPP
+#define NINJACLOWN_VIEW_PICKING_GRID_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "adapter/adapter.hpp"
+
+namespace view {
+
+/**
+ * Mobs and objects bucketed by the world cell they stand on, so that only the ones close to the cursor are tested when
+ * looking for hovered entities. Cells are hashed into a fixed amount of buckets: a bucket may hold entities from
+ * unrelated cells, which only costs a few more tests.
+ */
+class picking_grid {
+public:
+	static constexpr std::size_t bucket_count = 1024; //!< power of two
+	static constexpr int max_radius           = 3;
+
+	picking_grid()
+	    : m_buckets(bucket_count) { }
+
+	void clear() noexcept;
+
+	/**
+	 * Inserts the entity, or moves it to the bucket of its new position
+	 */
+	void place(adapter::view_handle handle, float x, float y);
+
+	/**
+	 * Calls func(handle) once for every entity standing within `radius` cells of (x, y), and maybe a few others
+	 */
+	template <typename Func>
+	void visit_near(float x, float y, int radius, Func &&func) const {
+		radius = std::min(radius, max_radius);
+
+		std::array<std::size_t, (2 * max_radius + 1) * (2 * max_radius + 1)> buckets{};
+		std::size_t count{0};
+		const int cell_x = static_cast<int>(std::floor(x));
+		const int cell_y = static_cast<int>(std::floor(y));
+		for (int dx = -radius; dx <= radius; ++dx) {
+			for (int dy = -radius; dy <= radius; ++dy) {
+				buckets[count++] = bucket_of(cell_x + dx, cell_y + dy);
+			}
+		}
+
+		// distinct cells may share a bucket
+		std::sort(buckets.begin(), buckets.begin() + count);
+		const auto end = std::unique(buckets.begin(), buckets.begin() + count);
+		for (auto it = buckets.begin(); it != end; ++it) {
+			for (adapter::view_handle handle : m_buckets[*it]) {
+				func(handle);
+			}
+		}
+	}
+
+private:
+	static constexpr std::size_t no_bucket = bucket_count;
+
+	[[nodiscard]] static std::size_t bucket_of(int x, int y) noexcept {
+		const auto hash = static_cast<std::size_t>(x) * 73856093u ^ static_cast<std::size_t>(y) * 19349663u; // NOLINT
+		return hash & (bucket_count - 1);
+	}
+
+	std::vector<std::vector<adapter::view_handle>> m_buckets;
+
+	// bucket holding each entity, indexed by view_handle::handle
+	std::vector<std::size_t> m_mob_buckets{};
+	std::vector<std::size_t> m_object_buckets{};
+};
+
+} // namespace view
+
+#endif //NINJACLOWN_VIEW_PICKING_GRID_HPP
@@ -0,0 +1,63 @@
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Window/Mouse.hpp>
+
+#include "render_list.hpp"
+
+view::camera view::camera::of(const sf::RenderWindow &window) noexcept {
+	return {window.getView(), window.getSize(), sf::Mouse::getPosition(window)};
+}
+
+void view::render_list::clear() noexcept {
+	m_vertices.clear();
+	m_batches.clear();
+	m_tooltip.clear();
+}
+
+void view::render_list::add_sprite(const sf::Sprite &sprite) {
+	const sf::IntRect rect = sprite.getTextureRect();
+	const sf::Vector2f pos = sprite.getPosition();
+	const sf::Vector2f size{static_cast<float>(rect.width), static_cast<float>(rect.height)};
+	const sf::Vector2f tex{static_cast<float>(rect.left), static_cast<float>(rect.top)};
+	const sf::Color color = sprite.getColor();
+
+	batch_for(sprite.getTexture()).vertex_count += 4;
+	m_vertices.emplace_back(pos, color, tex);
+	m_vertices.emplace_back(sf::Vector2f{pos.x + size.x, pos.y}, color, sf::Vector2f{tex.x + size.x, tex.y});
+	m_vertices.emplace_back(pos + size, color, tex + size);
+	m_vertices.emplace_back(sf::Vector2f{pos.x, pos.y + size.y}, color, sf::Vector2f{tex.x, tex.y + size.y});
+}
+
+void view::render_list::add_rect(sf::FloatRect rect, sf::Color color) {
+	batch_for(nullptr).vertex_count += 4;
+	m_vertices.emplace_back(sf::Vector2f{rect.left, rect.top}, color);
+	m_vertices.emplace_back(sf::Vector2f{rect.left + rect.width, rect.top}, color);
+	m_vertices.emplace_back(sf::Vector2f{rect.left + rect.width, rect.top + rect.height}, color);
+	m_vertices.emplace_back(sf::Vector2f{rect.left, rect.top + rect.height}, color);
+}
+
+void view::render_list::add_baked(const sf::VertexArray &vertices, const sf::Texture *texture) {
+	if (vertices.getVertexCount() != 0) {
+		m_batches.push_back({texture, &vertices, 0, vertices.getVertexCount()});
+	}
+}
+
+void view::render_list::submit(sf::RenderTarget &target) const {
+	for (const batch &batch : m_batches) {
+		if (batch.baked != nullptr) {
+			target.draw(*batch.baked, sf::RenderStates{batch.texture});
+		}
+		else {
+			target.draw(m_vertices.data() + batch.first_vertex, batch.vertex_count, sf::Quads, sf::RenderStates{batch.texture});
+		}
+	}
+}
+
+view::render_list::batch &view::render_list::batch_for(const sf::Texture *texture) {
+	if (m_batches.empty() || m_batches.back().baked != nullptr || m_batches.back().texture != texture) {
+		m_batches.push_back({texture, nullptr, m_vertices.size(), 0});
+	}
+	return m_batches.back();
+}
@@ -0,0 +1,102 @@
+#ifndef NINJACLOWN_VIEW_RENDER_LIST_HPP
+#define NINJACLOWN_VIEW_RENDER_LIST_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Vector2.hpp>
+
+namespace sf {
+class RenderTarget;
+class RenderWindow;
+class Sprite;
+class Texture;
+class VertexArray;
+} // namespace sf
+
+namespace view {
+
+/**
+ * What a frame is built for: the view of the render target, its size and the position of the mouse
+ */
+struct camera {
+	sf::View view{};
+	sf::Vector2u target_size{};
+	std::optional<sf::Vector2i> mouse{}; //!< relative to the target, empty if unknown
+
+	[[nodiscard]] static camera of(const sf::RenderWindow &window) noexcept;
+};
+
+/**
+ * Flat list of what the game view draws in a frame, built without touching any render target then submitted at once.
+ * Consecutive quads sharing a texture are merged in a single draw call. The list is meant to be cleared and refilled every
+ * frame, reusing its storage.
+ */
+class render_list {
+public:
+	struct batch {
+		const sf::Texture *texture{nullptr};
+		const sf::VertexArray *baked{nullptr}; //!< quads stored out of the list, or nullptr if they are in vertices()
+		std::size_t first_vertex{0};
+		std::size_t vertex_count{0};
+	};
+
+	void clear() noexcept;
+
+	/**
+	 * Adds the sprite as a quad, at its current position and with its current color. Sprites are expected not to be scaled
+	 * nor rotated.
+	 */
+	void add_sprite(const sf::Sprite &sprite);
+
+	/**
+	 * Adds an untextured quad (highlights, projectiles, ...)
+	 */
+	void add_rect(sf::FloatRect rect, sf::Color color);
+
+	/**
+	 * Adds quads that were baked beforehand. They are not copied: `vertices` must stay untouched until the list was submitted.
+	 */
+	void add_baked(const sf::VertexArray &vertices, const sf::Texture *texture);
+
+	/**
+	 * Lines of text to display next to the map, by group
+	 */
+	[[nodiscard]] std::vector<std::vector<std::string>> &tooltip() noexcept {
+		return m_tooltip;
+	}
+
+	[[nodiscard]] const std::vector<std::vector<std::string>> &tooltip() const noexcept {
+		return m_tooltip;
+	}
+
+	[[nodiscard]] const std::vector<batch> &batches() const noexcept {
+		return m_batches;
+	}
+
+	[[nodiscard]] const std::vector<sf::Vertex> &vertices() const noexcept {
+		return m_vertices;
+	}
+
+	/**
+	 * Draws every batch, in insertion order. Tooltips are left to the caller.
+	 */
+	void submit(sf::RenderTarget &target) const;
+
+private:
+	// returns the batch new quads with this texture should be appended to
+	batch &batch_for(const sf::Texture *texture);
+
+	std::vector<sf::Vertex> m_vertices{};
+	std::vector<batch> m_batches{};
+	std::vector<std::vector<std::string>> m_tooltip{};
+};
+} // namespace view
+
+#endif //NINJACLOWN_VIEW_RENDER_LIST_HPP
@@ -71,7 +71,7 @@ const T *combo(std::string_view label, const std::vector<T> &choices, const lang
 
 
 void view::configurator::give_control() noexcept {
-	auto& resources = utils::resource_manager::instance();
+	const auto resources = utils::resource_manager::instance();
 
 	m_graphics_changed = false;
 	if (!m_showing) {
@@ -82,8 +82,8 @@ void view::configurator::give_control() noexcept {
 				m_popup_open = false;
 			}
 
-			if (m_config_must_be_saved) {
-				if (!resources.save_user_config()) {
+			if (m_config_must_be_saved && m_selected) {
+				if (!utils::resource_manager::save_config(*m_selected)) {
 					utils::log::warn("view.configurator.config_save_failed");
 				}
 				m_config_must_be_saved = false;
@@ -94,8 +94,8 @@ void view::configurator::give_control() noexcept {
 	if (!m_popup_open) {
 		ImGui::OpenPopup(window_name);
 		m_popup_open = true;
-		resources.refresh_language_list();
-		resources.refresh_resource_pack_list();
+		resources->refresh_language_list();
+		resources->refresh_resource_pack_list();
 	}
 
 	if (!ImGui::BeginPopupModal(window_name, nullptr,
@@ -107,11 +107,11 @@ void view::configurator::give_control() noexcept {
 	const ImGuiStyle &style = ImGui::GetStyle();
 
 	std::array<std::string_view, idx::MAX> labels;
-	labels[idx::general_lang]  = resources.gui_text_for("configurator.general_lang");
-	labels[idx::command_lang]  = resources.gui_text_for("configurator.command_lang");
-	labels[idx::gui_lang]      = resources.gui_text_for("configurator.gui_lang");
-	labels[idx::log_lang]      = resources.gui_text_for("configurator.log_lang");
-	labels[idx::resource_pack] = resources.gui_text_for("configurator.resource_pack");
+	labels[idx::general_lang]  = resources->gui_text_for("configurator.general_lang");
+	labels[idx::command_lang]  = resources->gui_text_for("configurator.command_lang");
+	labels[idx::gui_lang]      = resources->gui_text_for("configurator.gui_lang");
+	labels[idx::log_lang]      = resources->gui_text_for("configurator.log_lang");
+	labels[idx::resource_pack] = resources->gui_text_for("configurator.resource_pack");
 
 	float labels_width{0};
 	for (const std::string_view str : labels) {
@@ -119,10 +119,14 @@ void view::configurator::give_control() noexcept {
 	}
 	labels_width += style.ItemSpacing.x;
 
+	// changes are applied once the new resources are loaded
+	utils::resource_manager::selection selected = m_selected.value_or(resources->user_selection());
+	bool selection_changed{false};
+
 	// langs
 	{
 
-		const auto &langs = resources.get_language_list();
+		const auto &langs = resources->get_language_list();
 		float combo_width{0};
 		for (const auto &lang : langs) {
 			combo_width = std::max(ImGui::CalcTextSize(display_name(lang).c_str()).x, combo_width);
@@ -130,26 +134,26 @@ void view::configurator::give_control() noexcept {
 		combo_width += style.ItemInnerSpacing.x;
 
 		const lang_info *selection = nullptr;
-		if (selection = combo(labels[idx::general_lang], langs, resources.user_general_lang(), labels_width, combo_width);
+		if (selection = combo(labels[idx::general_lang], langs, resources->user_general_lang(), labels_width, combo_width);
 		    selection != nullptr) {
-			resources.set_user_general_lang(*selection);
-			m_config_must_be_saved = true;
+			selected.general_lang = selection->file;
+			selection_changed     = true;
 		}
-		if (selection = combo(labels[idx::command_lang], langs, resources.user_commands_lang(), labels_width, combo_width);
+		if (selection = combo(labels[idx::command_lang], langs, resources->user_commands_lang(), labels_width, combo_width);
 		    selection != nullptr) {
-			resources.set_user_command_lang(*selection);
-			m_config_must_be_saved = true;
+			selected.command_lang = selection->file;
+			selection_changed     = true;
 		}
-		if (selection = combo(labels[idx::gui_lang], langs, resources.user_gui_lang(), labels_width, combo_width); selection != nullptr) {
-			resources.set_user_gui_lang(*selection);
-			m_config_must_be_saved = true;
+		if (selection = combo(labels[idx::gui_lang], langs, resources->user_gui_lang(), labels_width, combo_width); selection != nullptr) {
+			selected.gui_lang = selection->file;
+			selection_changed = true;
 		}
-		if (selection = combo(labels[idx::log_lang], langs, resources.user_log_lang(), labels_width, combo_width); selection != nullptr) {
-			resources.set_user_log_lang(*selection);
-			m_config_must_be_saved = true;
+		if (selection = combo(labels[idx::log_lang], langs, resources->user_log_lang(), labels_width, combo_width); selection != nullptr) {
+			selected.log_lang = selection->file;
+			selection_changed = true;
 		}
 
-		std::string_view import_lang = resources.gui_text_for("configurator.import_lang");
+		std::string_view import_lang = resources->gui_text_for("configurator.import_lang");
 		using_style(disabled_button) {
 			if (ImGui::Button(import_lang.data(), {ImGui::GetContentRegionAvail().x, 0})) {
 
@@ -161,19 +165,20 @@ void view::configurator::give_control() noexcept {
 
 	// resource pack
 	{
-		const std::vector<utils::resource_manager::resource_pack_info> &resource_packs = resources.get_resource_pack_list();
+		const std::vector<utils::resource_manager::resource_pack_info> &resource_packs = resources->get_resource_pack_list();
 
 		ImGui::TextUnformatted(labels[idx::resource_pack].data(), labels[idx::resource_pack].data() + labels[idx::resource_pack].size());
 		ImGui::SameLine(labels_width);
 		ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
 		if (ImGui::BeginCombo("##configurator.resource_pack",
-		                      display_name(resources.user_resource_pack(), resources.user_gui_lang()).c_str(),
+		                      display_name(resources->user_resource_pack(), resources->user_gui_lang()).c_str(),
 		                      ImGuiComboFlags_NoArrowButton)) {
 			for (const auto &res_pack : resource_packs) {
-				bool is_selected = (res_pack.file == resources.user_gui_lang().file);
-				if (ImGui::Selectable(display_name(res_pack, resources.user_gui_lang()).c_str(), is_selected)) {
-					resources.set_user_resource_pack(res_pack);
-					m_graphics_changed = true;
+				bool is_selected = (res_pack.file == resources->user_resource_pack().file);
+				if (ImGui::Selectable(display_name(res_pack, resources->user_gui_lang()).c_str(), is_selected)) {
+					selected.resource_pack = res_pack.file;
+					selection_changed      = true;
+					m_graphics_changed     = true;
 				}
 				if (is_selected) {
 					ImGui::SetItemDefaultFocus();
@@ -182,7 +187,7 @@ void view::configurator::give_control() noexcept {
 			ImGui::EndCombo();
 		}
 
-		std::string_view import_respack = resources.gui_text_for("configurator.import_respack");
+		std::string_view import_respack = resources->gui_text_for("configurator.import_respack");
         using_style(disabled_button) {
             if (ImGui::Button(import_respack.data(), {ImGui::GetContentRegionAvail().x, 0})) {
 
@@ -192,5 +197,13 @@ void view::configurator::give_control() noexcept {
 
 	ImGui::EndPopup();
 
+	if (selection_changed) {
+		if (!utils::resource_manager::reload_async(selected)) {
+			utils::log::warn("resource_manager.reload_failed");
+		}
+		m_selected             = std::move(selected);
+		m_config_must_be_saved = true;
+	}
+
 	// TODO: bouton pour quitter le menu de configuration
 }
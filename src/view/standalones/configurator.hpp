@@ -1,9 +1,9 @@
 #ifndef NINJACLOWN_VIEW_CONFIGURATOR_HPP
 #define NINJACLOWN_VIEW_CONFIGURATOR_HPP
 
-namespace utils {
-class resource_manager;
-}
+#include <optional>
+
+#include "utils/resource_manager.hpp"
 
 namespace view {
 
@@ -33,6 +33,8 @@ private:
 	bool m_popup_open{false};
 	bool m_showing{false};
 
+	// files selected by the user, loaded in the background
+	std::optional<utils::resource_manager::selection> m_selected{};
 	bool m_config_must_be_saved{false};
 	bool m_graphics_changed{false};
 };
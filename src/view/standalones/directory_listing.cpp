@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <system_error>
+
+#include "directory_listing.hpp"
+
+namespace {
+std::filesystem::file_time_type modification_time(const std::filesystem::path &directory) noexcept {
+	std::error_code ec;
+	auto time = std::filesystem::last_write_time(directory, ec);
+	return ec ? std::filesystem::file_time_type::min() : time;
+}
+} // namespace
+
+view::directory_listing::~directory_listing() {
+	{
+		std::lock_guard lock{m_mutex};
+		m_stopping = true;
+	}
+	m_cv.notify_all();
+	if (m_worker.joinable()) {
+		m_worker.join();
+	}
+}
+
+void view::directory_listing::request(const std::filesystem::path &directory) noexcept {
+	std::string key                                    = directory.generic_string();
+	const std::filesystem::file_time_type current_time = modification_time(directory);
+
+	std::lock_guard lock{m_mutex};
+	cached &listing     = m_cache[key];
+	listing.last_request = ++m_requests;
+	if (listing.generation != 0 && listing.modification_time == current_time && (listing.complete || m_listed == key)) {
+		return;
+	}
+
+	listing.modification_time = current_time;
+	listing.entries.clear();
+	listing.complete   = false;
+	listing.generation = ++m_generations;
+
+	if (m_cache.size() > max_cached_directories) {
+		auto oldest = std::min_element(m_cache.begin(), m_cache.end(), [](const auto &lhs, const auto &rhs) {
+			return lhs.second.last_request < rhs.second.last_request;
+		});
+		m_cache.erase(oldest);
+	}
+
+	m_listed  = std::move(key);
+	m_pending = directory;
+	if (!m_worker.joinable()) {
+		m_worker = std::thread{&directory_listing::work, this};
+	}
+	m_cv.notify_one();
+}
+
+bool view::directory_listing::fetch(const std::filesystem::path &directory, std::vector<entry> &received,
+                                    std::uint64_t &generation) const noexcept {
+	std::lock_guard lock{m_mutex};
+	auto it = m_cache.find(directory.generic_string());
+	if (it == m_cache.end()) {
+		return false;
+	}
+
+	const cached &listing = it->second;
+	if (listing.generation != generation) {
+		received.clear();
+		generation = listing.generation;
+	}
+	received.insert(received.end(), listing.entries.begin() + static_cast<std::ptrdiff_t>(received.size()), listing.entries.end());
+	return listing.complete;
+}
+
+void view::directory_listing::work() noexcept {
+	while (true) {
+		std::filesystem::path directory;
+		std::string key;
+		{
+			std::unique_lock lock{m_mutex};
+			m_cv.wait(lock, [this] { return m_stopping || m_pending; });
+			if (m_stopping) {
+				return;
+			}
+			directory = std::move(*m_pending);
+			key       = m_listed;
+			m_pending.reset();
+		}
+		list(key, directory);
+	}
+}
+
+void view::directory_listing::list(const std::string &key, const std::filesystem::path &directory) noexcept {
+	std::uint64_t generation{};
+	{
+		std::lock_guard lock{m_mutex};
+		auto it = m_cache.find(key);
+		if (it == m_cache.end()) {
+			return;
+		}
+		generation = it->second.generation;
+	}
+
+	std::vector<entry> batch;
+	batch.reserve(batch_size);
+
+	// moves the batch to the cache, returns false if the listing should be aborted
+	auto flush = [&](bool complete) {
+		std::lock_guard lock{m_mutex};
+		auto it = m_cache.find(key);
+		if (m_stopping || m_pending || it == m_cache.end() || it->second.generation != generation) {
+			return false;
+		}
+		std::move(batch.begin(), batch.end(), std::back_inserter(it->second.entries));
+		batch.clear();
+		it->second.complete = complete;
+		if (complete && m_listed == key) {
+			m_listed.clear();
+		}
+		return true;
+	};
+
+	std::error_code ec;
+	std::filesystem::directory_iterator it{directory, std::filesystem::directory_options::skip_permission_denied, ec};
+	for (; !ec && it != std::filesystem::directory_iterator{}; it.increment(ec)) {
+		std::error_code type_ec;
+		const bool is_directory = it->is_directory(type_ec);
+		std::string name        = it->path().filename().generic_string();
+		if (is_directory) {
+			name += '/';
+		}
+		batch.push_back({it->path(), std::move(name), it->path().extension().generic_string(), is_directory});
+
+		if (batch.size() == batch_size && !flush(false)) {
+			return;
+		}
+	}
+	flush(true);
+}
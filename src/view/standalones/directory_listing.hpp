@@ -0,0 +1,79 @@
+#ifndef NINJACLOWN_VIEW_DIRECTORY_LISTING_HPP
+#define NINJACLOWN_VIEW_DIRECTORY_LISTING_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace view {
+
+/**
+ * Content of directories, listed on a background thread and cached along with the directory's modification time.
+ * Entries are made available while the listing is in progress, by batches.
+ */
+class directory_listing {
+public:
+	static constexpr std::size_t batch_size             = 256;
+	static constexpr std::size_t max_cached_directories = 32;
+
+	struct entry {
+		std::filesystem::path path;
+		std::string name; //!< file name, followed by a '/' for directories
+		std::string extension;
+		bool is_directory;
+	};
+
+	directory_listing() = default;
+	~directory_listing();
+
+	directory_listing(const directory_listing &) = delete;
+	directory_listing &operator=(const directory_listing &) = delete;
+
+	/**
+	 * Starts listing `directory` in the background, unless it is being listed or its cached listing is up to date.
+	 * Listing another directory aborts the listing in progress.
+	 */
+	void request(const std::filesystem::path &directory) noexcept;
+
+	/**
+	 * Appends the entries of `directory` that were not received yet to `received`.
+	 * @param generation identifies the listing `received` comes from: `received` is emptied when the directory was listed again
+	 * @return true once `received` holds the whole listing
+	 */
+	bool fetch(const std::filesystem::path &directory, std::vector<entry> &received, std::uint64_t &generation) const noexcept;
+
+private:
+	struct cached {
+		std::filesystem::file_time_type modification_time{};
+		std::vector<entry> entries{};
+		std::uint64_t generation{};
+		std::uint64_t last_request{};
+		bool complete{false};
+	};
+
+	void work() noexcept;
+
+	// lists `directory`, until another directory is requested
+	void list(const std::string &key, const std::filesystem::path &directory) noexcept;
+
+	mutable std::mutex m_mutex{};
+	std::condition_variable m_cv{};
+	std::unordered_map<std::string, cached> m_cache{}; //!< by generic path
+	std::optional<std::filesystem::path> m_pending{}; //!< waiting to be picked by the worker
+	std::string m_listed{};                           //!< key of the directory pending or being listed
+	std::uint64_t m_requests{0}; //!< used to evict the least recently requested listings
+	std::uint64_t m_generations{0};
+	bool m_stopping{false};
+
+	std::thread m_worker{};
+};
+
+} // namespace view
+
+#endif //NINJACLOWN_VIEW_DIRECTORY_LISTING_HPP
@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cctype>
 #include <imgui.h>
+#include <string_view>
 #include <utility>
 
 #include "file_explorer.hpp"
@@ -14,10 +17,20 @@
 namespace {
 constexpr const char window_name[] = "##file explorer";
 std::optional<std::filesystem::path> glob_last_explored_folder{}; // TODO : si la classe est statique, cette variable est superflue (par rapport aux variables déjà présentes dans la classe)
+
+bool contains_case_insensitive(std::string_view text, std::string_view pattern) noexcept {
+	auto lower = [](char c) {
+		return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+	};
+	return std::search(text.begin(), text.end(), pattern.begin(), pattern.end(), [&lower](char lhs, char rhs) {
+		       return lower(lhs) == lower(rhs);
+	       })
+	       != text.end();
+}
 } // namespace
 
 void view::file_explorer::give_control() noexcept {
-	const auto& res= utils::resource_manager::instance();
+	const auto res= utils::resource_manager::instance();
 
 
 	if (!m_showing) {
@@ -40,13 +53,14 @@ void view::file_explorer::give_control() noexcept {
 	if (ImGui::BeginPopupModal(window_name)) {
 		auto &style = ImGui::GetStyle();
 
+		refresh_listing();
+
 		float text_height = ImGui::CalcTextSize(m_current.generic_string().c_str()).y;
 		ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4{0x0B / 255.f, 0x36 / 255.f, 0x85 / 255.f, 1.f});
 		if (ImGui::BeginChild("##full_path", ImVec2{0, text_height + style.ItemInnerSpacing.y * 2}), true) {
 			std::vector<std::string> splited_path;
 
-			bool is_file = std::filesystem::is_regular_file(m_current);
-			for (std::filesystem::path path = is_file ? m_current.parent_path() : m_current; path.parent_path() != path;
+			for (std::filesystem::path path = m_current_is_file ? m_current.parent_path() : m_current; path.parent_path() != path;
 			     path                       = path.parent_path()) {
 
 				splited_path.emplace_back(path.filename().generic_string());
@@ -90,80 +104,90 @@ void view::file_explorer::give_control() noexcept {
 		ImGui::EndChild();
 		ImGui::PopStyleColor();
 
+		const std::string filter_label{res->gui_text_for("file_explorer.filter")};
+		if (ImGui::InputText(filter_label.c_str(), m_filter.data(), m_filter.size())) {
+			m_directories.clear();
+			m_files.clear();
+			m_filtered_count = 0;
+		}
+
 		auto window_bg = ImGui::GetStyleColorVec4(ImGuiCol_PopupBg);
 		window_bg.w    = 1.f;
 		ImGui::PushStyleColor(ImGuiCol_ChildBg, window_bg);
 		if (ImGui::BeginChild("##file displayer", ImVec2{0, ImGui::GetContentRegionAvail().y - style.ItemSpacing.y * 2
 		                                                      - style.ItemInnerSpacing.y * 2 - text_height})) {
 
-			std::filesystem::path working_directory;
-			if (std::filesystem::is_regular_file(m_current)) {
-				working_directory = m_current.parent_path();
-			}
-			else {
-				working_directory = m_current;
-			}
-
-			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{0xCB / 255.f, 0x33 / 255.f, 0x25 / 255.f, 1.f});
-
-			if (ImGui::Selectable("../", working_directory.parent_path() == m_currently_selected, ImGuiSelectableFlags_AllowDoubleClick)) {
-				m_currently_selected = working_directory.parent_path();
-				if (ImGui::IsMouseDoubleClicked(0)) {
-					m_current = m_currently_selected;
-				}
-			}
-
-			for (const std::filesystem::directory_entry &file : std::filesystem::directory_iterator{working_directory}) {
-				if (!file.is_directory()) {
-					continue;
-				}
-				std::string file_name = file.path().filename().generic_string() + "/";
+			refresh_listing();
+
+			const std::size_t entry_rows = m_directories.size() + m_files.size();
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(1 + entry_rows + (m_listing_complete ? 0 : 1)));
+			while (clipper.Step()) {
+				for (auto row = static_cast<std::size_t>(clipper.DisplayStart); row < static_cast<std::size_t>(clipper.DisplayEnd); ++row) {
+					if (row == 0) {
+						ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{0xCB / 255.f, 0x33 / 255.f, 0x25 / 255.f, 1.f});
+						if (ImGui::Selectable("../", m_working_directory.parent_path() == m_currently_selected,
+						                      ImGuiSelectableFlags_AllowDoubleClick)) {
+							m_currently_selected = m_working_directory.parent_path();
+							if (ImGui::IsMouseDoubleClicked(0)) {
+								m_current = m_currently_selected;
+							}
+						}
+						ImGui::PopStyleColor();
+						continue;
+					}
 
-				if (ImGui::Selectable(file_name.c_str(), file.path() == m_currently_selected, ImGuiSelectableFlags_AllowDoubleClick)) {
-					if (ImGui::IsMouseDoubleClicked(0)) {
-						m_current = file.path();
+					if (row > entry_rows) {
+						// listing still in progress
+						ImGui::TextDisabled("...");
+						continue;
 					}
-					m_currently_selected = file.path();
-				}
-			}
-			ImGui::PopStyleColor();
 
-			for (const std::filesystem::directory_entry &file : std::filesystem::directory_iterator{working_directory}) {
-				if (file.is_directory()) {
-					continue;
-				}
+					const std::size_t index = row - 1;
+					if (index < m_directories.size()) {
+						const directory_listing::entry &file = m_entries[m_directories[index]];
+						ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{0xCB / 255.f, 0x33 / 255.f, 0x25 / 255.f, 1.f});
+						if (ImGui::Selectable(file.name.c_str(), file.path == m_currently_selected, ImGuiSelectableFlags_AllowDoubleClick)) {
+							if (ImGui::IsMouseDoubleClicked(0)) {
+								m_current = file.path;
+							}
+							m_currently_selected = file.path;
+						}
+						ImGui::PopStyleColor();
+						continue;
+					}
 
-				std::string file_name = file.path().filename().generic_string();
+					const directory_listing::entry &file = m_entries[m_files[index - m_directories.size()]];
 
-				unsigned int pop = 0;
-				if (std::find(m_prefered_extensions.begin(), m_prefered_extensions.end(), file.path().extension().generic_string())
-				    != m_prefered_extensions.end()) {
-					pop++;
-					ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{0xD9 / 255.f, 0xD9 / 255.f, 0x26 / 255.f, 1.f});
-				}
+					unsigned int pop = 0;
+					if (std::find(m_prefered_extensions.begin(), m_prefered_extensions.end(), file.extension) != m_prefered_extensions.end()) {
+						pop++;
+						ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{0xD9 / 255.f, 0xD9 / 255.f, 0x26 / 255.f, 1.f});
+					}
 
-				if (ImGui::Selectable(file_name.c_str(), file.path() == m_currently_selected, ImGuiSelectableFlags_AllowDoubleClick)) {
-					if (ImGui::IsMouseDoubleClicked(0)) {
-						m_current = file.path();
-						if (file.is_regular_file()) {
-							m_current     = file.path();
-							m_path_ready  = true;
-							m_showing     = false;
-							m_was_showing = false;
-							ImGui::CloseCurrentPopup();
+					if (ImGui::Selectable(file.name.c_str(), file.path == m_currently_selected, ImGuiSelectableFlags_AllowDoubleClick)) {
+						if (ImGui::IsMouseDoubleClicked(0)) {
+							m_current = file.path;
+							if (std::filesystem::is_regular_file(file.path)) {
+								m_path_ready  = true;
+								m_showing     = false;
+								m_was_showing = false;
+								ImGui::CloseCurrentPopup();
+							}
 						}
+						m_currently_selected = file.path;
 					}
-					m_currently_selected = file.path();
-				}
 
-				ImGui::PopStyleColor(pop);
+					ImGui::PopStyleColor(pop);
+				}
 			}
+			clipper.End();
 		}
 		ImGui::EndChild();
 		ImGui::PopStyleColor();
 
-		std::string_view ok_text     = res.gui_text_for("file_explorer.ok_button");
-		std::string_view cancel_text = res.gui_text_for("file_explorer.cancel_button");
+		std::string_view ok_text     = res->gui_text_for("file_explorer.ok_button");
+		std::string_view cancel_text = res->gui_text_for("file_explorer.cancel_button");
 
 		float text_width = ImGui::CalcTextSize(ok_text.data(), ok_text.data() + ok_text.size()).x
 		                   + ImGui::CalcTextSize(cancel_text.data(), cancel_text.data() + cancel_text.size()).x;
@@ -191,7 +215,34 @@ void view::file_explorer::give_control() noexcept {
 	}
 }
 
+void view::file_explorer::refresh_listing() noexcept {
+	if (m_current != m_listed_path) {
+		m_listed_path       = m_current;
+		m_current_is_file   = std::filesystem::is_regular_file(m_current);
+		m_working_directory = m_current_is_file ? m_current.parent_path() : m_current;
+		m_listing.request(m_working_directory);
+	}
+
+	const std::uint64_t previous_generation = m_generation;
+	m_listing_complete                      = m_listing.fetch(m_working_directory, m_entries, m_generation);
+	if (m_generation != previous_generation) {
+		m_directories.clear();
+		m_files.clear();
+		m_filtered_count = 0;
+	}
+
+	const std::string_view filter{m_filter.data()};
+	for (; m_filtered_count < m_entries.size(); ++m_filtered_count) {
+		const directory_listing::entry &entry = m_entries[m_filtered_count];
+		if (!filter.empty() && !contains_case_insensitive(entry.name, filter)) {
+			continue;
+		}
+		(entry.is_directory ? m_directories : m_files).push_back(m_filtered_count);
+	}
+}
+
 void view::file_explorer::open(with_extensions exts) noexcept {
+	m_listed_path.clear();
 	m_currently_selected.clear();
 	m_showing             = true;
 	m_prefered_extensions = std::move(exts.exts);
@@ -205,6 +256,7 @@ void view::file_explorer::open(with_extensions exts) noexcept {
 }
 
 void view::file_explorer::open(std::filesystem::path path, with_extensions exts) noexcept {
+	m_listed_path.clear();
 	m_currently_selected.clear();
 	m_current             = std::move(path);
 	m_showing             = true;
@@ -1,10 +1,14 @@
 #ifndef NINJACLOWN_FILE_EXPLORER_HPP
 #define NINJACLOWN_FILE_EXPLORER_HPP
 
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <vector>
 #include <utility>
 
+#include "view/standalones/directory_listing.hpp"
+
 namespace utils {
 class resource_manager;
 }
@@ -48,7 +52,15 @@ public:
 		return m_showing;
 	}
 
+	// true while the shown directory is still being listed in the background
+	[[nodiscard]] bool listing_in_progress() const noexcept {
+		return m_showing && !m_listing_complete;
+	}
+
 private:
+	// lists the directory of m_current if it changed, and filters the entries received since the last call
+	void refresh_listing() noexcept;
+
 	std::filesystem::path m_current{};
 	bool m_showing{false};
 	bool m_path_ready{false};
@@ -57,6 +69,21 @@ private:
 	std::filesystem::path m_currently_selected{};
 
 	std::vector<std::string> m_prefered_extensions{};
+
+	directory_listing m_listing{};
+	std::filesystem::path m_listed_path{}; //!< value of m_current when m_working_directory was computed
+	std::filesystem::path m_working_directory{};
+	bool m_current_is_file{false};
+
+	std::vector<directory_listing::entry> m_entries{};
+	std::uint64_t m_generation{0};
+	bool m_listing_complete{false};
+
+	// indexes in m_entries of the entries matching m_filter
+	std::vector<std::size_t> m_directories{};
+	std::vector<std::size_t> m_files{};
+	std::size_t m_filtered_count{0}; //!< amount of entries of m_entries already filtered
+	std::array<char, 128> m_filter{};
 };
 
 }
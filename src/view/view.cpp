@@ -4,7 +4,9 @@
 #include "state_holder.hpp"
 #include "terminal_commands.hpp"
 #include "utils/logging.hpp"
+#include "utils/perf_monitor.hpp"
 #include "utils/resource_manager.hpp"
+#include "utils/startup_timings.hpp"
 #include "utils/system.hpp"
 #include "view/game/game_viewer.hpp"
 
@@ -13,8 +15,15 @@
 
 #include <SFML/Window/Event.hpp>
 #include <imgui-SFML.h>
+#include <imgui.h>
 #include <imterm/terminal.hpp>
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 
 #include <IconFontCppHeaders/IconsFontAwesome5.h>
 #include <spdlog/spdlog.h>
@@ -35,6 +44,26 @@ void setup_terminal(ImTerm::terminal<terminal_commands> &terminal, unsigned int
 	terminal.filter_hint() = "regex filter..."; // TODO traduction
 }
 
+// digest of what ImGui drew in the last frame
+std::size_t ui_digest() noexcept {
+	const ImDrawData *draw_data = ImGui::GetDrawData();
+	if (draw_data == nullptr) {
+		return 0;
+	}
+
+	std::size_t digest = static_cast<std::size_t>(draw_data->CmdListsCount);
+	for (int i = 0; i < draw_data->CmdListsCount; ++i) {
+		const ImDrawList *list = draw_data->CmdLists[i];
+		const std::string_view vertices{reinterpret_cast<const char *>(list->VtxBuffer.Data), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		                                static_cast<std::size_t>(list->VtxBuffer.Size) * sizeof(ImDrawVert)};
+		const std::string_view indices{reinterpret_cast<const char *>(list->IdxBuffer.Data), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+		                               static_cast<std::size_t>(list->IdxBuffer.Size) * sizeof(ImDrawIdx)};
+		digest = digest * 31 + std::hash<std::string_view>{}(vertices);
+		digest = digest * 31 + std::hash<std::string_view>{}(indices);
+	}
+	return digest;
+}
+
 bool mouse_type_event(sf::Event::EventType et) {
 	switch (et) {
 		case sf::Event::MouseWheelMoved:
@@ -71,6 +100,7 @@ void view::view::do_run(state::holder &state) {
 	constexpr unsigned int x_window_size = 1600;
 	constexpr unsigned int y_window_size = 900;
 
+	std::optional<utils::startup::step> window_setup{std::in_place, "view: window setup"};
 	sf::RenderWindow window{sf::VideoMode{x_window_size, y_window_size}, "Ninja clown !"};
 	window.setFramerateLimit(std::numeric_limits<unsigned int>::max());
 	window.clear();
@@ -87,7 +117,12 @@ void view::view::do_run(state::holder &state) {
 	m_fps_limiter.start_now();
 	sf::Clock clock{};
 
-	state::access<::view::view>::adapter(state).load_map("resources/maps/map_test/map_test.map"); // TODO remove at some point
+	window_setup.reset();
+
+	{
+		const utils::startup::step step{"view: first map"};
+		state::access<::view::view>::adapter(state).load_map("resources/maps/map_test/map_test.map"); // TODO remove at some point
+	}
 
 	constexpr std::array<ImWchar, 3> fontawesome_icons_ranges = {ICON_MIN_FA, ICON_MAX_FA, 0};
 	ImFontConfig fontawesome_icons_config{};
@@ -110,9 +145,32 @@ void view::view::do_run(state::holder &state) {
 		ImGui::SFML::UpdateFontTexture();
 	}
 
+	bool first_frame{true};
+
 	while (m_running.test_and_set() && window.isOpen()) {
+		sf::Clock frame_clock{};
+		utils::perf_monitor::instance().set_recording(show_perf_overlay);
+
+		terminal.get_terminal_helper()->forward_messages();
+		bool had_events = manage_events(window, state);
+		if (std::optional<bool> reloaded = utils::resource_manager::publish_reload(); reloaded) {
+			had_events = true;
+			if (*reloaded) {
+				game.reload_sprites();
+				terminal.get_terminal_helper()->load_commands();
+				utils::log::info("resource_manager.reload_published");
+			}
+			else {
+				utils::log::warn("resource_manager.reload_failed");
+			}
+		}
+
+		if (!needs_redraw(had_events, state)) {
+			m_fps_limiter.idle(std::chrono::milliseconds{1000 / idle_lps});
+			continue;
+		}
+
 		ImGui::SFML::Update(window, clock.restart());
-		manage_events(window, state);
 		auto restore_view = window.getView();
 
 		switch (m_show_state) {
@@ -130,12 +188,18 @@ void view::view::do_run(state::holder &state) {
 				utils::log::warn("view.view.bad_state", "state"_a = static_cast<int>(m_show_state));
 		}
 
+		if (show_perf_overlay) {
+			display_perf_overlay();
+		}
+
 		if (m_showing_term) {
 			ImGui::SetNextWindowPos(ImVec2{0, 0}, ImGuiCond_Always);
 			terminal.show();
 		}
 
 		ImGui::SFML::Render();
+		const std::size_t ui = ui_digest();
+		m_ui_changed         = std::exchange(m_ui_digest, ui) != ui;
 
 		{ // Fixxy doo fix, fixes linux display bug somehow
 			sf::RectangleShape rect;
@@ -146,6 +210,12 @@ void view::view::do_run(state::holder &state) {
 
 		window.setView(restore_view);
 		window.display();
+		if (first_frame) {
+			utils::startup::report();
+			first_frame = false;
+		}
+		utils::perf_monitor::instance().push(utils::perf_monitor::metric::frame_time,
+		                                     static_cast<float>(frame_clock.getElapsedTime().asMicroseconds()) / 1000.f);
 		m_fps_limiter.wait();
 		window.clear();
 	}
@@ -153,13 +223,18 @@ void view::view::do_run(state::holder &state) {
 	m_game = nullptr;
 }
 
-void view::view::manage_events(sf::RenderWindow &window, state::holder &state) noexcept {
+bool view::view::manage_events(sf::RenderWindow &window, state::holder &state) noexcept {
+	bool had_events{false};
 	sf::Event event{};
 	while (window.pollEvent(event)) {
+		had_events = true;
 		if (event.type == sf::Event::KeyPressed) {
 			if (event.key.code == sf::Keyboard::F12) {
 				m_showing_term = !m_showing_term;
 			}
+			else if (event.key.code == sf::Keyboard::F2) {
+				show_perf_overlay = !show_perf_overlay;
+			}
 		}
 
 		if (event.type == sf::Event::Closed) {
@@ -184,6 +259,69 @@ void view::view::manage_events(sf::RenderWindow &window, state::holder &state) n
 
 		ImGui::SFML::ProcessEvent(event);
 	}
+	return had_events;
+}
+
+bool view::view::needs_redraw(bool had_events, state::holder &state) noexcept {
+	const std::size_t logged_messages = state::access<view>::terminal(state).get_terminal_helper()->logged_messages();
+	const bool new_logs               = std::exchange(m_logged_messages, logged_messages) != logged_messages;
+	const bool game_changed           = m_show_state == window::game && m_game->needs_redraw();
+
+	// ImGui may need more than one frame to reflect a change (eg: auto-resizing windows): frames are drawn until its output
+	// stops changing
+	return had_events || (new_logs && m_showing_term) || game_changed || m_ui_changed || !idle_rendering || show_perf_overlay;
+}
+
+void view::view::display_perf_overlay() noexcept {
+	using metric = utils::perf_monitor::metric;
+	struct plot {
+		metric m;
+		std::string_view label_key;
+	};
+	constexpr std::array plots{
+	  plot{metric::tick_time, "view.perf_overlay.tick_time"},
+	  plot{metric::bot_think_time, "view.perf_overlay.bot_think_time"},
+	  plot{metric::frame_time, "view.perf_overlay.frame_time"},
+	  plot{metric::collision_tests, "view.perf_overlay.collision_tests"},
+	  plot{metric::events_fired, "view.perf_overlay.events_fired"},
+	  plot{metric::dirty_entities, "view.perf_overlay.dirty_entities"},
+	  plot{metric::dirty_cells, "view.perf_overlay.dirty_cells"},
+	  plot{metric::heap_allocations, "view.perf_overlay.heap_allocations"},
+	};
+
+	const auto resources = utils::resource_manager::instance();
+
+	// the window id must not depend on the language
+	const std::string title = fmt::format("{}##perf overlay", resources->gui_text_for("view.perf_overlay.title"));
+
+	ImGui::SetNextWindowPos(ImVec2{10.f, 10.f}, ImGuiCond_FirstUseEver);
+	if (ImGui::Begin(title.c_str(), nullptr,
+	                 ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing)) { // NOLINT(*-signed-bitwise)
+		std::array<std::string_view, plots.size()> labels;
+		float labels_width{0};
+		for (std::size_t i = 0; i < plots.size(); ++i) {
+			labels[i]    = resources->gui_text_for(plots[i].label_key);
+			labels_width = std::max(ImGui::CalcTextSize(labels[i].data(), labels[i].data() + labels[i].size()).x, labels_width);
+		}
+		labels_width += ImGui::GetStyle().ItemSpacing.x;
+
+		utils::perf_monitor::history_t values{};
+		for (std::size_t i = 0; i < plots.size(); ++i) {
+			const plot &p = plots[i];
+			utils::perf_monitor::instance().history(p.m, values);
+			const float max_value = *std::max_element(values.begin(), values.end());
+			const std::string overlay = fmt::format("{:.2f} (max {:.2f})", values.back(), max_value);
+
+			ImGui::TextUnformatted(labels[i].data(), labels[i].data() + labels[i].size());
+			ImGui::SameLine(labels_width);
+
+			ImGui::PushID(p.label_key.data(), p.label_key.data() + p.label_key.size());
+			ImGui::PlotHistogram("##plot", values.data(), static_cast<int>(values.size()), 0, overlay.c_str(), 0.f,
+			                     std::max(max_value, 1.f), ImVec2{240.f, 40.f});
+			ImGui::PopID();
+		}
+	}
+	ImGui::End();
 }
 
 bool view::view::has_map() const noexcept {
@@ -64,19 +64,40 @@ public:
 
     std::atomic_bool show_debug_data{true};
 
+    std::atomic_bool show_perf_overlay{false};
+
+    /**
+     * When set, frames are only drawn when something changed (input, map, logs, animations, ...). The window is
+     * otherwise polled at idle_lps loops per second.
+     */
+    std::atomic_bool idle_rendering{true};
+
+    static constexpr unsigned int idle_lps = 30;
+
 private:
 	void do_run(state::holder&);
 
 	/**
 	 * Polls through SFML events and manages them. Called while running
+	 * @return true if at least one event was polled
+	 */
+	bool manage_events(sf::RenderWindow& window, state::holder&) noexcept;
+
+	/**
+	 * @return true if the next loop should draw a frame
 	 */
-	void manage_events(sf::RenderWindow& window, state::holder&) noexcept;
+	bool needs_redraw(bool had_events, state::holder&) noexcept;
 
 	/**
 	 * Defers display to menu and treats its requests
 	 */
 	 void display_menu(state::holder&) noexcept;
 
+	/**
+	 * Displays rolling histograms of the model and view performance counters
+	 */
+	void display_perf_overlay() noexcept;
+
 	game_viewer* m_game{nullptr}; // allowing external access (data within *do_run*)
 
 	std::unique_ptr<std::thread> m_thread{};
@@ -86,6 +107,10 @@ private:
 	utils::loop_per_sec_limit m_fps_limiter{};
 	window m_show_state{window::game}; // FIXME : devrait être window::menu
 	bool m_showing_term{false};
+
+	std::size_t m_ui_digest{0}; //! Digest of what ImGui drew in the last frame
+	bool m_ui_changed{true};    //! ImGui's output changed in the last frame, it may still be settling
+	std::size_t m_logged_messages{0};
 };
 } // namespace view
 
@@ -0,0 +1,54 @@
+#include <utils/archive.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include <catch2/catch.hpp>
+
+#include "temporary_file.hpp"
+
+// NOLINTBEGIN
+
+SCENARIO("Archives") {
+	namespace fs = std::filesystem;
+	const test::temporary_file temporary_directory{"ninja_clown_archive_test"};
+	const test::temporary_file temporary_archive{"ninja_clown_archive_test.ncpack"};
+	const fs::path &directory    = temporary_directory.path();
+	const fs::path &archive_file = temporary_archive.path();
+	fs::create_directories(directory / "texture_pack");
+	std::ofstream{directory / "first.map"} << "first";
+	std::ofstream{directory / "second.map"} << "second map";
+	std::ofstream{directory / "texture_pack" / "assets.png"} << "";
+
+	GIVEN("A packed directory") {
+		REQUIRE(utils::archive::pack(directory, archive_file));
+
+		utils::archive archive;
+		REQUIRE(archive.open(archive_file));
+		REQUIRE(archive.entries().size() == 3);
+
+		const utils::archive::entry *second = archive.find("second.map");
+		REQUIRE(second != nullptr);
+		CHECK(second->data == "second map");
+		CHECK(archive.find("texture_pack/assets.png") != nullptr);
+		CHECK(archive.find("texture_pack/assets.png")->data.empty());
+		CHECK(archive.find("third.map") == nullptr);
+		CHECK(archive.find("first.map")->hash != second->hash);
+
+		THEN("Files are reachable through paths going through the archive") {
+			auto found = utils::archive::lookup(archive_file / "first.map");
+			REQUIRE(found);
+			CHECK(found->second->data == "first");
+			CHECK(utils::archive::shared(archive_file) == found->first);
+			CHECK(!utils::archive::lookup(archive_file / "missing.map"));
+			CHECK(!utils::archive::split(directory / "first.map"));
+		}
+	}
+
+	GIVEN("A file that is not an archive") {
+		utils::archive archive;
+		CHECK(!archive.open(directory / "first.map"));
+	}
+}
+
+// NOLINTEND
@@ -0,0 +1,67 @@
+#include <adapter/compiled_map.hpp>
+
+#include <catch2/catch.hpp>
+
+#include "temporary_file.hpp"
+
+// NOLINTBEGIN
+
+namespace {
+adapter::map_data::level sample_level() {
+	using namespace adapter::map_data;
+	level level;
+	level.width  = 3;
+	level.height = 2;
+	level.tiles  = {tile::CHASM, tile::CONCRETE, tile::IRON, tile::TARGET, tile::CONCRETE, tile::CHASM};
+	level.mobs.push_back(mob{{1, 1}, 1.5f, {3, 10, 20, mob_behaviour::DLL, mob_sprite::CLOWN}});
+	level.actors.emplace_back(gate{"door", {2, 0}, true});
+	level.actors.emplace_back(autoshooter{"turret", {0, 1}, 12, 0.5f});
+	level.actors.emplace_back(activator{{1, 0}, 2, 30, true, 5, activator_type::BUTTON, {0, 1}});
+	return level;
+}
+} // namespace
+
+SCENARIO("Compiled maps round trip") {
+	using namespace adapter::map_data;
+	const test::temporary_file file{"ninja_clown_test.ncmap"};
+
+	GIVEN("A written level") {
+		REQUIRE(write_compiled(sample_level(), 42, file.path()));
+
+		std::optional<level> read = read_compiled(file.path());
+		REQUIRE(read);
+		CHECK(read->width == 3);
+		CHECK(read->height == 2);
+		CHECK(read->at(0, 1) == tile::TARGET);
+		CHECK(read->at(2, 0) == tile::IRON);
+
+		REQUIRE(read->mobs.size() == 1);
+		CHECK(read->mobs[0].pos.x == 1);
+		CHECK(read->mobs[0].facing == 1.5f);
+		CHECK(read->mobs[0].type.hp == 3);
+		CHECK(read->mobs[0].type.throw_delay == 20);
+		CHECK(read->mobs[0].type.behaviour == mob_behaviour::DLL);
+
+		REQUIRE(read->actors.size() == 3);
+		CHECK(std::get<gate>(read->actors[0]).name == "door");
+		CHECK(std::get<gate>(read->actors[0]).closed);
+		CHECK(std::get<autoshooter>(read->actors[1]).firing_rate == 12);
+		const activator &button = std::get<activator>(read->actors[2]);
+		CHECK(button.refire_after == 30);
+		CHECK(button.refire_repeat);
+		CHECK(button.target_tiles == std::vector<std::size_t>{0, 1});
+	}
+
+	GIVEN("A truncated file") {
+		REQUIRE(write_compiled(sample_level(), 42, file.path()));
+		file.truncate(3);
+		CHECK(!read_compiled(file.path()));
+	}
+
+	GIVEN("A file that is not a compiled map") {
+		file.write("[file]\nversion = \"1.0.0\"\n");
+		CHECK(!read_compiled(file.path()));
+	}
+}
+
+// NOLINTEND
@@ -0,0 +1,37 @@
+#include <utils/dirty_set.hpp>
+
+#include <catch2/catch.hpp>
+
+// NOLINTBEGIN
+
+SCENARIO("Dirty set deduplication") {
+	utils::dirty_set<int> set;
+
+	GIVEN("Repeated insertions") {
+		CHECK(set.insert(3, 30));
+		CHECK(!set.insert(3, 31));
+		CHECK(set.insert(130, 1300));
+		CHECK(!set.insert(130, 1300));
+
+		CHECK(set.size() == 2);
+		CHECK(set.items() == std::vector<int>{30, 1300});
+		CHECK(set.contains(3));
+		CHECK(set.contains(130));
+		CHECK(!set.contains(4));
+		CHECK(!set.contains(100000));
+	}
+
+	GIVEN("A cleared set") {
+		set.insert(1, 10);
+		set.insert(64, 640);
+		set.clear();
+
+		CHECK(set.empty());
+		CHECK(!set.contains(1));
+		CHECK(!set.contains(64));
+		CHECK(set.insert(64, 641));
+		CHECK(set.items() == std::vector<int>{641});
+	}
+}
+
+// NOLINTEND
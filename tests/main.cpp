@@ -1,2 +1,11 @@
-#define CATCH_CONFIG_MAIN
-#include <catch2/catch.hpp>
\ No newline at end of file
+#define CATCH_CONFIG_RUNNER
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "utils/resource_manager.hpp"
+
+int main(int argc, char *argv[]) {
+	// tests never open a window
+	utils::resource_manager::set_loading_mode(utils::resource_manager::loading_mode::headless);
+	return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,110 @@
+#include <adapter/map_generator.hpp>
+
+#include <algorithm>
+
+#include <catch2/catch.hpp>
+
+// NOLINTBEGIN
+
+SCENARIO("Generated maps") {
+	using namespace adapter::map_data;
+
+	generator_settings settings;
+	settings.width        = 200;
+	settings.height       = 100;
+	settings.seed         = 7;
+	settings.gates        = 20;
+	settings.autoshooters = 5;
+	settings.activators   = 30;
+	settings.refire_after = 12;
+	settings.patrols      = 3;
+	settings.aggressives  = 2;
+
+	GIVEN("Valid settings") {
+		REQUIRE(invalid_setting(settings).empty());
+		std::optional<level> level = generate(settings);
+		REQUIRE(level);
+
+		CHECK(level->width == 200);
+		CHECK(level->height == 100);
+		CHECK(level->tiles.size() == 200 * 100);
+		CHECK(level->mobs.size() == 6);
+		CHECK(level->actors.size() == 55);
+		CHECK(std::count(level->tiles.begin(), level->tiles.end(), tile::TARGET) == 1);
+
+		THEN("The map is surrounded by chasm") {
+			for (std::size_t x = 0; x < level->width; ++x) {
+				CHECK(level->at(x, 0) == tile::CHASM);
+				CHECK(level->at(x, level->height - 1) == tile::CHASM);
+			}
+		}
+
+		THEN("Mobs stand on ground") {
+			for (const mob &mob : level->mobs) {
+				CHECK(level->at(mob.pos.x, mob.pos.y) != tile::CHASM);
+			}
+		}
+
+		THEN("Activators act on gates or autoshooters") {
+			for (const actor &actor : level->actors) {
+				if (const auto *button = std::get_if<activator>(&actor)) {
+					REQUIRE(button->target_tiles.size() == 1);
+					CHECK(button->target_tiles.front() < 25);
+					CHECK(button->refire_after == 12);
+				}
+			}
+		}
+
+		THEN("The map file parses back to the same level") {
+			std::optional<adapter::map_data::level> parsed = parse(to_v1_0_0(*level), "generated");
+			REQUIRE(parsed);
+			CHECK(parsed->tiles == level->tiles);
+			REQUIRE(parsed->mobs.size() == level->mobs.size());
+			for (std::size_t i = 0; i < level->mobs.size(); ++i) {
+				CHECK(parsed->mobs[i].pos.x == level->mobs[i].pos.x);
+				CHECK(parsed->mobs[i].facing == level->mobs[i].facing);
+				CHECK(parsed->mobs[i].type.behaviour == level->mobs[i].type.behaviour);
+			}
+			REQUIRE(parsed->actors.size() == level->actors.size());
+			CHECK(std::get<activator>(parsed->actors.back()).target_tiles == std::get<activator>(level->actors.back()).target_tiles);
+		}
+
+		THEN("The same seed generates the same map") {
+			std::optional<adapter::map_data::level> again = generate(settings);
+			REQUIRE(again);
+			CHECK(again->tiles == level->tiles);
+			CHECK(to_v1_0_0(*again) == to_v1_0_0(*level));
+		}
+
+		THEN("Another seed generates another map") {
+			settings.seed = 8;
+			std::optional<adapter::map_data::level> other = generate(settings);
+			REQUIRE(other);
+			CHECK(other->tiles != level->tiles);
+		}
+	}
+
+	GIVEN("Invalid settings") {
+		settings.width = generator_settings::max_size + 1;
+		CHECK(!invalid_setting(settings).empty());
+		CHECK(!generate(settings));
+
+		settings.width        = 50;
+		settings.gates        = 0;
+		settings.autoshooters = 0;
+		CHECK(!invalid_setting(settings).empty());
+
+		settings.activators = 0;
+		settings.players    = 100;
+		CHECK(!invalid_setting(settings).empty());
+	}
+
+	GIVEN("A map too crowded for its actors") {
+		settings.width  = 4;
+		settings.height = 4;
+		CHECK(invalid_setting(settings).empty());
+		CHECK(!generate(settings));
+	}
+}
+
+// NOLINTEND
@@ -0,0 +1,102 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <model/math.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+// NOLINTBEGIN
+
+SCENARIO("Deterministic math accuracy") {
+	GIVEN("sin and cos over [-4096 ; 4096]") {
+		double max_sin_error = 0.;
+		double max_cos_error = 0.;
+		bool sincos_matches  = true;
+		for (int i = -4096 * 256; i <= 4096 * 256; ++i) {
+			const float x = static_cast<float>(i) / 256.f + 0.001f;
+			max_sin_error = std::max(max_sin_error, std::abs(model::math::sin(x) - std::sin(static_cast<double>(x))));
+			max_cos_error = std::max(max_cos_error, std::abs(model::math::cos(x) - std::cos(static_cast<double>(x))));
+
+			float s{0.f};
+			float c{0.f};
+			model::math::sincos(x, s, c);
+			sincos_matches = sincos_matches && s == model::math::sin(x) && c == model::math::cos(x);
+		}
+		CHECK(sincos_matches);
+		CHECK(max_sin_error < 1.5e-7);
+		CHECK(max_cos_error < 1.5e-7);
+	}
+
+	GIVEN("atan2 and hypot over a grid") {
+		double max_atan2_error = 0.;
+		double max_hypot_error = 0.;
+		for (int i = -300; i <= 300; ++i) {
+			for (int j = -300; j <= 300; ++j) {
+				const float y = static_cast<float>(i) / 37.f;
+				const float x = static_cast<float>(j) / 41.f;
+				max_atan2_error
+				  = std::max(max_atan2_error, std::abs(model::math::atan2(y, x) - std::atan2(static_cast<double>(y), static_cast<double>(x))));
+
+				const double expected = std::hypot(static_cast<double>(x), static_cast<double>(y));
+				if (expected != 0.) {
+					max_hypot_error = std::max(max_hypot_error, std::abs(model::math::hypot(x, y) - expected) / expected);
+				}
+			}
+		}
+		CHECK(max_atan2_error < 4e-7);
+		CHECK(max_hypot_error < 2e-7);
+		CHECK(model::math::atan2(0.f, 0.f) == 0.f);
+	}
+
+	GIVEN("Compile time evaluation") {
+		constexpr float forward = model::math::slowdown_factor(0.f);
+		STATIC_REQUIRE(forward > 0.999f);
+		STATIC_REQUIRE(forward < 1.001f);
+	}
+}
+
+TEST_CASE("Deterministic math throughput", "[.][benchmark]") {
+	std::vector<float> angles(4096);
+	for (std::size_t i = 0; i < angles.size(); ++i) {
+		angles[i] = static_cast<float>(i) * 0.0123f - 25.f;
+	}
+
+	BENCHMARK("std::sin + std::cos") {
+		float acc = 0.f;
+		for (float x : angles) {
+			acc += std::sin(x) + std::cos(x);
+		}
+		return acc;
+	};
+
+	BENCHMARK("model::math::sincos") {
+		float acc = 0.f;
+		for (float x : angles) {
+			float s{0.f};
+			float c{0.f};
+			model::math::sincos(x, s, c);
+			acc += s + c;
+		}
+		return acc;
+	};
+
+	BENCHMARK("std::atan2") {
+		float acc = 0.f;
+		for (std::size_t i = 1; i < angles.size(); ++i) {
+			acc += std::atan2(angles[i], angles[i - 1]);
+		}
+		return acc;
+	};
+
+	BENCHMARK("model::math::atan2") {
+		float acc = 0.f;
+		for (std::size_t i = 1; i < angles.size(); ++i) {
+			acc += model::math::atan2(angles[i], angles[i - 1]);
+		}
+		return acc;
+	};
+}
+
+// NOLINTEND
@@ -0,0 +1,131 @@
+#include <model/collision.hpp>
+#include <model/mob_ai.hpp>
+#include <model/movement.hpp>
+#include <model/world.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <variant>
+
+#include <catch2/catch.hpp>
+
+// NOLINTBEGIN
+
+namespace {
+void add_entity(model::world &world, model::handle_t handle, ninja_api::nnj_entity_kind kind, std::size_t x) {
+	world.components.hitbox[handle]        = model::component::hitbox{static_cast<float>(x) + 0.5f, 0.5f, 0.25f, 0.25f};
+	world.components.metadata[handle].kind = kind;
+}
+// distance from `point` to the closest cell that is not ground
+float clearance(const model::grid &map, model::vec2 point) {
+	float closest = std::numeric_limits<float>::max();
+	for (std::size_t x = 0; x < map.width(); ++x) {
+		for (std::size_t y = 0; y < map.height(); ++y) {
+			if (map[x][y].type != model::cell_type::GROUND) {
+				const float dx = point.x - std::clamp(point.x, static_cast<float>(x), static_cast<float>(x + 1));
+				const float dy = point.y - std::clamp(point.y, static_cast<float>(y), static_cast<float>(y + 1));
+				closest        = std::min(closest, std::hypot(dx, dy));
+			}
+		}
+	}
+	return closest;
+}
+
+// applies the movement decided for `handle`, as world::update would without any collision
+void walk(model::world &world, model::handle_t handle) {
+	const auto &request                            = std::get<ninja_api::nnj_movement_request>(*world.components.decision[handle]);
+	const model::component::properties &properties = world.components.properties[handle];
+	model::component::hitbox &hitbox               = *world.components.hitbox[handle];
+
+	model::movement_batch batch;
+	batch.add(handle, hitbox.rad, std::clamp(request.rotation, -properties.rotation_speed, properties.rotation_speed),
+	          request.forward_diff, request.lateral_diff, properties.move_speed);
+	batch.integrate();
+	hitbox.rad = batch.new_rad[0];
+	hitbox.center.x += batch.dx[0];
+	hitbox.center.y += batch.dy[0];
+}
+} // namespace
+
+SCENARIO("Aggressive mobs distance map") {
+	// a single corridor, longer than the aggro range
+	auto world               = std::make_unique<model::world>();
+	const std::size_t length = model::mob_ai::aggro_range * 2;
+	world->map.resize(length, 1);
+	for (std::size_t x = 0; x < length; ++x) {
+		world->map[x][0].type = model::cell_type::GROUND;
+	}
+	add_entity(*world, 0, ninja_api::nnj_entity_kind::EK_DLL, 0);
+
+	GIVEN("A mob within aggro range") {
+		add_entity(*world, 1, ninja_api::nnj_entity_kind::EK_AGGRESSIVE, 5);
+		world->ai.think(*world);
+
+		THEN("The search stops once the mob is reached") {
+			CHECK(world->ai.distance_at(5, 0) == 5);
+			CHECK(world->ai.distance_at(4, 0) == 4);
+			CHECK(world->ai.distance_at(7, 0) == model::mob_ai::unreachable);
+		}
+
+		THEN("The mob walks toward the player") {
+			REQUIRE(world->components.decision[1]);
+			CHECK(std::holds_alternative<ninja_api::nnj_movement_request>(*world->components.decision[1]));
+		}
+
+		THEN("Moving the player starts the search over") {
+			add_entity(*world, 0, ninja_api::nnj_entity_kind::EK_DLL, 8);
+			world->ai.think(*world);
+			CHECK(world->ai.distance_at(5, 0) == 3);
+			CHECK(world->ai.distance_at(0, 0) == model::mob_ai::unreachable);
+		}
+	}
+
+	GIVEN("A mob out of aggro range") {
+		add_entity(*world, 1, ninja_api::nnj_entity_kind::EK_AGGRESSIVE, length - 1);
+		world->ai.think(*world);
+
+		THEN("It is not reached") {
+			CHECK(world->ai.distance_at(model::mob_ai::aggro_range, 0) == model::mob_ai::aggro_range);
+			CHECK(world->ai.distance_at(model::mob_ai::aggro_range + 1, 0) == model::mob_ai::unreachable);
+			CHECK(!world->components.decision[1]);
+		}
+	}
+}
+
+SCENARIO("Aggressive mobs following a corridor") {
+	// one cell wide, along y = 0 then turning along x = 5
+	auto world = std::make_unique<model::world>();
+	world->map.resize(6, 6);
+	for (std::size_t i = 0; i < 6; ++i) {
+		world->map[i][0].type = model::cell_type::GROUND;
+		world->map[5][i].type = model::cell_type::GROUND;
+	}
+	world->components.hitbox[0]        = model::component::hitbox{5.5f, 5.5f, 0.25f, 0.25f};
+	world->components.metadata[0].kind = ninja_api::nnj_entity_kind::EK_DLL;
+	world->components.hitbox[1]        = model::component::hitbox{0.5f, 0.5f, 0.25f, 0.25f};
+	world->components.metadata[1].kind = ninja_api::nnj_entity_kind::EK_AGGRESSIVE;
+
+	GIVEN("A mob at the other end") {
+		const float radius  = model::bounding_circle{*world->components.hitbox[1]}.radius;
+		float min_clearance = std::numeric_limits<float>::max();
+		bool reached        = false;
+		for (int tick = 0; tick < 200 && !reached; ++tick) {
+			world->ai.think(*world);
+			REQUIRE(world->components.decision[1]);
+			reached = std::holds_alternative<ninja_api::nnj_attack_request>(*world->components.decision[1]);
+			if (!reached) {
+				walk(*world, 1);
+				min_clearance = std::min(min_clearance, clearance(world->map, world->components.hitbox[1]->center));
+			}
+		}
+
+		THEN("It reaches the player, away from the walls") {
+			CHECK(reached);
+			CHECK(min_clearance >= radius);
+		}
+	}
+}
+
+// NOLINTEND
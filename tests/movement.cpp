@@ -0,0 +1,45 @@
+#include <model/movement.hpp>
+#include <utils/universal_constants.hpp>
+
+#include <catch2/catch.hpp>
+
+// NOLINTBEGIN
+
+SCENARIO("Batched movement integration") {
+	GIVEN("A movement batch") {
+		model::movement_batch batch;
+		batch.add(7, 0.f, 0.f, 1.f, 0.f, 0.2f);
+		batch.add(5, uni::math::pi_2<float>, 0.1f, 0.05f, 0.02f, 0.2f);
+		batch.add(2, 3.1f, 0.1f, 0.f, -1.f, 0.2f);
+		batch.add(0, -0.5f, 0.0001f, 0.f, 0.f, 0.2f);
+		batch.integrate();
+
+		THEN("Moving forward is capped to the move speed") {
+			CHECK(batch.dx[0] == Approx(0.2f));
+			CHECK(batch.dy[0] == Approx(0.f).margin(1e-6));
+		}
+
+		THEN("Rotations are applied, wrapped, and ignored when too small") {
+			CHECK(batch.new_rad[1] == Approx(uni::math::pi_2<float> + 0.1f));
+			CHECK(batch.new_rad[2] == Approx(3.2f - 2 * uni::math::pi<float>));
+			CHECK(batch.new_rad[3] == -0.5f);
+		}
+
+		THEN("Results match the single entity integration") {
+			for (std::size_t i = 0; i < batch.size(); ++i) {
+				model::vec2 expected = model::proposed_movement(batch.new_rad[i], batch.forward[i], batch.lateral[i], batch.move_speed[i]);
+				CHECK(batch.dx[i] == expected.x);
+				CHECK(batch.dy[i] == expected.y);
+			}
+		}
+
+		THEN("Slots are found back from handles") {
+			CHECK(batch.slot_of(7) == 0u);
+			CHECK(batch.slot_of(2) == 2u);
+			CHECK(batch.slot_of(0) == 3u);
+			CHECK_FALSE(batch.slot_of(3).has_value());
+		}
+	}
+}
+
+// NOLINTEND
@@ -0,0 +1,129 @@
+#include <model/grid.hpp>
+#include <model/projectiles.hpp>
+#include <utils/universal_constants.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+// NOLINTBEGIN
+
+namespace {
+// corridor along the line y = 1, closed by a wall on its first cell
+model::grid corridor(std::size_t length) {
+	model::grid map;
+	map.resize(length, 3);
+	for (std::size_t x = 1; x < length; ++x) {
+		map[x][1].type = model::cell_type::GROUND;
+	}
+	map[0][1].type = model::cell_type::WALL;
+	return map;
+}
+
+void update(model::projectile_pool &pool, const model::grid &map, unsigned int ticks,
+            const std::vector<model::projectile_target> &targets = {}) {
+	for (unsigned int tick = 0; tick < ticks; ++tick) {
+		pool.update(map, targets);
+	}
+}
+} // namespace
+
+SCENARIO("Projectiles") {
+	auto pool = std::make_unique<model::projectile_pool>();
+
+	GIVEN("A projectile flying toward a wall") {
+		model::grid map = corridor(5);
+		map[4][1].type  = model::cell_type::WALL;
+		REQUIRE(pool->spawn({1.5f, 1.5f}, 0.f));
+
+		THEN("It flies over ground cells") {
+			update(*pool, map, 4);
+			REQUIRE(pool->size() == 1);
+			CHECK(pool->xs()[0] == Approx(3.5f));
+			CHECK(pool->ys()[0] == Approx(1.5f));
+		}
+
+		THEN("It is destroyed by the wall") {
+			update(*pool, map, 6);
+			CHECK(pool->size() == 0);
+			CHECK(pool->hits().empty());
+		}
+	}
+
+	GIVEN("A projectile fired by an entity toward another one") {
+		const model::grid map = corridor(8);
+		const std::vector<model::projectile_target> targets{{1, {1.5f, 1.5f}, 0.3f}, {2, {3.5f, 1.5f}, 0.3f}};
+		REQUIRE(pool->spawn({1.5f, 1.5f}, 0.f, 1));
+
+		THEN("It does not hit its source") {
+			update(*pool, map, 3, targets);
+			CHECK(pool->hits().empty());
+			CHECK(pool->size() == 1);
+		}
+
+		THEN("It hits the other entity") {
+			update(*pool, map, 4, targets);
+			REQUIRE(pool->hits().size() == 1);
+			CHECK(pool->hits()[0].target == 2);
+			CHECK(pool->hits()[0].source == 1);
+			CHECK(pool->size() == 0);
+		}
+	}
+
+	GIVEN("A projectile flying in an open corridor") {
+		const model::grid map = corridor(128);
+		REQUIRE(pool->spawn({1.5f, 1.5f}, 0.f));
+
+		THEN("It expires at the end of its lifetime") {
+			update(*pool, map, model::projectile_pool::lifetime - 1);
+			CHECK(pool->size() == 1);
+			update(*pool, map, 1);
+			CHECK(pool->size() == 0);
+			CHECK(pool->hits().empty());
+		}
+	}
+
+	GIVEN("An autoshooter in a wall, facing a corridor") {
+		const model::grid map = corridor(128);
+		REQUIRE(pool->toggle_shooter(0, {0, 1}, 0.f, 3));
+
+		THEN("It fires from outside of its cell") {
+			update(*pool, map, 1);
+			REQUIRE(pool->size() == 1);
+			CHECK(pool->xs()[0] == Approx(0.5f + 0.75f + model::projectile_pool::speed));
+			CHECK(pool->ys()[0] == Approx(1.5f));
+		}
+
+		THEN("It fires every firing_rate ticks") {
+			update(*pool, map, 3);
+			CHECK(pool->size() == 1);
+			update(*pool, map, 1);
+			CHECK(pool->size() == 2);
+			update(*pool, map, 3);
+			CHECK(pool->size() == 3);
+		}
+
+		THEN("Toggling it again stops it") {
+			CHECK(!pool->toggle_shooter(0, {0, 1}, 0.f, 3));
+			update(*pool, map, 5);
+			CHECK(pool->size() == 0);
+		}
+	}
+
+	GIVEN("Projectiles destroyed during an update") {
+		const model::grid map = corridor(128);
+		REQUIRE(pool->spawn({1.15f, 1.5f}, uni::math::pi<float>));
+		REQUIRE(pool->spawn({2.5f, 1.5f}, 0.f));
+		REQUIRE(pool->spawn({3.5f, 1.5f}, 0.f));
+
+		THEN("The last projectile takes their slot") {
+			update(*pool, map, 1);
+			REQUIRE(pool->size() == 2);
+			CHECK(pool->xs()[0] == Approx(4.f));
+			CHECK(pool->xs()[1] == Approx(3.f));
+		}
+	}
+}
+
+// NOLINTEND
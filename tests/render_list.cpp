@@ -0,0 +1,75 @@
+#include <view/game/render_list.hpp>
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <catch2/catch.hpp>
+
+// NOLINTBEGIN
+
+SCENARIO("Render lists") {
+	const sf::Texture first_texture{};
+	const sf::Texture second_texture{};
+	view::render_list list;
+
+	GIVEN("Sprites sharing a texture") {
+		sf::Sprite sprite{first_texture, sf::IntRect{8, 4, 32, 16}};
+		sprite.setPosition(10.f, 20.f);
+		list.add_sprite(sprite);
+		sprite.setPosition(50.f, 20.f);
+		list.add_sprite(sprite);
+
+		THEN("They are drawn at once") {
+			REQUIRE(list.batches().size() == 1);
+			CHECK(list.batches()[0].texture == &first_texture);
+			CHECK(list.batches()[0].vertex_count == 8);
+			REQUIRE(list.vertices().size() == 8);
+			CHECK(list.vertices()[0].position == sf::Vector2f{10.f, 20.f});
+			CHECK(list.vertices()[2].position == sf::Vector2f{42.f, 36.f});
+			CHECK(list.vertices()[2].texCoords == sf::Vector2f{40.f, 20.f});
+			CHECK(list.vertices()[4].position == sf::Vector2f{50.f, 20.f});
+		}
+
+		THEN("Other textures and rectangles start new batches") {
+			list.add_rect({0.f, 0.f, 4.f, 4.f}, sf::Color{255, 0, 0});
+			list.add_rect({8.f, 0.f, 4.f, 4.f}, sf::Color{255, 0, 0});
+			sprite.setTexture(second_texture);
+			list.add_sprite(sprite);
+
+			REQUIRE(list.batches().size() == 3);
+			CHECK(list.batches()[1].texture == nullptr);
+			CHECK(list.batches()[1].first_vertex == 8);
+			CHECK(list.batches()[1].vertex_count == 8);
+			CHECK(list.batches()[2].texture == &second_texture);
+			CHECK(list.batches()[2].first_vertex == 16);
+			CHECK(list.vertices()[8].color == sf::Color{255, 0, 0});
+		}
+
+		THEN("Baked vertices are referenced, and interrupt batches") {
+			sf::VertexArray empty{sf::Quads};
+			list.add_baked(empty, &first_texture);
+			CHECK(list.batches().size() == 1);
+
+			sf::VertexArray baked{sf::Quads, 4};
+			list.add_baked(baked, &first_texture);
+			list.add_sprite(sprite);
+
+			REQUIRE(list.batches().size() == 3);
+			CHECK(list.batches()[1].baked == &baked);
+			CHECK(list.batches()[1].vertex_count == 4);
+			CHECK(list.batches()[2].baked == nullptr);
+			CHECK(list.vertices().size() == 12);
+		}
+
+		THEN("Clearing empties the list") {
+			list.tooltip().push_back({"x : 1"});
+			list.clear();
+			CHECK(list.batches().empty());
+			CHECK(list.vertices().empty());
+			CHECK(list.tooltip().empty());
+		}
+	}
+}
+
+// NOLINTEND
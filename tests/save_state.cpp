@@ -0,0 +1,210 @@
+#include <adapter/save_state.hpp>
+#include <model/world.hpp>
+#include <utils/binary_stream.hpp>
+#include <utils/mapped_file.hpp>
+
+#include <filesystem>
+#include <sstream>
+
+#include <catch2/catch.hpp>
+
+#include "temporary_file.hpp"
+
+// NOLINTBEGIN
+
+namespace {
+void populate(model::world &world) {
+	world.map.resize(4, 3);
+	world.map[1][1].type = model::cell_type::GROUND;
+	world.map[2][1].type = model::cell_type::GROUND;
+	world.map[2][1].interaction_handle.emplace(0);
+	world.map[3][2].type = model::cell_type::WALL;
+	world.target_tile    = {1, 1};
+
+	world.components.health[3]   = {2};
+	world.components.hitbox[3]   = model::component::hitbox{1.5f, 1.5f, 0.25f, 0.25f};
+	world.components.hitbox[3]->rad = 0.5f;
+	world.components.decision[3] = ninja_api::nnj_movement_request{0.1f, 0.2f, 0.f};
+	world.components.metadata[3].kind = ninja_api::nnj_entity_kind::EK_DLL;
+	world.components.properties[3].move_speed = 0.4f;
+	world.components.state[3].preparing_action.emplace(ninja_api::nnj_attack_request{5});
+	world.components.state[3].ticks_before_ready = 2;
+
+	world.interactions.push_back({model::interaction_kind::LIGHT_MANUAL, model::interactable_kind::BUTTON, 0});
+	model::activator activator;
+	activator.targets      = {0};
+	activator.refire_after = 30;
+	activator.enabled      = true;
+	world.activators.push_back(activator);
+	world.actionables.push_back({model::actionable::instance_data{{3, 2}, 0, 0, 0.f}, model::actionable::behaviours_ns::gate});
+
+	world.projectiles.spawn({1.5f, 1.5f}, 0.f, 3);
+}
+
+std::string saved(const model::world &world) {
+	std::ostringstream stream;
+	{
+		utils::binary_writer out{stream};
+		world.save(out);
+	}
+	return stream.str();
+}
+} // namespace
+
+SCENARIO("Save states round trip") {
+	const test::temporary_file file{"ninja_clown_test.ncsave"};
+	const adapter::save_state::map_info map{"maps/test.map", 0x1234abcdull};
+	auto world = std::make_unique<model::world>();
+	populate(*world);
+
+	GIVEN("A saved world") {
+		REQUIRE(adapter::save_state::write(file.path(), map, *world, {{2, 1}}, {3}));
+
+		utils::mapped_file content;
+		REQUIRE(content.open(file.path()));
+		std::optional<adapter::save_state::map_info> saved_map = adapter::save_state::map_of(content.view());
+		REQUIRE(saved_map);
+		CHECK(saved_map->path == std::filesystem::path{"maps/test.map"});
+		CHECK(saved_map->hash == 0x1234abcdull);
+		CHECK(saved_map->width == 4);
+		CHECK(saved_map->height == 3);
+
+		auto loaded = std::make_unique<model::world>();
+		std::optional<adapter::save_state::changes> changes = adapter::save_state::read(content.view(), *loaded);
+		REQUIRE(changes);
+		REQUIRE(changes->cells.size() == 1);
+		CHECK(changes->cells[0] == model::grid_point{2, 1});
+		CHECK(changes->entities == std::vector<std::size_t>{3});
+
+		CHECK(loaded->map.width() == 4);
+		CHECK(loaded->map[3][2].type == model::cell_type::WALL);
+		CHECK(*loaded->map[2][1].interaction_handle == 0);
+		CHECK(!loaded->map[1][1].interaction_handle);
+		CHECK(loaded->components.hitbox[3]->rad == 0.5f);
+		CHECK(!loaded->components.hitbox[2]);
+		CHECK(std::get<ninja_api::nnj_attack_request>(*loaded->components.state[3].preparing_action).target_handle == 5);
+		CHECK(loaded->activators[0].refire_after == 30u);
+		CHECK(loaded->activators[0].enabled);
+		CHECK(loaded->actionables[0].behaviour == model::actionable::behaviours_ns::gate);
+		CHECK(loaded->projectiles.size() == 1);
+
+		THEN("Saving it again gives the same bytes") {
+			CHECK(saved(*loaded) == saved(*world));
+		}
+	}
+
+	GIVEN("A saved world with projectiles in flight") {
+		world->projectiles.spawn({1.5f, 1.5f}, 0.f);
+		REQUIRE(adapter::save_state::write(file.path(), map, *world, {}, {}));
+
+		utils::mapped_file content;
+		REQUIRE(content.open(file.path()));
+		auto loaded = std::make_unique<model::world>();
+		REQUIRE(adapter::save_state::read(content.view(), *loaded));
+		REQUIRE(loaded->projectiles.size() == 2);
+
+		THEN("They keep flying") {
+			// projectile step of world::update, that can not run without a view
+			loaded->projectiles.update(loaded->map, {});
+			CHECK(loaded->projectiles.hits().empty());
+			REQUIRE(loaded->projectiles.size() == 2);
+			CHECK(loaded->projectiles.xs()[0] == Approx(1.5f + model::projectile_pool::speed));
+			CHECK(loaded->projectiles.ys()[0] == Approx(1.5f));
+
+			// until they reach the wall closing the corridor
+			for (int tick = 0; tick < 3; ++tick) {
+				loaded->projectiles.update(loaded->map, {});
+			}
+			CHECK(loaded->projectiles.size() == 0);
+		}
+	}
+
+	GIVEN("A save state whose header does not match the saved map") {
+		REQUIRE(adapter::save_state::write(file.path(), map, *world, {}, {}));
+		std::string bytes;
+		{
+			utils::mapped_file content;
+			REQUIRE(content.open(file.path()));
+			bytes = std::string{content.view()};
+		}
+
+		// magic, version, endianness marker, map path and map hash precede the map width
+		const std::size_t width_offset = 8 + 4 + 4 + 4 + map.path.generic_string().size() + 8;
+		REQUIRE(bytes[width_offset] == 4);
+		bytes[width_offset] = 5;
+
+		auto loaded = std::make_unique<model::world>();
+		CHECK(adapter::save_state::map_of(bytes)->width == 5);
+		CHECK(!adapter::save_state::read(bytes, *loaded));
+	}
+
+	GIVEN("Projectiles fired by missing autoshooters") {
+		world->projectiles.toggle_shooter(1, {3, 2}, 0.f, 10);
+		REQUIRE(adapter::save_state::write(file.path(), map, *world, {}, {}));
+
+		utils::mapped_file content;
+		REQUIRE(content.open(file.path()));
+		auto loaded = std::make_unique<model::world>();
+		CHECK(!adapter::save_state::read(content.view(), *loaded));
+	}
+
+	GIVEN("Projectiles fired by missing entities") {
+		world->projectiles.spawn({2.5f, 1.5f}, 0.f, model::cst::max_entities);
+		REQUIRE(adapter::save_state::write(file.path(), map, *world, {}, {}));
+
+		utils::mapped_file content;
+		REQUIRE(content.open(file.path()));
+		auto loaded = std::make_unique<model::world>();
+		CHECK(!adapter::save_state::read(content.view(), *loaded));
+	}
+
+	GIVEN("A truncated save state") {
+		REQUIRE(adapter::save_state::write(file.path(), map, *world, {}, {}));
+		file.truncate(3);
+
+		utils::mapped_file content;
+		REQUIRE(content.open(file.path()));
+		auto loaded = std::make_unique<model::world>();
+		CHECK(!adapter::save_state::read(content.view(), *loaded));
+	}
+
+	GIVEN("A file that is not a save state") {
+		CHECK(!adapter::save_state::map_of("[file]\nversion = \"1.0.0\"\n"));
+	}
+}
+
+SCENARIO("Event queues round trip") {
+	model::event_queue queue;
+	queue.add_event(0, 5, model::event_reason::DELAY);
+	queue.add_event(1, 2, model::event_reason::REFIRE);
+
+	std::ostringstream stream;
+	{
+		utils::binary_writer out{stream};
+		queue.save(out);
+	}
+	const std::string bytes = stream.str();
+
+	GIVEN("Enough activators") {
+		model::event_queue loaded;
+		utils::binary_reader in{bytes};
+		REQUIRE(loaded.load(in, 2));
+		CHECK(in.at_end());
+
+		REQUIRE(loaded.events().size() == 2);
+		CHECK(loaded.events()[0].handle == 0);
+		CHECK(loaded.events()[0].instant == 5);
+		CHECK(loaded.events()[0].reason == model::event_reason::DELAY);
+		CHECK(loaded.events()[1].handle == 1);
+		CHECK(loaded.events()[1].instant == 2);
+		CHECK(loaded.events()[1].reason == model::event_reason::REFIRE);
+	}
+
+	GIVEN("Events of unknown activators") {
+		model::event_queue loaded;
+		utils::binary_reader in{bytes};
+		CHECK(!loaded.load(in, 1));
+	}
+}
+
+// NOLINTEND
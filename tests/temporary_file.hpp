@@ -0,0 +1,54 @@
+#ifndef NINJACLOWN_TESTS_TEMPORARY_FILE_HPP
+#define NINJACLOWN_TESTS_TEMPORARY_FILE_HPP
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+namespace test {
+
+/**
+ * Path in the temporary directory, removed (with its content if it is a directory) when going out of scope
+ */
+class temporary_file {
+public:
+	explicit temporary_file(std::string_view name)
+	    : m_path{std::filesystem::temp_directory_path() / name} {
+		std::filesystem::remove_all(m_path);
+	}
+
+	~temporary_file() {
+		std::error_code ec;
+		std::filesystem::remove_all(m_path, ec);
+	}
+
+	temporary_file(const temporary_file &) = delete;
+	temporary_file &operator=(const temporary_file &) = delete;
+
+	[[nodiscard]] const std::filesystem::path &path() const noexcept {
+		return m_path;
+	}
+
+	/**
+	 * Replaces the content of the file
+	 */
+	void write(std::string_view content) const {
+		std::ofstream stream{m_path, std::ios::binary | std::ios::trunc};
+		stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	/**
+	 * Cuts the last `bytes` bytes of the file, as a write interrupted midway would
+	 */
+	void truncate(std::uintmax_t bytes) const {
+		std::filesystem::resize_file(m_path, std::filesystem::file_size(m_path) - bytes);
+	}
+
+private:
+	std::filesystem::path m_path;
+};
+
+} // namespace test
+
+#endif //NINJACLOWN_TESTS_TEMPORARY_FILE_HPP
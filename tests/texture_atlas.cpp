@@ -0,0 +1,62 @@
+#include <view/assets/texture_atlas.hpp>
+
+#include <catch2/catch.hpp>
+
+// NOLINTBEGIN
+
+namespace {
+bool overlap(const view::texture_atlas::placement &lhs, sf::Vector2u lhs_size, const view::texture_atlas::placement &rhs,
+             sf::Vector2u rhs_size) {
+	return lhs.page == rhs.page && lhs.x < rhs.x + rhs_size.x && rhs.x < lhs.x + lhs_size.x && lhs.y < rhs.y + rhs_size.y
+	       && rhs.y < lhs.y + lhs_size.y;
+}
+} // namespace
+
+SCENARIO("Texture atlas packing") {
+	std::vector<sf::Vector2u> page_sizes;
+
+	GIVEN("Images fitting in a single page") {
+		const std::vector<sf::Vector2u> sizes{{64, 32}, {16, 16}, {100, 48}, {30, 10}, {64, 32}};
+		auto placements = view::texture_atlas::pack(sizes, 256, page_sizes);
+
+		REQUIRE(placements.size() == sizes.size());
+		REQUIRE(page_sizes.size() == 1);
+		for (std::size_t i = 0; i < sizes.size(); ++i) {
+			CHECK(placements[i].page == 0);
+			CHECK(placements[i].x >= view::texture_atlas::padding);
+			CHECK(placements[i].y >= view::texture_atlas::padding);
+			CHECK(placements[i].x + sizes[i].x + view::texture_atlas::padding <= page_sizes[0].x);
+			CHECK(placements[i].y + sizes[i].y + view::texture_atlas::padding <= page_sizes[0].y);
+			for (std::size_t j = 0; j < i; ++j) {
+				CHECK(!overlap(placements[i], sizes[i], placements[j], sizes[j]));
+			}
+		}
+	}
+
+	GIVEN("More images than a page can hold") {
+		const std::vector<sf::Vector2u> sizes(10, sf::Vector2u{60, 60});
+		auto placements = view::texture_atlas::pack(sizes, 128, page_sizes);
+
+		// 2x2 images of 62x62 (with padding) per page
+		CHECK(page_sizes.size() == 3);
+		for (std::size_t i = 0; i < sizes.size(); ++i) {
+			CHECK(page_sizes[placements[i].page].x <= 128);
+			CHECK(page_sizes[placements[i].page].y <= 128);
+			for (std::size_t j = 0; j < i; ++j) {
+				CHECK(!overlap(placements[i], sizes[i], placements[j], sizes[j]));
+			}
+		}
+	}
+
+	GIVEN("An image larger than a page") {
+		const std::vector<sf::Vector2u> sizes{{10, 10}, {300, 20}, {10, 10}};
+		auto placements = view::texture_atlas::pack(sizes, 256, page_sizes);
+
+		REQUIRE(page_sizes.size() == 2);
+		CHECK(placements[0].page == placements[2].page);
+		CHECK(placements[1].page != placements[0].page);
+		CHECK(page_sizes[placements[1].page].x == 300 + 2 * view::texture_atlas::padding);
+	}
+}
+
+// NOLINTEND
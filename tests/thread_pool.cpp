@@ -0,0 +1,39 @@
+#include <utils/thread_pool.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN
+
+SCENARIO("Parallel for over a thread pool") {
+	for (std::size_t workers : {0u, 1u, 3u}) {
+		utils::thread_pool pool{workers};
+
+		GIVEN("A pool with " + std::to_string(workers) + " workers") {
+			std::vector<int> visits(1000, 0);
+			std::atomic_size_t largest_range{0};
+			pool.parallel_for(visits.size(), 64, [&](std::size_t begin, std::size_t end) {
+				std::size_t largest = largest_range.load();
+				while (end - begin > largest && !largest_range.compare_exchange_weak(largest, end - begin)) { }
+				for (std::size_t i = begin; i < end; ++i) {
+					++visits[i];
+				}
+			});
+
+			CHECK(largest_range == 64);
+			CHECK(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }));
+		}
+
+		GIVEN("An empty range") {
+			bool called = false;
+			pool.parallel_for(0, 64, [&called](std::size_t, std::size_t) { called = true; });
+			CHECK(!called);
+		}
+	}
+}
+
+// NOLINTEND